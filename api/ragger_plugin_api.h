@@ -4,13 +4,20 @@
 #include <cstdint>
 #include <cstddef>
 
-// ABI Version for compatibility checking
-#define RAGGER_PLUGIN_ABI_VERSION 100
+// ABI Version for compatibility checking. 101 added the optional batch
+// parse entry points; 102 appended the index query entry points to
+// RaggerCoreAPI; 103 appended the shared payload buffer entry points.
+// Plugins built against any version back to
+// RAGGER_PLUGIN_ABI_VERSION_MIN still load, and the core probes for the
+// newer entry points instead of assuming them.
+#define RAGGER_PLUGIN_ABI_VERSION 103
+#define RAGGER_PLUGIN_ABI_VERSION_MIN 100
 
 // Forward declarations for ABI stability
 typedef void* RaggerCoreHandle;
 typedef void* PluginHandle;
 typedef void* EventHandle;
+typedef void* RaggerBufferHandle; // Refcounted shared payload buffer
 
 // Core data structures
 struct CodeBlock {
@@ -106,6 +113,14 @@ enum PluginType {
     PLUGIN_TYPE_UI_COMPONENT = 7
 };
 
+// One file's results inside a batch parse; blocks are owned by the batch
+// and released together through free_batch
+struct ParseBatchResult {
+    CodeBlock* blocks;
+    size_t numBlocks;
+    int status; // RAGGER_SUCCESS or a per-file error code
+};
+
 // Parser Plugin Interface
 struct ParserPluginAPI {
     // Capabilities
@@ -119,6 +134,12 @@ struct ParserPluginAPI {
     // Symbol extraction
     int (*extract_symbols)(const char* filePath, CodeSymbol** symbols, size_t* numSymbols);
     void (*free_symbols)(CodeSymbol* symbols, size_t numSymbols);
+
+    // Batch parsing (ABI 101): one cross-DSO call and one free for many
+    // files, letting parsers amortize setup (grammar load, preambles)
+    // across the batch. Null on plugins built before ABI 101.
+    int (*parse_files)(const char** filePaths, size_t numFiles, ParseBatchResult** results);
+    void (*free_batch)(ParseBatchResult* results, size_t numFiles);
 };
 
 // Ranker Plugin Interface
@@ -209,6 +230,28 @@ struct RaggerCoreAPI {
     int (*read_file)(const char* path, char** content, size_t* size);
     int (*write_file)(const char* path, const char* content, size_t size);
     int (*get_file_hash)(const char* path, char* hash, size_t hashSize);
+
+    // Index queries (appended in ABI 102). Blocks tagged as tests at
+    // index time are returned with an O(matches) lookup; filePath may be
+    // NULL to query the whole index. The returned array and its strings
+    // are owned by the caller and released through free_code_blocks.
+    // A core may leave these null (e.g. no index manager wired up);
+    // plugins must null-check before calling.
+    int (*find_test_blocks)(const char* filePath, CodeBlock** blocks, size_t* numBlocks);
+    void (*free_code_blocks)(CodeBlock* blocks, size_t numBlocks);
+
+    // Shared payload buffers (appended in ABI 103). buffer_alloc returns
+    // a refcounted immutable buffer plus its writable storage; fill it,
+    // then hand it to emit_event_shared, which pins the buffer until the
+    // last subscriber has run — no copy per event and no size cap, unlike
+    // emit_event's copied payloads. EventData::data may be NULL (delivers
+    // the whole buffer) or point to a window inside it. The producer's
+    // reference is returned with buffer_release after emitting; the
+    // buffer is freed when the last reference drops. A core may leave
+    // these null; plugins must null-check before calling.
+    RaggerBufferHandle (*buffer_alloc)(size_t size, void** data);
+    void (*buffer_release)(RaggerBufferHandle buffer);
+    int (*emit_event_shared)(const EventData* event, RaggerBufferHandle buffer, int priority);
 };
 
 // Error codes
@@ -0,0 +1,236 @@
+#ifndef RAGGER_PLUGIN_API_HPP
+#define RAGGER_PLUGIN_API_HPP
+
+// Optional C++17 layer over the C plugin ABI. The C structs in
+// ragger_plugin_api.h stay the interchange format — third-party plugins
+// keep targeting them — but building a result graph by hand means a
+// strcpy per string and a matching delete[] cascade on free. The
+// wrappers here own their strings and arrays in a bump arena and are
+// move-only, so a result set built once moves through the pipeline
+// without further copies and is released in one arena drop.
+//
+// Header-only on purpose: plugins can use it without linking anything
+// beyond the standard library.
+
+#include "ragger_plugin_api.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Ragger {
+namespace Api {
+
+// Bump allocator backing one wrapper's object graph. Mirrors the core's
+// per-request arena but is self-contained (no core linkage) and movable,
+// because moving the owning wrapper must carry its storage along.
+// Allocations are never freed individually; destroying the arena
+// releases everything at once. Not thread-safe.
+class Arena {
+public:
+    Arena() = default;
+    Arena(Arena&&) = default;
+    Arena& operator=(Arena&&) = default;
+
+    // Aligned for any object type; throws std::bad_alloc on exhaustion
+    // like the rest of the allocation paths
+    void* allocate(size_t size) {
+        size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        Chunk& chunk = chunkWithRoom(size);
+        void* result = chunk.data.get() + chunk.used;
+        chunk.used += size;
+        return result;
+    }
+
+    // Arena-backed copy of a NUL-terminated string (nullptr passes through)
+    char* duplicateString(const char* source) {
+        if (!source) {
+            return nullptr;
+        }
+        size_t length = std::strlen(source) + 1;
+        char* copy = static_cast<char*>(allocate(length));
+        std::memcpy(copy, source, length);
+        return copy;
+    }
+
+    template <typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "arena memory is reclaimed without running destructors");
+        T* array = static_cast<T*>(allocate(sizeof(T) * count));
+        for (size_t i = 0; i < count; i++) {
+            new (&array[i]) T();
+        }
+        return array;
+    }
+
+private:
+    static const size_t CHUNK_SIZE = 64 * 1024;
+    static const size_t ALIGNMENT = alignof(std::max_align_t);
+
+    struct Chunk {
+        std::unique_ptr<char[]> data;
+        size_t capacity;
+        size_t used;
+    };
+
+    std::vector<Chunk> chunks_;
+
+    Chunk& chunkWithRoom(size_t size) {
+        if (!chunks_.empty() &&
+            chunks_.back().used + size <= chunks_.back().capacity) {
+            return chunks_.back();
+        }
+        size_t capacity = size > CHUNK_SIZE ? size : CHUNK_SIZE;
+        chunks_.push_back({std::unique_ptr<char[]>(new char[capacity]), capacity, 0});
+        return chunks_.back();
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+};
+
+// Move-only owner of a set of CodeBlocks. Blocks and their strings live
+// in the arena, so block addresses stay stable as the set grows and the
+// whole set moves for free.
+class BlockSet {
+public:
+    BlockSet() = default;
+    BlockSet(BlockSet&&) = default;
+    BlockSet& operator=(BlockSet&&) = default;
+
+    CodeBlock& add(const char* name, const char* content, const char* filePath,
+                   int startLine, int endLine, const char* language,
+                   uint32_t visibility = 2) {
+        CodeBlock* block = arena_.allocateArray<CodeBlock>(1);
+        block->name = arena_.duplicateString(name);
+        block->content = arena_.duplicateString(content);
+        block->filePath = arena_.duplicateString(filePath);
+        block->startLine = startLine;
+        block->endLine = endLine;
+        block->language = arena_.duplicateString(language);
+        block->visibility = visibility;
+        block->metadata = nullptr;
+        blocks_.push_back(block);
+        return *block;
+    }
+
+    // One-time copy of a borrowed view into owned storage
+    CodeBlock& adopt(const CodeBlock& view) {
+        CodeBlock& block = add(view.name, view.content, view.filePath,
+                               view.startLine, view.endLine, view.language,
+                               view.visibility);
+        block.metadata = view.metadata;
+        return block;
+    }
+
+    size_t size() const { return blocks_.size(); }
+    bool empty() const { return blocks_.empty(); }
+    CodeBlock& operator[](size_t i) { return *blocks_[i]; }
+    const CodeBlock& operator[](size_t i) const { return *blocks_[i]; }
+
+    Arena& arena() { return arena_; }
+
+private:
+    Arena arena_;
+    std::vector<CodeBlock*> blocks_;
+
+    BlockSet(const BlockSet&) = delete;
+    BlockSet& operator=(const BlockSet&) = delete;
+};
+
+// Move-only owner of a ranked result array plus the blocks it scores.
+// rankingType is interned — one arena copy per distinct type, not one
+// strcpy per result. data()/size() expose the C view for the ABI; it
+// stays valid as long as this object (or whatever it was moved into)
+// lives.
+class RankingResults {
+public:
+    RankingResults() = default;
+    RankingResults(RankingResults&&) = default;
+    RankingResults& operator=(RankingResults&&) = default;
+
+    BlockSet& blocks() { return blocks_; }
+
+    RankingResult& add(CodeBlock* block, float score, const char* rankingType) {
+        RankingResult result;
+        result.block = block;
+        result.score = score;
+        result.rankingType = internType(rankingType);
+        results_.push_back(result);
+        return results_.back();
+    }
+
+    RankingResult* data() { return results_.empty() ? nullptr : results_.data(); }
+    const RankingResult* data() const { return results_.empty() ? nullptr : results_.data(); }
+    size_t size() const { return results_.size(); }
+    bool empty() const { return results_.empty(); }
+
+private:
+    BlockSet blocks_;
+    std::vector<RankingResult> results_;
+    std::unordered_map<std::string, const char*> internedTypes_;
+
+    const char* internType(const char* rankingType) {
+        if (!rankingType) {
+            return nullptr;
+        }
+        auto it = internedTypes_.find(rankingType);
+        if (it != internedTypes_.end()) {
+            return it->second;
+        }
+        const char* copy = blocks_.arena().duplicateString(rankingType);
+        internedTypes_.emplace(rankingType, copy);
+        return copy;
+    }
+
+    RankingResults(const RankingResults&) = delete;
+    RankingResults& operator=(const RankingResults&) = delete;
+};
+
+// Move-only owner of a ContextResponse: the results it points at, their
+// blocks and the prompt template all travel with it. view() exposes the
+// C struct for the ABI.
+class Response {
+public:
+    Response() = default;
+    Response(Response&&) = default;
+    Response& operator=(Response&&) = default;
+
+    void adoptResults(RankingResults&& results) {
+        results_ = std::move(results);
+        response_.results = results_.data();
+        response_.numResults = results_.size();
+    }
+
+    void setPromptTemplate(const char* promptTemplate) {
+        response_.promptTemplate = arena_.duplicateString(promptTemplate);
+    }
+
+    void setTotalTokens(uint32_t totalTokens) {
+        response_.totalTokens = totalTokens;
+    }
+
+    RankingResults& results() { return results_; }
+    const ContextResponse* view() const { return &response_; }
+
+private:
+    Arena arena_;
+    RankingResults results_;
+    ContextResponse response_{};
+
+    Response(const Response&) = delete;
+    Response& operator=(const Response&) = delete;
+};
+
+} // namespace Api
+} // namespace Ragger
+
+#endif // RAGGER_PLUGIN_API_HPP
@@ -0,0 +1,123 @@
+#include "ContextEngine.h"
+#include "PluginManager.h"
+#include "TokenCounter.h"
+#include "Tokenizer.h"
+#include "ragger_plugin_api.h"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace Ragger {
+
+namespace {
+
+std::string makeCodeBlockContent(size_t lines) {
+    std::string content;
+    for (size_t i = 0; i < lines; ++i) {
+        content += "    auto resultValue" + std::to_string(i) +
+                   " = transformInput(parameterBlock, " + std::to_string(i) + ");\n";
+    }
+    return content;
+}
+
+} // anonymous namespace
+
+// End-to-end query latency through the engine (no rankers loaded: this
+// isolates fan-out, fusion, budgeting and response construction costs)
+static void BM_GenerateContext(benchmark::State& state) {
+    ContextEngine engine(nullptr);
+
+    std::string content = makeCodeBlockContent(64);
+    CodeBlock primary;
+    primary.name = "transformInput";
+    primary.content = content.c_str();
+    primary.filePath = "src/example.cpp";
+    primary.startLine = 1;
+    primary.endLine = 64;
+    primary.language = "cpp";
+    primary.visibility = 2;
+    primary.metadata = nullptr;
+
+    ContextRequest request;
+    request.primaryBlock = &primary;
+    request.userQuery = "refactor the transform pipeline";
+    request.maxTokens = 4096;
+    request.rankingWeights = nullptr;
+    request.numWeights = 0;
+
+    for (auto _ : state) {
+        ContextResponse* response = nullptr;
+        benchmark::DoNotOptimize(engine.generateContext(&request, &response));
+        engine.freeResponse(response);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GenerateContext)->Unit(benchmark::kMicrosecond);
+
+// Same path with whatever ranker plugins are present in the build tree;
+// skipped silently when none are found so the suite runs everywhere
+static void BM_GenerateContextWithRankers(benchmark::State& state) {
+    PluginManager pluginManager(nullptr);
+    pluginManager.loadPluginsFromDirectory("lib/ragger/plugins");
+
+    ContextEngine engine(nullptr);
+    engine.setPluginManager(&pluginManager);
+
+    std::string content = makeCodeBlockContent(64);
+    CodeBlock primary;
+    primary.name = "transformInput";
+    primary.content = content.c_str();
+    primary.filePath = "src/example.cpp";
+    primary.startLine = 1;
+    primary.endLine = 64;
+    primary.language = "cpp";
+    primary.visibility = 2;
+    primary.metadata = nullptr;
+
+    ContextRequest request;
+    request.primaryBlock = &primary;
+    request.userQuery = "refactor the transform pipeline";
+    request.maxTokens = 4096;
+    request.rankingWeights = nullptr;
+    request.numWeights = 0;
+
+    for (auto _ : state) {
+        ContextResponse* response = nullptr;
+        benchmark::DoNotOptimize(engine.generateContext(&request, &response));
+        engine.freeResponse(response);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GenerateContextWithRankers)->Unit(benchmark::kMicrosecond);
+
+// Token counting dominates budget enforcement on large blocks
+static void BM_TokenCount(benchmark::State& state) {
+    TokenCounter counter;
+    std::string content = makeCodeBlockContent(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        counter.clearCache(); // Measure counting, not the memo lookup
+        benchmark::DoNotOptimize(counter.countTokens(content));
+    }
+
+    state.SetBytesProcessed(state.iterations() * content.size());
+}
+BENCHMARK(BM_TokenCount)->Arg(64)->Arg(1024);
+
+// Index-side tokenizer throughput on the same content
+static void BM_Tokenize(benchmark::State& state) {
+    std::string content = makeCodeBlockContent(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Tokenizer::countTokens(content));
+    }
+
+    state.SetBytesProcessed(state.iterations() * content.size());
+}
+BENCHMARK(BM_Tokenize)->Arg(64)->Arg(1024);
+
+} // namespace Ragger
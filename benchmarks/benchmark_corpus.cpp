@@ -0,0 +1,116 @@
+#include "CorpusGenerator.h"
+#include "IndexManager.h"
+#include "ragger_plugin_api.h"
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace Ragger {
+
+namespace {
+
+// Generated once per (size, shape) and reused; CorpusGenerator is
+// deterministic so a leftover corpus from a previous run is identical
+fs::path syntheticCorpus(size_t numFiles) {
+    fs::path root = fs::temp_directory_path() /
+                    ("ragger-synth-corpus-" + std::to_string(numFiles));
+    if (!fs::exists(root / CorpusGenerator::pathForFile(numFiles - 1))) {
+        CorpusShape shape;
+        shape.numFiles = numFiles;
+        CorpusGenerator generator(shape);
+        generator.generate(root);
+    }
+    return root;
+}
+
+fs::path scratchDatabase(const char* tag) {
+    static int counter = 0;
+    return fs::temp_directory_path() /
+           ("ragger-synth-" + std::string(tag) + "-" + std::to_string(counter++) + ".db");
+}
+
+void removeDatabase(const fs::path& dbPath) {
+    std::error_code ec;
+    fs::remove(dbPath, ec);
+    fs::remove(fs::path(dbPath.string() + "-wal"), ec);
+    fs::remove(fs::path(dbPath.string() + "-shm"), ec);
+    fs::remove(fs::path(dbPath.string() + ".snapshot"), ec);
+}
+
+} // anonymous namespace
+
+// Cold index over a synthetic corpus at scale
+static void BM_SyntheticColdIndex(benchmark::State& state) {
+    fs::path corpus = syntheticCorpus(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        fs::path dbPath = scratchDatabase("cold");
+        IndexManager indexManager;
+        indexManager.setDatabasePath(dbPath);
+        indexManager.initialize();
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(indexManager.indexDirectory(corpus));
+
+        state.PauseTiming();
+        indexManager.shutdown();
+        removeDatabase(dbPath);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Query flow against an already-built index at scale
+static void BM_SyntheticQuery(benchmark::State& state) {
+    fs::path corpus = syntheticCorpus(static_cast<size_t>(state.range(0)));
+    fs::path dbPath = scratchDatabase("query");
+
+    IndexManager indexManager;
+    indexManager.setDatabasePath(dbPath);
+    indexManager.initialize();
+    indexManager.indexDirectory(corpus);
+
+    for (auto _ : state) {
+        std::vector<fs::path> results;
+        benchmark::DoNotOptimize(
+            indexManager.findFilesByContent("accumulated process context", results));
+        benchmark::DoNotOptimize(results.size());
+    }
+
+    indexManager.shutdown();
+    removeDatabase(dbPath);
+    state.SetItemsProcessed(state.iterations());
+}
+
+// The default suite stays at 1k/10k so routine runs finish in minutes.
+// Export RAGGER_BENCH_LARGE=1 to also register the 100k/1M scales the
+// scaling work actually targets — those need tens of GB of tmp space
+// and are meant for dedicated perf machines, not every CI run.
+namespace {
+
+int registerCorpusBenchmarks() {
+    auto* coldIndex = benchmark::RegisterBenchmark("BM_SyntheticColdIndex",
+                                                   BM_SyntheticColdIndex);
+    auto* query = benchmark::RegisterBenchmark("BM_SyntheticQuery",
+                                               BM_SyntheticQuery);
+    coldIndex->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond)->Iterations(1);
+    query->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+    if (std::getenv("RAGGER_BENCH_LARGE") != nullptr) {
+        coldIndex->Arg(100000)->Arg(1000000);
+        query->Arg(100000)->Arg(1000000);
+    }
+    return 0;
+}
+
+const int corpusBenchmarksRegistered = registerCorpusBenchmarks();
+
+} // anonymous namespace
+
+} // namespace Ragger
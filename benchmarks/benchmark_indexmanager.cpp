@@ -0,0 +1,131 @@
+#include "IndexManager.h"
+#include "ragger_plugin_api.h"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace Ragger {
+
+namespace {
+
+// Write a small synthetic corpus of C++-ish files so the benchmarks
+// exercise realistic tokenization and posting volume
+fs::path makeCorpus(size_t numFiles) {
+    fs::path root = fs::temp_directory_path() /
+                    ("ragger-bench-corpus-" + std::to_string(numFiles));
+    if (fs::exists(root)) {
+        return root; // Reuse across iterations; content is deterministic
+    }
+
+    fs::create_directories(root);
+    for (size_t i = 0; i < numFiles; ++i) {
+        std::ofstream out(root / ("file_" + std::to_string(i) + ".cpp"));
+        for (int fn = 0; fn < 20; ++fn) {
+            out << "int computeValue" << i << "_" << fn
+                << "(int inputParameter, int scaleFactor) {\n"
+                << "    int accumulatedResult = inputParameter * scaleFactor;\n"
+                << "    return accumulatedResult + " << fn << ";\n"
+                << "}\n\n";
+        }
+    }
+    return root;
+}
+
+fs::path freshDatabasePath(const char* tag) {
+    static int counter = 0;
+    return fs::temp_directory_path() /
+           ("ragger-bench-" + std::string(tag) + "-" + std::to_string(counter++) + ".db");
+}
+
+void removeDatabase(const fs::path& dbPath) {
+    std::error_code ec;
+    fs::remove(dbPath, ec);
+    fs::remove(fs::path(dbPath.string() + "-wal"), ec);
+    fs::remove(fs::path(dbPath.string() + "-shm"), ec);
+    fs::remove(fs::path(dbPath.string() + ".snapshot"), ec);
+}
+
+} // anonymous namespace
+
+// Cold index: empty database, every file is new
+static void BM_ColdIndex(benchmark::State& state) {
+    fs::path corpus = makeCorpus(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        fs::path dbPath = freshDatabasePath("cold");
+        IndexManager indexManager;
+        indexManager.setDatabasePath(dbPath);
+        indexManager.initialize();
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(indexManager.indexDirectory(corpus));
+
+        state.PauseTiming();
+        indexManager.shutdown();
+        removeDatabase(dbPath);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ColdIndex)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+// Incremental reindex: everything is up to date except one touched file
+static void BM_IncrementalReindex(benchmark::State& state) {
+    fs::path corpus = makeCorpus(static_cast<size_t>(state.range(0)));
+    fs::path dbPath = freshDatabasePath("incremental");
+
+    IndexManager indexManager;
+    indexManager.setDatabasePath(dbPath);
+    indexManager.initialize();
+    indexManager.indexDirectory(corpus);
+
+    fs::path touched = corpus / "file_0.cpp";
+    int generation = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        {
+            std::ofstream out(touched, std::ios::app);
+            out << "// generation " << generation++ << "\n";
+        }
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(indexManager.indexDirectory(corpus));
+    }
+
+    indexManager.shutdown();
+    removeDatabase(dbPath);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IncrementalReindex)->Arg(256)->Unit(benchmark::kMillisecond);
+
+// Content search over the inverted index
+static void BM_FindFilesByContent(benchmark::State& state) {
+    fs::path corpus = makeCorpus(static_cast<size_t>(state.range(0)));
+    fs::path dbPath = freshDatabasePath("search");
+
+    IndexManager indexManager;
+    indexManager.setDatabasePath(dbPath);
+    indexManager.initialize();
+    indexManager.indexDirectory(corpus);
+
+    for (auto _ : state) {
+        std::vector<fs::path> results;
+        benchmark::DoNotOptimize(
+            indexManager.findFilesByContent("accumulated result scale", results));
+        benchmark::DoNotOptimize(results.size());
+    }
+
+    indexManager.shutdown();
+    removeDatabase(dbPath);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FindFilesByContent)->Arg(256)->Unit(benchmark::kMicrosecond);
+
+} // namespace Ragger
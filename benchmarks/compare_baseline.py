@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""Compare two Google Benchmark JSON outputs and fail on regressions.
+
+Usage:
+    ./bin/ragger-benchmarks --benchmark_out=baseline.json --benchmark_out_format=json
+    # ... make changes ...
+    ./bin/ragger-benchmarks --benchmark_out=current.json --benchmark_out_format=json
+    ./benchmarks/compare_baseline.py baseline.json current.json [--threshold 0.10]
+
+Exits non-zero if any benchmark present in both files got slower than the
+threshold (default 10% on real_time), so CI can gate on it.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    with open(path) as f:
+        data = json.load(f)
+    results = {}
+    for bench in data.get("benchmarks", []):
+        # Skip aggregate rows (mean/median/stddev) from repeated runs
+        if bench.get("run_type") == "aggregate":
+            continue
+        results[bench["name"]] = bench["real_time"]
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline", help="baseline benchmark JSON")
+    parser.add_argument("current", help="current benchmark JSON")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="allowed slowdown fraction (default 0.10)")
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline)
+    current = load_results(args.current)
+
+    regressions = []
+    for name, base_time in sorted(baseline.items()):
+        if name not in current:
+            print(f"MISSING  {name} (in baseline, not in current run)")
+            continue
+        cur_time = current[name]
+        ratio = cur_time / base_time if base_time > 0 else float("inf")
+        status = "OK"
+        if ratio > 1.0 + args.threshold:
+            status = "REGRESSION"
+            regressions.append(name)
+        print(f"{status:<10} {name}: {base_time:.1f} -> {cur_time:.1f} "
+              f"({(ratio - 1.0) * 100.0:+.1f}%)")
+
+    for name in sorted(set(current) - set(baseline)):
+        print(f"NEW      {name} (no baseline entry)")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) regressed beyond "
+              f"{args.threshold * 100.0:.0f}%")
+        return 1
+    print("\nNo regressions beyond threshold")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,14 +1,316 @@
 #include "ragger_plugin_api.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <future>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
-#include <string>
-#include <cstring>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 namespace {
 
-// Simplified LSP client implementation
-// In a real implementation, this would use actual LSP protocol communication
+std::string jsonEscape(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size() + 8);
+    for (char c : value) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default: escaped += c; break;
+        }
+    }
+    return escaped;
+}
+
+// Async JSON-RPC transport over a language server's stdio. Requests are
+// pipelined: any number can be in flight, a reader thread correlates
+// responses by id (servers may answer out of order), and didOpen /
+// didChange notifications are coalesced per document and flushed in one
+// write ahead of the next request.
+class LSPTransport {
+public:
+    LSPTransport() : pid_(-1), stdinFd_(-1), stdoutFd_(-1), nextRequestId_(1),
+                     running_(false) {}
+
+    ~LSPTransport() {
+        stop();
+    }
+
+    bool start(const std::string& executable, const std::string& workspaceRoot) {
+        int inPipe[2];  // core -> server stdin
+        int outPipe[2]; // server stdout -> core
+        if (pipe(inPipe) != 0 || pipe(outPipe) != 0) {
+            return false;
+        }
+
+        pid_t pid = fork();
+        if (pid < 0) {
+            return false;
+        }
+        if (pid == 0) {
+            // Child: wire pipes to stdio and exec the server
+            dup2(inPipe[0], STDIN_FILENO);
+            dup2(outPipe[1], STDOUT_FILENO);
+            close(inPipe[0]);
+            close(inPipe[1]);
+            close(outPipe[0]);
+            close(outPipe[1]);
+            execlp(executable.c_str(), executable.c_str(), nullptr);
+            _exit(127);
+        }
+
+        close(inPipe[0]);
+        close(outPipe[1]);
+        pid_ = pid;
+        stdinFd_ = inPipe[1];
+        stdoutFd_ = outPipe[0];
+        running_ = true;
+
+        readerThread_ = std::thread(&LSPTransport::readerLoop, this);
+
+        // LSP handshake; a slow server fails the start rather than
+        // blocking every later query
+        std::string params = "{\"processId\":" + std::to_string(getpid()) +
+                             ",\"rootUri\":\"file://" + jsonEscape(workspaceRoot) +
+                             "\",\"capabilities\":{}}";
+        auto reply = request("initialize", params);
+        if (reply.wait_for(std::chrono::seconds(10)) != std::future_status::ready) {
+            stop();
+            return false;
+        }
+        notify("initialized", "{}");
+        return true;
+    }
+
+    void stop() {
+        if (!running_.exchange(false)) {
+            return;
+        }
+
+        // Best-effort polite shutdown
+        writeMessage(buildRequest(nextRequestId_++, "shutdown", "{}"));
+        writeMessage(buildNotification("exit", "{}"));
+
+        if (stdinFd_ >= 0) {
+            close(stdinFd_);
+            stdinFd_ = -1;
+        }
+        if (readerThread_.joinable()) {
+            readerThread_.join();
+        }
+        if (stdoutFd_ >= 0) {
+            close(stdoutFd_);
+            stdoutFd_ = -1;
+        }
+        if (pid_ > 0) {
+            int status = 0;
+            if (waitpid(pid_, &status, WNOHANG) == 0) {
+                kill(pid_, SIGTERM);
+                waitpid(pid_, &status, 0);
+            }
+            pid_ = -1;
+        }
+
+        // Fail anything still in flight
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        for (auto& pair : pendingRequests_) {
+            pair.second.set_value("");
+        }
+        pendingRequests_.clear();
+    }
+
+    bool isRunning() const {
+        return running_;
+    }
+
+    // Pipelined request: returns immediately with a future the reader
+    // thread fulfills whenever this id's response arrives
+    std::future<std::string> request(const std::string& method, const std::string& params) {
+        int id = nextRequestId_++;
+        std::promise<std::string> promise;
+        std::future<std::string> future = promise.get_future();
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex_);
+            pendingRequests_[id] = std::move(promise);
+        }
+
+        flushDocumentNotifications();
+        if (!writeMessage(buildRequest(id, method, params))) {
+            std::lock_guard<std::mutex> lock(pendingMutex_);
+            auto it = pendingRequests_.find(id);
+            if (it != pendingRequests_.end()) {
+                it->second.set_value("");
+                pendingRequests_.erase(it);
+            }
+        }
+        return future;
+    }
+
+    void notify(const std::string& method, const std::string& params) {
+        writeMessage(buildNotification(method, params));
+    }
+
+    // Document sync notifications coalesce per URI (latest content wins)
+    // and go out in a single write before the next request
+    void queueDocumentChange(const std::string& uri, const std::string& text, bool isOpen) {
+        std::lock_guard<std::mutex> lock(documentMutex_);
+        pendingDocuments_[uri] = {text, isOpen || pendingDocuments_.count(uri) == 0};
+    }
+
+    void flushDocumentNotifications() {
+        std::unordered_map<std::string, PendingDocument> batch;
+        {
+            std::lock_guard<std::mutex> lock(documentMutex_);
+            batch.swap(pendingDocuments_);
+        }
+        if (batch.empty()) {
+            return;
+        }
+
+        std::string combined;
+        for (const auto& pair : batch) {
+            std::string params;
+            if (pair.second.isOpen) {
+                params = "{\"textDocument\":{\"uri\":\"" + jsonEscape(pair.first) +
+                         "\",\"languageId\":\"\",\"version\":1,\"text\":\"" +
+                         jsonEscape(pair.second.text) + "\"}}";
+                combined += buildNotification("textDocument/didOpen", params);
+            } else {
+                params = "{\"textDocument\":{\"uri\":\"" + jsonEscape(pair.first) +
+                         "\",\"version\":2},\"contentChanges\":[{\"text\":\"" +
+                         jsonEscape(pair.second.text) + "\"}]}";
+                combined += buildNotification("textDocument/didChange", params);
+            }
+        }
+        writeRaw(combined);
+    }
+
+private:
+    struct PendingDocument {
+        std::string text;
+        bool isOpen;
+    };
+
+    static std::string frame(const std::string& body) {
+        return "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+    }
+
+    static std::string buildRequest(int id, const std::string& method, const std::string& params) {
+        return frame("{\"jsonrpc\":\"2.0\",\"id\":" + std::to_string(id) +
+                     ",\"method\":\"" + method + "\",\"params\":" + params + "}");
+    }
+
+    static std::string buildNotification(const std::string& method, const std::string& params) {
+        return frame("{\"jsonrpc\":\"2.0\",\"method\":\"" + method +
+                     "\",\"params\":" + params + "}");
+    }
+
+    bool writeMessage(const std::string& framed) {
+        return writeRaw(framed);
+    }
+
+    bool writeRaw(const std::string& data) {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        if (stdinFd_ < 0) {
+            return false;
+        }
+        size_t written = 0;
+        while (written < data.size()) {
+            ssize_t n = write(stdinFd_, data.data() + written, data.size() - written);
+            if (n <= 0) {
+                return false;
+            }
+            written += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    void readerLoop() {
+        std::string buffer;
+        char chunk[4096];
+
+        while (running_) {
+            ssize_t n = read(stdoutFd_, chunk, sizeof(chunk));
+            if (n <= 0) {
+                break;
+            }
+            buffer.append(chunk, static_cast<size_t>(n));
+
+            // Drain every complete Content-Length frame in the buffer
+            while (true) {
+                size_t headerEnd = buffer.find("\r\n\r\n");
+                if (headerEnd == std::string::npos) {
+                    break;
+                }
+                size_t lengthPos = buffer.find("Content-Length:");
+                if (lengthPos == std::string::npos || lengthPos > headerEnd) {
+                    buffer.erase(0, headerEnd + 4);
+                    continue;
+                }
+                size_t contentLength = std::strtoul(buffer.c_str() + lengthPos + 15, nullptr, 10);
+                size_t bodyStart = headerEnd + 4;
+                if (buffer.size() < bodyStart + contentLength) {
+                    break; // Frame incomplete; read more
+                }
+                dispatchMessage(buffer.substr(bodyStart, contentLength));
+                buffer.erase(0, bodyStart + contentLength);
+            }
+        }
+    }
+
+    void dispatchMessage(const std::string& body) {
+        // Responses carry an id; server-initiated notifications
+        // (diagnostics, logs) do not and are dropped here
+        size_t idPos = body.find("\"id\"");
+        if (idPos == std::string::npos) {
+            return;
+        }
+        size_t colon = body.find(':', idPos);
+        if (colon == std::string::npos) {
+            return;
+        }
+        int id = std::atoi(body.c_str() + colon + 1);
+
+        std::promise<std::string> promise;
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex_);
+            auto it = pendingRequests_.find(id);
+            if (it == pendingRequests_.end()) {
+                return; // Server-to-client request; not supported
+            }
+            promise = std::move(it->second);
+            pendingRequests_.erase(it);
+        }
+        promise.set_value(body);
+    }
+
+    pid_t pid_;
+    int stdinFd_;
+    int stdoutFd_;
+    std::atomic<int> nextRequestId_;
+    std::atomic<bool> running_;
+    std::thread readerThread_;
+    std::mutex writeMutex_;
+    std::mutex pendingMutex_;
+    std::map<int, std::promise<std::string>> pendingRequests_;
+    std::mutex documentMutex_;
+    std::unordered_map<std::string, PendingDocument> pendingDocuments_;
+};
+
+// LSP client: server configs plus one live transport per language
 class LSPClient {
 private:
     struct LanguageServer {
@@ -17,7 +319,8 @@ private:
         std::string workingDirectory;
         bool running;
         std::unordered_map<std::string, bool> capabilities;
-        
+        std::unique_ptr<LSPTransport> transport;
+
         LanguageServer() : running(false) {}
         LanguageServer(const std::string& lang, const std::string& exec, const std::string& workDir)
             : language(lang), executable(exec), workingDirectory(workDir), running(false) {
@@ -34,6 +337,47 @@ private:
     std::unordered_map<std::string, LanguageServer> servers_;
     bool initialized_;
 
+    static std::string fileUri(const std::string& filePath) {
+        if (filePath.rfind("file://", 0) == 0) {
+            return filePath;
+        }
+        if (!filePath.empty() && filePath[0] == '/') {
+            return "file://" + filePath;
+        }
+        return "file://./" + filePath;
+    }
+
+    static std::string positionParams(const std::string& filePath, int line, int column) {
+        return "{\"textDocument\":{\"uri\":\"" + jsonEscape(fileUri(filePath)) +
+               "\"},\"position\":{\"line\":" + std::to_string(line > 0 ? line - 1 : 0) +
+               ",\"character\":" + std::to_string(column > 0 ? column - 1 : 0) + "}}";
+    }
+
+    // Pull "uri" and "line" out of a definition/references response
+    // without a JSON library; enough for jump targets
+    static std::string extractLocation(const std::string& response) {
+        size_t uriPos = response.find("\"uri\"");
+        if (uriPos == std::string::npos) {
+            return "";
+        }
+        size_t quoteStart = response.find('"', response.find(':', uriPos) + 1);
+        size_t quoteEnd = response.find('"', quoteStart + 1);
+        if (quoteStart == std::string::npos || quoteEnd == std::string::npos) {
+            return "";
+        }
+        std::string uri = response.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
+        if (uri.rfind("file://", 0) == 0) {
+            uri = uri.substr(7);
+        }
+
+        int line = 0;
+        size_t linePos = response.find("\"line\"", quoteEnd);
+        if (linePos != std::string::npos) {
+            line = std::atoi(response.c_str() + response.find(':', linePos) + 1) + 1;
+        }
+        return uri + ":" + std::to_string(line) + ":1";
+    }
+
 public:
     LSPClient() : initialized_(false) {
         initializeServers();
@@ -48,7 +392,7 @@ public:
         servers_["java"] = LanguageServer("java", "jdtls", ".");
         servers_["go"] = LanguageServer("go", "gopls", ".");
         servers_["rust"] = LanguageServer("rust", "rust-analyzer", ".");
-        
+
         initialized_ = true;
     }
 
@@ -71,9 +415,21 @@ public:
         }
 
         LanguageServer& server = it->second;
+        if (server.running && server.transport && server.transport->isRunning()) {
+            return true;
+        }
+
         server.workingDirectory = workspaceRoot;
+        server.transport = std::make_unique<LSPTransport>();
+        if (!server.transport->start(server.executable, workspaceRoot)) {
+            std::cerr << "LSPClient: Failed to start " << server.executable
+                      << " for " << language << std::endl;
+            server.transport.reset();
+            server.running = false;
+            return false;
+        }
+
         server.running = true;
-        
         std::cout << "LSPClient: Started " << language << " language server" << std::endl;
         return true;
     }
@@ -84,6 +440,10 @@ public:
             return false;
         }
 
+        if (it->second.transport) {
+            it->second.transport->stop();
+            it->second.transport.reset();
+        }
         it->second.running = false;
         std::cout << "LSPClient: Stopped " << language << " language server" << std::endl;
         return true;
@@ -99,12 +459,41 @@ public:
         return capIt != it->second.capabilities.end() ? capIt->second : false;
     }
 
-    // Simplified completion implementation
-    std::vector<std::string> getCompletions(const std::string& language, 
-                                           const std::string& filePath, 
+    void notifyDocumentChanged(const std::string& language, const std::string& filePath,
+                               const std::string& text, bool isOpen) {
+        auto it = servers_.find(language);
+        if (it != servers_.end() && it->second.transport) {
+            it->second.transport->queueDocumentChange(fileUri(filePath), text, isOpen);
+        }
+    }
+
+    std::vector<std::string> getCompletions(const std::string& language,
+                                           const std::string& filePath,
                                            int line, int column) {
+        auto it = servers_.find(language);
+        if (it != servers_.end() && it->second.transport && it->second.transport->isRunning()) {
+            auto reply = it->second.transport->request("textDocument/completion",
+                                                       positionParams(filePath, line, column));
+            if (reply.wait_for(std::chrono::seconds(2)) == std::future_status::ready) {
+                // Collect "label" fields from the completion items
+                std::vector<std::string> completions;
+                std::string response = reply.get();
+                size_t pos = 0;
+                while ((pos = response.find("\"label\"", pos)) != std::string::npos) {
+                    size_t quoteStart = response.find('"', response.find(':', pos) + 1);
+                    size_t quoteEnd = response.find('"', quoteStart + 1);
+                    if (quoteStart == std::string::npos || quoteEnd == std::string::npos) {
+                        break;
+                    }
+                    completions.push_back(response.substr(quoteStart + 1, quoteEnd - quoteStart - 1));
+                    pos = quoteEnd;
+                }
+                return completions;
+            }
+        }
+
+        // No live server: static keyword fallback
         std::vector<std::string> completions;
-        
         if (language == "cpp") {
             completions = {"std::", "main", "int", "void", "class", "struct", "namespace"};
         } else if (language == "python") {
@@ -112,23 +501,45 @@ public:
         } else if (language == "javascript") {
             completions = {"function", "const", "let", "var", "class", "async", "await"};
         }
-        
         return completions;
     }
 
-    // Simplified definition lookup
-    std::string getDefinition(const std::string& language, 
-                             const std::string& filePath, 
+    std::string getDefinition(const std::string& language,
+                             const std::string& filePath,
                              int line, int column) {
-        // Stub implementation - would return actual definition location
+        auto it = servers_.find(language);
+        if (it != servers_.end() && it->second.transport && it->second.transport->isRunning()) {
+            auto reply = it->second.transport->request("textDocument/definition",
+                                                       positionParams(filePath, line, column));
+            if (reply.wait_for(std::chrono::seconds(2)) == std::future_status::ready) {
+                std::string location = extractLocation(reply.get());
+                if (!location.empty()) {
+                    return location;
+                }
+            }
+        }
         return filePath + ":" + std::to_string(line) + ":1";
     }
 
-    // Simplified hover information
-    std::string getHoverInfo(const std::string& language, 
-                           const std::string& filePath, 
+    std::string getHoverInfo(const std::string& language,
+                           const std::string& filePath,
                            int line, int column) {
-        // Stub implementation - would return actual hover information
+        auto it = servers_.find(language);
+        if (it != servers_.end() && it->second.transport && it->second.transport->isRunning()) {
+            auto reply = it->second.transport->request("textDocument/hover",
+                                                       positionParams(filePath, line, column));
+            if (reply.wait_for(std::chrono::seconds(2)) == std::future_status::ready) {
+                std::string response = reply.get();
+                size_t valuePos = response.find("\"value\"");
+                if (valuePos != std::string::npos) {
+                    size_t quoteStart = response.find('"', response.find(':', valuePos) + 1);
+                    size_t quoteEnd = response.find('"', quoteStart + 1);
+                    if (quoteStart != std::string::npos && quoteEnd != std::string::npos) {
+                        return response.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
+                    }
+                }
+            }
+        }
         return "Symbol information for " + language + " at line " + std::to_string(line);
     }
 };
@@ -137,7 +548,7 @@ public:
 struct LSPClientState {
     LSPClient client;
     bool initialized;
-    
+
     LSPClientState() : initialized(false) {}
 };
 
@@ -156,7 +567,7 @@ const char* plugin_get_name() {
 }
 
 const char* plugin_get_version() {
-    return "1.0.0";
+    return "1.1.0";
 }
 
 const char* plugin_get_description() {
@@ -170,7 +581,7 @@ int plugin_initialize(RaggerCoreHandle core) {
 
     g_state = new LSPClientState();
     g_state->initialized = true;
-    
+
     std::cout << "LSPClientPlugin: Initialized" << std::endl;
     return RAGGER_SUCCESS;
 }
@@ -209,12 +620,12 @@ const char** ragger_lsp_get_supported_languages(size_t* count) {
 
     static std::vector<const char*> languages;
     languages.clear();
-    
+
     auto supportedLanguages = g_state->client.getSupportedLanguages();
     for (const auto& lang : supportedLanguages) {
         languages.push_back(lang.c_str());
     }
-    
+
     *count = languages.size();
     return languages.data();
 }
@@ -223,7 +634,7 @@ bool ragger_lsp_is_language_supported(const char* language) {
     if (!g_state || !language) {
         return false;
     }
-    
+
     return g_state->client.isLanguageSupported(language);
 }
 
@@ -253,35 +664,47 @@ bool ragger_lsp_has_capability(const char* language, const char* capability) {
     return g_state->client.getCapabilities(language, capability);
 }
 
-int ragger_lsp_get_completions(const char* language, const char* filePath, 
+// Queues a coalesced didOpen/didChange; the transport batches these into
+// one write before the next request goes out
+int ragger_lsp_notify_document(const char* language, const char* filePath,
+                               const char* text, bool isOpen) {
+    if (!g_state || !language || !filePath || !text) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+
+    g_state->client.notifyDocumentChanged(language, filePath, text, isOpen);
+    return RAGGER_SUCCESS;
+}
+
+int ragger_lsp_get_completions(const char* language, const char* filePath,
                               int line, int column, char*** completions, size_t* count) {
     if (!g_state || !language || !filePath || !completions || !count) {
         return RAGGER_ERROR_INVALID_ARGUMENT;
     }
 
     auto completionList = g_state->client.getCompletions(language, filePath, line, column);
-    
+
     *count = completionList.size();
     *completions = new char*[*count];
-    
+
     for (size_t i = 0; i < *count; ++i) {
         (*completions)[i] = new char[completionList[i].length() + 1];
         strcpy((*completions)[i], completionList[i].c_str());
     }
-    
+
     return RAGGER_SUCCESS;
 }
 
 void ragger_lsp_free_completions(char** completions, size_t count) {
     if (!completions) return;
-    
+
     for (size_t i = 0; i < count; ++i) {
         delete[] completions[i];
     }
     delete[] completions;
 }
 
-int ragger_lsp_get_definition(const char* language, const char* filePath, 
+int ragger_lsp_get_definition(const char* language, const char* filePath,
                              int line, int column, char** definition) {
     if (!g_state || !language || !filePath || !definition) {
         return RAGGER_ERROR_INVALID_ARGUMENT;
@@ -290,7 +713,7 @@ int ragger_lsp_get_definition(const char* language, const char* filePath,
     std::string def = g_state->client.getDefinition(language, filePath, line, column);
     *definition = new char[def.length() + 1];
     strcpy(*definition, def.c_str());
-    
+
     return RAGGER_SUCCESS;
 }
 
@@ -298,7 +721,7 @@ void ragger_lsp_free_definition(char* definition) {
     delete[] definition;
 }
 
-int ragger_lsp_get_hover(const char* language, const char* filePath, 
+int ragger_lsp_get_hover(const char* language, const char* filePath,
                         int line, int column, char** hoverInfo) {
     if (!g_state || !language || !filePath || !hoverInfo) {
         return RAGGER_ERROR_INVALID_ARGUMENT;
@@ -307,7 +730,7 @@ int ragger_lsp_get_hover(const char* language, const char* filePath,
     std::string hover = g_state->client.getHoverInfo(language, filePath, line, column);
     *hoverInfo = new char[hover.length() + 1];
     strcpy(*hoverInfo, hover.c_str());
-    
+
     return RAGGER_SUCCESS;
 }
 
@@ -1,24 +1,69 @@
 #include "ragger_plugin_api.h"
+#include "FastHash.h"
+#include "FileUtils.h"
 #include <iostream>
 #include <string>
 #include <cstring>
+#include <cstdio>
 #include <fstream>
 #include <sstream>
 #include <filesystem>
 #include <regex>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
+// Parse .clang-format file
+struct ClangFormatInfo {
+    std::string basedOnStyle;
+    std::string indentWidth;
+    bool found;
+
+    ClangFormatInfo() : found(false) {}
+};
+
 namespace {
     // Plugin state
     struct StaticAnalysisState {
         bool initialized;
         std::string projectRoot;
-        
-        StaticAnalysisState() : initialized(false) {}
+
+        // Analysis cache keyed by content hash: identical content always
+        // produces identical findings, so a hit skips the regex pass
+        // entirely. Persisted across runs in a sidecar file and warmed
+        // by a background pre-analysis pass, so interactive queries
+        // almost always hit.
+        std::mutex cacheMutex;
+        std::unordered_map<std::string, std::string> findingsByHash;
+        bool cacheDirty;
+
+        // .clang-format findings, re-parsed only when its content changes
+        ClangFormatInfo clangInfo;
+        std::string clangFormatHash;
+
+        std::thread preAnalysisThread;
+        std::atomic<bool> stopPreAnalysis;
+
+        StaticAnalysisState() : initialized(false), cacheDirty(false), stopPreAnalysis(false) {}
     };
-    
+
     StaticAnalysisState* g_state = nullptr;
+
+    // Same fast-hash format the index uses for change detection
+    std::string hashFileContents(const std::string& filePath) {
+        Ragger::FileView view;
+        if (view.map(filePath) != RAGGER_SUCCESS) {
+            return "";
+        }
+        char formatted[32];
+        snprintf(formatted, sizeof(formatted), "xx64:%016llx",
+                 static_cast<unsigned long long>(
+                     Ragger::FastHash::hash64(view.data(), view.size())));
+        return formatted;
+    }
 }
 
 // Helper function to find project root
@@ -37,30 +82,21 @@ std::string findProjectRoot(const std::string& startPath = ".") {
     return std::filesystem::absolute(".").string();
 }
 
-// Parse .clang-format file
-struct ClangFormatInfo {
-    std::string basedOnStyle;
-    std::string indentWidth;
-    bool found;
-    
-    ClangFormatInfo() : found(false) {}
-};
-
 ClangFormatInfo parseClangFormat(const std::string& filePath) {
     ClangFormatInfo info;
-    
+
     if (!std::filesystem::exists(filePath)) {
         return info;
     }
-    
+
     std::ifstream file(filePath);
     std::string line;
-    
+
     while (std::getline(file, line)) {
         // Remove leading/trailing whitespace
         line.erase(0, line.find_first_not_of(" \t"));
         line.erase(line.find_last_not_of(" \t") + 1);
-        
+
         if (line.find("BasedOnStyle:") != std::string::npos) {
             info.basedOnStyle = line.substr(line.find(":") + 1);
             // Remove leading whitespace
@@ -73,7 +109,7 @@ ClangFormatInfo parseClangFormat(const std::string& filePath) {
             info.found = true;
         }
     }
-    
+
     return info;
 }
 
@@ -86,17 +122,17 @@ struct TodoComment {
 
 std::vector<TodoComment> findTodoComments(const std::string& filePath) {
     std::vector<TodoComment> comments;
-    
+
     if (!std::filesystem::exists(filePath)) {
         return comments;
     }
-    
+
     std::ifstream file(filePath);
     std::string line;
     int lineNumber = 1;
-    
+
     std::regex todoRegex(R"(//\s*(TODO|FIXME)[:\s]*(.*))", std::regex_constants::icase);
-    
+
     while (std::getline(file, line)) {
         std::smatch match;
         if (std::regex_search(line, match, todoRegex)) {
@@ -111,10 +147,170 @@ std::vector<TodoComment> findTodoComments(const std::string& filePath) {
         }
         lineNumber++;
     }
-    
+
     return comments;
 }
 
+namespace {
+
+// The regex pass over one file, producing the per-file findings section
+std::string analyzeTodoFindings(const std::string& filePath) {
+    std::vector<TodoComment> comments = findTodoComments(filePath);
+
+    if (comments.empty()) {
+        return "* **Actionable Comments:** No TODO/FIXME comments found.\n";
+    }
+
+    // Use the first TODO comment found
+    const TodoComment& firstComment = comments[0];
+    return "* **Actionable Comments:** Found a `// " + firstComment.type + ":` comment on line " +
+           std::to_string(firstComment.lineNumber) + " with the message: \"" +
+           firstComment.message + "\".\n";
+}
+
+// Cache-through lookup: hash the content, return stored findings on a
+// hit, analyze and store on a miss. Unhashable files (vanished,
+// unreadable) are analyzed uncached.
+std::string findingsForFile(const std::string& filePath) {
+    std::string hash = hashFileContents(filePath);
+
+    if (!hash.empty()) {
+        std::lock_guard<std::mutex> lock(g_state->cacheMutex);
+        auto it = g_state->findingsByHash.find(hash);
+        if (it != g_state->findingsByHash.end()) {
+            return it->second;
+        }
+    }
+
+    std::string findings = analyzeTodoFindings(filePath);
+
+    if (!hash.empty()) {
+        std::lock_guard<std::mutex> lock(g_state->cacheMutex);
+        g_state->findingsByHash[hash] = findings;
+        g_state->cacheDirty = true;
+    }
+
+    return findings;
+}
+
+std::filesystem::path cacheFilePath() {
+    return std::filesystem::path(g_state->projectRoot) / "data" / "static_analysis.cache";
+}
+
+// Sidecar format: one "hash<TAB>byteCount" header line per entry
+// followed by exactly byteCount findings bytes and a newline
+void loadCache() {
+    std::ifstream file(cacheFilePath(), std::ios::binary);
+    if (!file.is_open()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(g_state->cacheMutex);
+    std::string header;
+    while (std::getline(file, header)) {
+        size_t tab = header.find('\t');
+        if (tab == std::string::npos) {
+            break; // Corrupt entry; stop rather than guess
+        }
+        std::string hash = header.substr(0, tab);
+        size_t length = 0;
+        try {
+            length = std::stoul(header.substr(tab + 1));
+        } catch (...) {
+            break;
+        }
+
+        std::string findings(length, '\0');
+        if (!file.read(&findings[0], static_cast<std::streamsize>(length))) {
+            break;
+        }
+        file.get(); // Trailing newline
+
+        g_state->findingsByHash[hash] = std::move(findings);
+    }
+
+    if (!g_state->findingsByHash.empty()) {
+        std::cout << "StaticAnalysisPlugin: Loaded " << g_state->findingsByHash.size()
+                  << " cached analyses" << std::endl;
+    }
+}
+
+void saveCache() {
+    std::lock_guard<std::mutex> lock(g_state->cacheMutex);
+    if (!g_state->cacheDirty) {
+        return;
+    }
+
+    std::filesystem::path path = cacheFilePath();
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return;
+    }
+
+    for (const auto& pair : g_state->findingsByHash) {
+        file << pair.first << '\t' << pair.second.size() << '\n'
+             << pair.second << '\n';
+    }
+    g_state->cacheDirty = false;
+}
+
+bool isAnalyzableSource(const std::filesystem::path& filePath) {
+    static const char* extensions[] = {
+        ".cpp", ".cxx", ".cc", ".c", ".hpp", ".hxx", ".h",
+        ".py", ".java", ".js", ".ts", ".rs", ".go"
+    };
+    std::string ext = filePath.extension().string();
+    for (const char* candidate : extensions) {
+        if (ext == candidate) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Background pre-analysis: walk the project once at startup and warm
+// the cache, so interactive queries hit stored findings. The walk skips
+// the usual non-source trees and checks the stop flag between files so
+// shutdown never waits on it.
+void preAnalyzeProject() {
+    size_t analyzed = 0;
+    std::error_code ec;
+    auto it = std::filesystem::recursive_directory_iterator(
+        g_state->projectRoot, std::filesystem::directory_options::skip_permission_denied, ec);
+    if (ec) {
+        return;
+    }
+
+    for (auto end = std::filesystem::end(it); it != end && !g_state->stopPreAnalysis; it.increment(ec)) {
+        if (ec) {
+            break;
+        }
+        const auto& entry = *it;
+        if (entry.is_directory(ec)) {
+            std::string name = entry.path().filename().string();
+            if (name == ".git" || name == "build" || name == "node_modules" || name == "data") {
+                it.disable_recursion_pending();
+            }
+            continue;
+        }
+        if (!entry.is_regular_file(ec) || !isAnalyzableSource(entry.path())) {
+            continue;
+        }
+        findingsForFile(entry.path().string());
+        ++analyzed;
+    }
+
+    if (!g_state->stopPreAnalysis) {
+        saveCache();
+        std::cout << "StaticAnalysisPlugin: Pre-analyzed " << analyzed << " files" << std::endl;
+    }
+}
+
+} // anonymous namespace
+
 extern "C" {
 
 int plugin_get_abi_version() {
@@ -141,15 +337,23 @@ int plugin_initialize(RaggerCoreHandle core) {
     g_state = new StaticAnalysisState();
     g_state->initialized = true;
     g_state->projectRoot = findProjectRoot();
-    
+
+    loadCache();
+    g_state->preAnalysisThread = std::thread(preAnalyzeProject);
+
     std::cout << "StaticAnalysisPlugin: Initialized" << std::endl;
     std::cout << "StaticAnalysisPlugin: Project root found at " << g_state->projectRoot << std::endl;
-    
+
     return RAGGER_SUCCESS;
 }
 
 void plugin_shutdown() {
     if (g_state) {
+        g_state->stopPreAnalysis = true;
+        if (g_state->preAnalysisThread.joinable()) {
+            g_state->preAnalysisThread.join();
+        }
+        saveCache();
         delete g_state;
         g_state = nullptr;
     }
@@ -167,7 +371,7 @@ void plugin_unregister_events() {
 const char* plugin_get_capabilities() {
     return R"({
         "static_analysis": {
-            "features": ["clang_format_parsing", "todo_comment_detection", "code_quality_analysis"]
+            "features": ["clang_format_parsing", "todo_comment_detection", "code_quality_analysis", "analysis_cache"]
         }
     })";
 }
@@ -176,18 +380,26 @@ const char* plugin_get_capabilities() {
 const char* generateStaticAnalysisContext(const char* filePath) {
     static std::string result;
     result.clear();
-    
+
     if (!g_state || !filePath) {
         result = "### PROJECT STANDARDS & ANALYSIS\n* **Formatting Rules (.clang-format):** Not found.\n* **Actionable Comments:** No TODO/FIXME comments found.\n";
         return result.c_str();
     }
-    
+
     result = "### PROJECT STANDARDS & ANALYSIS\n";
-    
-    // Check for .clang-format file
+
+    // Re-parse .clang-format only when its content actually changed
     std::string clangFormatPath = g_state->projectRoot + "/.clang-format";
-    ClangFormatInfo clangInfo = parseClangFormat(clangFormatPath);
-    
+    std::string clangFormatHash = hashFileContents(clangFormatPath);
+    {
+        std::lock_guard<std::mutex> lock(g_state->cacheMutex);
+        if (clangFormatHash != g_state->clangFormatHash) {
+            g_state->clangInfo = parseClangFormat(clangFormatPath);
+            g_state->clangFormatHash = clangFormatHash;
+        }
+    }
+    const ClangFormatInfo& clangInfo = g_state->clangInfo;
+
     if (clangInfo.found) {
         result += "* **Formatting Rules (.clang-format):** Found. Style: " + clangInfo.basedOnStyle;
         if (!clangInfo.indentWidth.empty()) {
@@ -197,19 +409,11 @@ const char* generateStaticAnalysisContext(const char* filePath) {
     } else {
         result += "* **Formatting Rules (.clang-format):** Not found.\n";
     }
-    
-    // Find TODO/FIXME comments
-    std::vector<TodoComment> comments = findTodoComments(filePath);
-    
-    if (!comments.empty()) {
-        // Use the first TODO comment found
-        TodoComment firstComment = comments[0];
-        result += "* **Actionable Comments:** Found a `// " + firstComment.type + ":` comment on line " + 
-                 std::to_string(firstComment.lineNumber) + " with the message: \"" + firstComment.message + "\".\n";
-    } else {
-        result += "* **Actionable Comments:** No TODO/FIXME comments found.\n";
-    }
-    
+
+    // Per-file findings come from the content-hash cache; only changed
+    // files pay for re-analysis
+    result += findingsForFile(filePath);
+
     return result.c_str();
 }
 
@@ -6,15 +6,99 @@
 
 namespace {
 
+// Test entry returned through the discovery API
+struct TestInfo {
+    char* name;
+    char* filePath;
+    int line;
+    char* framework; // "gtest", "catch2" or "heuristic"
+};
+
 // Plugin state
 struct TestDiscoveryState {
     bool initialized;
-    
-    TestDiscoveryState() : initialized(false) {}
+    const RaggerCoreAPI* coreAPI; // Null when the core wired no API
+
+    TestDiscoveryState() : initialized(false), coreAPI(nullptr) {}
 };
 
 TestDiscoveryState* g_state = nullptr;
 
+char* duplicateString(const char* source) {
+    if (!source) {
+        source = "";
+    }
+    size_t length = strlen(source);
+    char* copy = new char[length + 1];
+    memcpy(copy, source, length + 1);
+    return copy;
+}
+
+// The index tags blocks as tests; the framework is recovered from the
+// block content so callers can filter by runner
+const char* frameworkForBlock(const CodeBlock& block) {
+    if (!block.content) {
+        return "heuristic";
+    }
+    if (strstr(block.content, "TEST_CASE(") || strstr(block.content, "SCENARIO(") ||
+        strstr(block.content, "CATCH_TEST_CASE(")) {
+        return "catch2";
+    }
+    if (strstr(block.content, "TEST(") || strstr(block.content, "TEST_F(") ||
+        strstr(block.content, "TEST_P(") || strstr(block.content, "TYPED_TEST(")) {
+        return "gtest";
+    }
+    return "heuristic";
+}
+
+// Indexed lookup: the core answers from the is_test flag in code_blocks,
+// kept current by the indexing pipeline and the file watcher — no tree
+// walk on the query path. filePath may be null for all tests.
+int collectTests(const char* filePath, std::vector<TestInfo>& tests) {
+    if (!g_state->coreAPI || !g_state->coreAPI->find_test_blocks) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    CodeBlock* blocks = nullptr;
+    size_t numBlocks = 0;
+    int result = g_state->coreAPI->find_test_blocks(filePath, &blocks, &numBlocks);
+    if (result != RAGGER_SUCCESS) {
+        return result;
+    }
+
+    tests.reserve(numBlocks);
+    for (size_t i = 0; i < numBlocks; ++i) {
+        TestInfo info;
+        info.name = duplicateString(blocks[i].name);
+        info.filePath = duplicateString(blocks[i].filePath);
+        info.line = blocks[i].startLine;
+        info.framework = duplicateString(frameworkForBlock(blocks[i]));
+        tests.push_back(info);
+    }
+
+    if (g_state->coreAPI->free_code_blocks) {
+        g_state->coreAPI->free_code_blocks(blocks, numBlocks);
+    }
+    return RAGGER_SUCCESS;
+}
+
+// Move a collected vector into the caller-owned array the C API expects
+int publishTests(std::vector<TestInfo>& tests, void** out, size_t* count) {
+    if (tests.empty()) {
+        *out = nullptr;
+        *count = 0;
+        return RAGGER_SUCCESS;
+    }
+
+    TestInfo* array = new TestInfo[tests.size()];
+    for (size_t i = 0; i < tests.size(); ++i) {
+        array[i] = tests[i];
+    }
+    *out = array;
+    *count = tests.size();
+    return RAGGER_SUCCESS;
+}
+
 } // anonymous namespace
 
 extern "C" {
@@ -32,7 +116,7 @@ const char* plugin_get_version() {
 }
 
 const char* plugin_get_description() {
-    return "Test discovery plugin for RAGger";
+    return "Index-backed test discovery plugin for RAGger";
 }
 
 int plugin_initialize(RaggerCoreHandle core) {
@@ -42,7 +126,8 @@ int plugin_initialize(RaggerCoreHandle core) {
 
     g_state = new TestDiscoveryState();
     g_state->initialized = true;
-    
+    g_state->coreAPI = static_cast<const RaggerCoreAPI*>(core);
+
     std::cout << "TestDiscoveryPlugin: Initialized" << std::endl;
     return RAGGER_SUCCESS;
 }
@@ -56,23 +141,24 @@ void plugin_shutdown() {
 }
 
 void plugin_register_events(EventCallback callback, void* userData) {
-    // Register for test discovery events
+    // Discovery reads the index, which the indexing pipeline keeps
+    // current; no event subscriptions needed
 }
 
 void plugin_unregister_events() {
-    // Unregister events
+    // Nothing registered
 }
 
 const char* plugin_get_capabilities() {
     return R"({
         "test_discovery": {
             "languages": ["cpp"],
-            "features": ["test_detection", "coverage_integration"]
+            "features": ["test_detection", "coverage_integration"],
+            "backend": "index"
         }
     })";
 }
 
-// Test discovery functions (simplified stubs)
 const char** ragger_test_get_supported_languages(size_t* count) {
     static const char* languages[] = {"cpp"};
     *count = 1;
@@ -88,14 +174,31 @@ int ragger_test_discover_tests(const char* filePath, const char* language, void*
         return RAGGER_ERROR_INVALID_ARGUMENT;
     }
 
-    // TODO: Implement test discovery
-    *count = 0;
-    *tests = nullptr;
-    return RAGGER_SUCCESS;
+    if (!ragger_test_is_language_supported(language)) {
+        *tests = nullptr;
+        *count = 0;
+        return RAGGER_SUCCESS;
+    }
+
+    std::vector<TestInfo> found;
+    int result = collectTests(filePath, found);
+    if (result != RAGGER_SUCCESS) {
+        return result;
+    }
+    return publishTests(found, tests, count);
 }
 
 void ragger_test_free_test_info(void* tests, size_t count) {
-    // TODO: Implement proper cleanup
+    TestInfo* array = static_cast<TestInfo*>(tests);
+    if (!array) {
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        delete[] array[i].name;
+        delete[] array[i].filePath;
+        delete[] array[i].framework;
+    }
+    delete[] array;
 }
 
 int ragger_test_get_tests_for_file(const char* filePath, void** tests, size_t* count) {
@@ -103,10 +206,12 @@ int ragger_test_get_tests_for_file(const char* filePath, void** tests, size_t* c
         return RAGGER_ERROR_INVALID_ARGUMENT;
     }
 
-    // TODO: Implement file-specific test retrieval
-    *count = 0;
-    *tests = nullptr;
-    return RAGGER_SUCCESS;
+    std::vector<TestInfo> found;
+    int result = collectTests(filePath, found);
+    if (result != RAGGER_SUCCESS) {
+        return result;
+    }
+    return publishTests(found, tests, count);
 }
 
 int ragger_test_get_tests_by_type(const char* testType, void** tests, size_t* count) {
@@ -114,10 +219,23 @@ int ragger_test_get_tests_by_type(const char* testType, void** tests, size_t* co
         return RAGGER_ERROR_INVALID_ARGUMENT;
     }
 
-    // TODO: Implement type-specific test retrieval
-    *count = 0;
-    *tests = nullptr;
-    return RAGGER_SUCCESS;
+    std::vector<TestInfo> all;
+    int result = collectTests(nullptr, all);
+    if (result != RAGGER_SUCCESS) {
+        return result;
+    }
+
+    std::vector<TestInfo> matching;
+    for (TestInfo& info : all) {
+        if (strcmp(info.framework, testType) == 0) {
+            matching.push_back(info);
+        } else {
+            delete[] info.name;
+            delete[] info.filePath;
+            delete[] info.framework;
+        }
+    }
+    return publishTests(matching, tests, count);
 }
 
 int ragger_test_update_coverage(const char* filePath, float coveragePercentage) {
@@ -139,7 +257,22 @@ float ragger_test_get_coverage(const char* filePath) {
 }
 
 size_t ragger_test_get_total_test_count() {
-    return g_state ? 0 : 0; // TODO: Implement test count
+    if (!g_state) {
+        return 0;
+    }
+
+    std::vector<TestInfo> all;
+    if (collectTests(nullptr, all) != RAGGER_SUCCESS) {
+        return 0;
+    }
+
+    size_t total = all.size();
+    for (TestInfo& info : all) {
+        delete[] info.name;
+        delete[] info.filePath;
+        delete[] info.framework;
+    }
+    return total;
 }
 
 int ragger_test_get_uncovered_tests(void** tests, size_t* count) {
@@ -147,10 +280,14 @@ int ragger_test_get_uncovered_tests(void** tests, size_t* count) {
         return RAGGER_ERROR_INVALID_ARGUMENT;
     }
 
-    // TODO: Implement uncovered test retrieval
-    *count = 0;
-    *tests = nullptr;
-    return RAGGER_SUCCESS;
+    // Coverage tracking is not implemented yet, so no test is known to
+    // be covered
+    std::vector<TestInfo> all;
+    int result = collectTests(nullptr, all);
+    if (result != RAGGER_SUCCESS) {
+        return result;
+    }
+    return publishTests(all, tests, count);
 }
 
-} // extern "C"
\ No newline at end of file
+} // extern "C"
@@ -4,12 +4,24 @@
 #include <string>
 #include <cstring>
 #include <fstream>
+#include <mutex>
 #include <sstream>
 #include <filesystem>
 #include <regex>
 #include <algorithm>
 #include <map>
 #include <set>
+#include <string_view>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef RAGGER_HAVE_LIBGIT2
+#include <git2.h>
+#endif
 
 // Git integration structures
 struct GitBlameInfo {
@@ -51,14 +63,46 @@ struct DocumentationInfo {
 
 namespace {
 
+// Blame results for one file, valid only while HEAD stays at headCommit
+struct CachedBlame {
+    std::string headCommit;
+    std::vector<GitBlameInfo> lines;
+};
+
+// One documentation file as seen through the persistent cache; the views
+// point into the mapped cache file (or the in-memory fallback blob)
+struct DocCacheView {
+    std::string path;
+    std::string_view loweredContent;
+    std::string_view excerpt;
+};
+
 // Plugin state
 struct GitIntegrationState {
     bool initialized;
     std::string repositoryRoot;
     std::map<std::string, ProjectStandards> projectStandards;
-    std::map<std::string, std::vector<DocumentationInfo>> documentationCache;
-    
-    GitIntegrationState() : initialized(false) {}
+    std::map<std::string, CachedBlame> blameCache;
+    std::mutex blameMutex;
+
+    // Persistent documentation cache (memory-mapped when available)
+    std::mutex docMutex;
+    bool docCacheLoaded;
+    void* docMapping;
+    size_t docMappingSize;
+    std::string docFallbackBlob;
+    std::vector<DocCacheView> docViews;
+#ifdef RAGGER_HAVE_LIBGIT2
+    git_repository* repository;
+#endif
+
+    GitIntegrationState()
+        : initialized(false), docCacheLoaded(false),
+          docMapping(nullptr), docMappingSize(0) {
+#ifdef RAGGER_HAVE_LIBGIT2
+        repository = nullptr;
+#endif
+    }
 };
 
 GitIntegrationState* g_state = nullptr;
@@ -76,7 +120,7 @@ const char* plugin_get_name() {
 }
 
 const char* plugin_get_version() {
-    return "1.0.0";
+    return "1.1.0";
 }
 
 const char* plugin_get_description() {
@@ -90,15 +134,31 @@ int plugin_initialize(RaggerCoreHandle core) {
 
     g_state = new GitIntegrationState();
     g_state->initialized = true;
-    
-    std::cout << "GitIntegrationPlugin: Initialized" << std::endl;
+
+#ifdef RAGGER_HAVE_LIBGIT2
+    git_libgit2_init();
+    std::cout << "GitIntegrationPlugin: Initialized (libgit2)" << std::endl;
+#else
+    std::cout << "GitIntegrationPlugin: Initialized (git command-line fallback)" << std::endl;
+#endif
     return RAGGER_SUCCESS;
 }
 
 void plugin_shutdown() {
     if (g_state) {
+        if (g_state->docMapping) {
+            munmap(g_state->docMapping, g_state->docMappingSize);
+        }
+#ifdef RAGGER_HAVE_LIBGIT2
+        if (g_state->repository) {
+            git_repository_free(g_state->repository);
+        }
+#endif
         delete g_state;
         g_state = nullptr;
+#ifdef RAGGER_HAVE_LIBGIT2
+        git_libgit2_shutdown();
+#endif
     }
     std::cout << "GitIntegrationPlugin: Shutdown" << std::endl;
 }
@@ -114,7 +174,7 @@ void plugin_unregister_events() {
 const char* plugin_get_capabilities() {
     return R"({
         "git_integration": {
-            "features": ["blame", "commit_history", "branch_info"]
+            "features": ["blame", "blame_cache", "commit_history", "branch_info", "status"]
         }
     })";
 }
@@ -149,62 +209,147 @@ std::vector<std::string> splitLines(const std::string& text) {
     return lines;
 }
 
-// Git-specific functions
-bool ragger_git_is_repository(const char* path) {
-    if (!g_state || !path) {
-        return false;
+#ifdef RAGGER_HAVE_LIBGIT2
+
+// Open (and cache) the repository containing repositoryRoot or the cwd
+static git_repository* openRepository() {
+    if (g_state->repository) {
+        return g_state->repository;
     }
-    
-    std::string gitDir = std::string(path) + "/.git";
-    return std::filesystem::exists(gitDir) || std::filesystem::exists(gitDir + "/HEAD");
+
+    const std::string start = g_state->repositoryRoot.empty() ? "." : g_state->repositoryRoot;
+    if (git_repository_open_ext(&g_state->repository, start.c_str(), 0, nullptr) != 0) {
+        g_state->repository = nullptr;
+        return nullptr;
+    }
+
+    if (const char* workdir = git_repository_workdir(g_state->repository)) {
+        std::string root = workdir;
+        if (!root.empty() && root.back() == '/') {
+            root.pop_back();
+        }
+        g_state->repositoryRoot = root;
+    }
+    return g_state->repository;
 }
 
-int ragger_git_get_repository_root(const char* path, char** rootPath) {
-    if (!g_state || !path || !rootPath) {
-        return RAGGER_ERROR_INVALID_ARGUMENT;
+// Path relative to the repository workdir, as libgit2 expects
+static std::string repositoryRelativePath(const std::string& filePath) {
+    git_repository* repo = openRepository();
+    if (!repo || g_state->repositoryRoot.empty()) {
+        return filePath;
     }
 
-    std::string result = executeGitCommand("git rev-parse --show-toplevel", std::string(path));
-    if (result.empty()) {
-        *rootPath = nullptr;
-        return RAGGER_ERROR_FILE_NOT_FOUND;
+    std::error_code ec;
+    std::filesystem::path absolute = std::filesystem::absolute(filePath, ec);
+    if (ec) {
+        return filePath;
     }
-    
-    *rootPath = new char[result.length() + 1];
-    strcpy(*rootPath, result.c_str());
-    g_state->repositoryRoot = result;
-    return RAGGER_SUCCESS;
+    std::filesystem::path relative = std::filesystem::relative(absolute, g_state->repositoryRoot, ec);
+    if (ec || relative.empty() || relative.native().rfind("..", 0) == 0) {
+        return filePath;
+    }
+    return relative.generic_string();
 }
 
-void ragger_git_free_string(char* str) {
-    delete[] str;
+#endif // RAGGER_HAVE_LIBGIT2
+
+// Commit hash HEAD currently points at; used as the blame cache key
+static std::string currentHeadCommit() {
+#ifdef RAGGER_HAVE_LIBGIT2
+    git_repository* repo = openRepository();
+    if (repo) {
+        git_oid oid;
+        if (git_reference_name_to_id(&oid, repo, "HEAD") == 0) {
+            char hash[GIT_OID_HEXSZ + 1];
+            git_oid_tostr(hash, sizeof(hash), &oid);
+            return hash;
+        }
+    }
+    return "";
+#else
+    return executeGitCommand("git rev-parse HEAD");
+#endif
 }
 
-int ragger_git_get_blame_info(const char* filePath, void** blameInfo, size_t* count) {
-    if (!g_state || !filePath || !blameInfo || !count) {
-        return RAGGER_ERROR_INVALID_ARGUMENT;
+// Run blame for one file; returns RAGGER_SUCCESS and fills one entry per line
+static int collectBlameData(const std::string& filePath, std::vector<GitBlameInfo>& blameData) {
+#ifdef RAGGER_HAVE_LIBGIT2
+    git_repository* repo = openRepository();
+    if (!repo) {
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+
+    std::string relativePath = repositoryRelativePath(filePath);
+    git_blame* blame = nullptr;
+    git_blame_options options = GIT_BLAME_OPTIONS_INIT;
+    if (git_blame_file(&blame, repo, relativePath.c_str(), &options) != 0) {
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+
+    // Line contents come from the working copy; blame metadata from libgit2
+    std::vector<std::string> fileLines;
+    {
+        std::ifstream file(filePath);
+        std::string line;
+        while (std::getline(file, line)) {
+            fileLines.push_back(line);
+        }
+    }
+
+    for (size_t i = 0; i < fileLines.size(); ++i) {
+        const git_blame_hunk* hunk = git_blame_get_hunk_byline(blame, i + 1);
+        if (!hunk) {
+            continue;
+        }
+
+        GitBlameInfo info;
+        char hash[GIT_OID_HEXSZ + 1];
+        git_oid_tostr(hash, sizeof(hash), &hunk->final_commit_id);
+        info.commitHash = hash;
+        info.lineNumber = static_cast<int>(i + 1);
+        info.lineContent = fileLines[i];
+
+        git_commit* commit = nullptr;
+        if (git_commit_lookup(&commit, repo, &hunk->final_commit_id) == 0) {
+            if (const git_signature* author = git_commit_author(commit)) {
+                info.author = author->name ? author->name : "";
+                info.authorEmail = author->email ? author->email : "";
+                info.date = std::to_string(author->when.time);
+            }
+            if (const char* summary = git_commit_summary(commit)) {
+                info.commitMessage = summary;
+            }
+            git_commit_free(commit);
+        } else if (hunk->final_signature) {
+            info.author = hunk->final_signature->name ? hunk->final_signature->name : "";
+            info.authorEmail = hunk->final_signature->email ? hunk->final_signature->email : "";
+            info.date = std::to_string(hunk->final_signature->when.time);
+        }
+
+        blameData.push_back(info);
     }
 
-    // Get blame information using git blame
-    std::string blameOutput = executeGitCommand("git blame -p " + std::string(filePath));
+    git_blame_free(blame);
+    return RAGGER_SUCCESS;
+#else
+    // Fallback: parse `git blame -p` porcelain output
+    std::string blameOutput = executeGitCommand("git blame -p " + filePath);
     if (blameOutput.empty()) {
-        *count = 0;
-        *blameInfo = nullptr;
         return RAGGER_ERROR_FILE_NOT_FOUND;
     }
 
-    std::vector<GitBlameInfo> blameData;
     std::vector<std::string> lines = splitLines(blameOutput);
-    
+
     std::string currentCommit;
     std::string currentAuthor;
     std::string currentEmail;
     std::string currentDate;
     std::string currentMessage;
-    
+
     for (const auto& line : lines) {
         if (line.empty()) continue;
-        
+
         if (line[0] == '\t') {
             // This is the actual line content
             std::string content = line.substr(1);
@@ -215,16 +360,17 @@ int ragger_git_get_blame_info(const char* filePath, void** blameInfo, size_t* co
                 info.authorEmail = currentEmail;
                 info.date = currentDate;
                 info.commitMessage = currentMessage;
+                info.lineNumber = static_cast<int>(blameData.size()) + 1;
                 info.lineContent = content;
                 blameData.push_back(info);
             }
-        } else if (line.substr(0, 8) == "author ") {
-            currentAuthor = line.substr(8);
-        } else if (line.substr(0, 13) == "author-mail ") {
-            currentEmail = line.substr(13);
-        } else if (line.substr(0, 13) == "author-time ") {
-            currentDate = line.substr(13);
-        } else if (line.substr(0, 7) == "summary") {
+        } else if (line.substr(0, 7) == "author ") {
+            currentAuthor = line.substr(7);
+        } else if (line.substr(0, 12) == "author-mail ") {
+            currentEmail = line.substr(12);
+        } else if (line.substr(0, 12) == "author-time ") {
+            currentDate = line.substr(12);
+        } else if (line.substr(0, 8) == "summary ") {
             currentMessage = line.substr(8);
         } else if (line.length() >= 40 && line.find(' ') != std::string::npos) {
             // This is a commit hash and line info
@@ -232,16 +378,105 @@ int ragger_git_get_blame_info(const char* filePath, void** blameInfo, size_t* co
         }
     }
 
+    return RAGGER_SUCCESS;
+#endif
+}
+
+// Git-specific functions
+bool ragger_git_is_repository(const char* path) {
+    if (!g_state || !path) {
+        return false;
+    }
+    
+    std::string gitDir = std::string(path) + "/.git";
+    return std::filesystem::exists(gitDir) || std::filesystem::exists(gitDir + "/HEAD");
+}
+
+int ragger_git_get_repository_root(const char* path, char** rootPath) {
+    if (!g_state || !path || !rootPath) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+
+#ifdef RAGGER_HAVE_LIBGIT2
+    git_repository* repo = nullptr;
+    if (git_repository_open_ext(&repo, path, 0, nullptr) != 0) {
+        *rootPath = nullptr;
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+
+    std::string result;
+    if (const char* workdir = git_repository_workdir(repo)) {
+        result = workdir;
+        if (!result.empty() && result.back() == '/') {
+            result.pop_back();
+        }
+    }
+
+    if (result.empty()) {
+        git_repository_free(repo);
+        *rootPath = nullptr;
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+
+    // Keep the opened repository for subsequent blame/history calls
+    if (g_state->repository) {
+        git_repository_free(repo);
+    } else {
+        g_state->repository = repo;
+    }
+#else
+    std::string result = executeGitCommand("git rev-parse --show-toplevel", std::string(path));
+    if (result.empty()) {
+        *rootPath = nullptr;
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+#endif
+
+    *rootPath = new char[result.length() + 1];
+    strcpy(*rootPath, result.c_str());
+    g_state->repositoryRoot = result;
+    return RAGGER_SUCCESS;
+}
+
+void ragger_git_free_string(char* str) {
+    delete[] str;
+}
+
+int ragger_git_get_blame_info(const char* filePath, void** blameInfo, size_t* count) {
+    if (!g_state || !filePath || !blameInfo || !count) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+
+    *count = 0;
+    *blameInfo = nullptr;
+
+    std::string path(filePath);
+    std::string head = currentHeadCommit();
+
+    std::lock_guard<std::mutex> lock(g_state->blameMutex);
+
+    // Repeated requests against an unchanged HEAD are memory lookups
+    auto cached = g_state->blameCache.find(path);
+    if (cached == g_state->blameCache.end() || head.empty() || cached->second.headCommit != head) {
+        CachedBlame entry;
+        entry.headCommit = head;
+        int result = collectBlameData(path, entry.lines);
+        if (result != RAGGER_SUCCESS) {
+            g_state->blameCache.erase(path);
+            return result;
+        }
+        cached = g_state->blameCache.insert_or_assign(path, std::move(entry)).first;
+    }
+
+    const std::vector<GitBlameInfo>& blameData = cached->second.lines;
     *count = blameData.size();
     if (*count > 0) {
         *blameInfo = new GitBlameInfo[*count];
         for (size_t i = 0; i < *count; ++i) {
             static_cast<GitBlameInfo*>(*blameInfo)[i] = blameData[i];
         }
-    } else {
-        *blameInfo = nullptr;
     }
-    
+
     return RAGGER_SUCCESS;
 }
 
@@ -256,14 +491,97 @@ int ragger_git_get_commit_history(const char* filePath, int maxCommits, void** c
         return RAGGER_ERROR_INVALID_ARGUMENT;
     }
 
-    // TODO: Implement commit history retrieval
     *count = 0;
     *commits = nullptr;
+
+#ifdef RAGGER_HAVE_LIBGIT2
+    git_repository* repo = openRepository();
+    if (!repo) {
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+
+    git_revwalk* walker = nullptr;
+    if (git_revwalk_new(&walker, repo) != 0 || git_revwalk_push_head(walker) != 0) {
+        if (walker) git_revwalk_free(walker);
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+    git_revwalk_sorting(walker, GIT_SORT_TIME);
+
+    std::string relativePath = repositoryRelativePath(filePath);
+    std::vector<GitCommitInfo> history;
+    git_oid oid;
+    while (git_revwalk_next(&oid, walker) == 0 &&
+           history.size() < static_cast<size_t>(maxCommits > 0 ? maxCommits : 10)) {
+        git_commit* commit = nullptr;
+        if (git_commit_lookup(&commit, repo, &oid) != 0) {
+            continue;
+        }
+
+        // Only keep commits that touch the requested file
+        bool touchesFile = false;
+        git_tree* tree = nullptr;
+        git_tree* parentTree = nullptr;
+        if (git_commit_tree(&tree, commit) == 0) {
+            if (git_commit_parentcount(commit) > 0) {
+                git_commit* parent = nullptr;
+                if (git_commit_parent(&parent, commit, 0) == 0) {
+                    git_commit_tree(&parentTree, parent);
+                    git_commit_free(parent);
+                }
+            }
+            git_diff* diff = nullptr;
+            if (git_diff_tree_to_tree(&diff, repo, parentTree, tree, nullptr) == 0) {
+                size_t deltas = git_diff_num_deltas(diff);
+                for (size_t i = 0; i < deltas; ++i) {
+                    const git_diff_delta* delta = git_diff_get_delta(diff, i);
+                    if (delta && delta->new_file.path && relativePath == delta->new_file.path) {
+                        touchesFile = true;
+                        break;
+                    }
+                }
+                git_diff_free(diff);
+            }
+            if (parentTree) git_tree_free(parentTree);
+            git_tree_free(tree);
+        }
+
+        if (touchesFile) {
+            GitCommitInfo info;
+            char hash[GIT_OID_HEXSZ + 1];
+            git_oid_tostr(hash, sizeof(hash), &oid);
+            info.hash = hash;
+            if (const git_signature* author = git_commit_author(commit)) {
+                info.author = author->name ? author->name : "";
+                info.authorEmail = author->email ? author->email : "";
+                info.date = std::to_string(author->when.time);
+            }
+            if (const char* message = git_commit_message(commit)) {
+                info.message = message;
+            }
+            history.push_back(info);
+        }
+        git_commit_free(commit);
+    }
+    git_revwalk_free(walker);
+
+    *count = history.size();
+    if (*count > 0) {
+        *commits = new GitCommitInfo[*count];
+        for (size_t i = 0; i < *count; ++i) {
+            static_cast<GitCommitInfo*>(*commits)[i] = history[i];
+        }
+    }
     return RAGGER_SUCCESS;
+#else
+    // TODO: Implement commit history retrieval without libgit2
+    return RAGGER_SUCCESS;
+#endif
 }
 
 void ragger_git_free_commit_info(void* commits, size_t count) {
-    // TODO: Implement proper cleanup
+    if (commits) {
+        delete[] static_cast<GitCommitInfo*>(commits);
+    }
 }
 
 int ragger_git_get_current_branch(char** branchName) {
@@ -271,9 +589,37 @@ int ragger_git_get_current_branch(char** branchName) {
         return RAGGER_ERROR_INVALID_ARGUMENT;
     }
 
-    // TODO: Implement current branch detection
-    *branchName = nullptr;
+#ifdef RAGGER_HAVE_LIBGIT2
+    git_repository* repo = openRepository();
+    if (!repo) {
+        *branchName = nullptr;
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+
+    git_reference* head = nullptr;
+    if (git_repository_head(&head, repo) != 0) {
+        *branchName = nullptr;
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+
+    const char* shorthand = git_reference_shorthand(head);
+    std::string name = shorthand ? shorthand : "";
+    git_reference_free(head);
+
+    *branchName = new char[name.length() + 1];
+    strcpy(*branchName, name.c_str());
+    return RAGGER_SUCCESS;
+#else
+    std::string name = executeGitCommand("git rev-parse --abbrev-ref HEAD");
+    if (name.empty()) {
+        *branchName = nullptr;
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+
+    *branchName = new char[name.length() + 1];
+    strcpy(*branchName, name.c_str());
     return RAGGER_SUCCESS;
+#endif
 }
 
 int ragger_git_get_branches(char*** branches, size_t* count) {
@@ -292,7 +638,29 @@ void ragger_git_free_branches(char** branches, size_t count) {
 }
 
 bool ragger_git_has_uncommitted_changes() {
-    return g_state ? false : false; // TODO: Implement change detection
+    if (!g_state) {
+        return false;
+    }
+
+#ifdef RAGGER_HAVE_LIBGIT2
+    git_repository* repo = openRepository();
+    if (!repo) {
+        return false;
+    }
+
+    git_status_list* status = nullptr;
+    git_status_options options = GIT_STATUS_OPTIONS_INIT;
+    options.show = GIT_STATUS_SHOW_INDEX_AND_WORKDIR;
+    if (git_status_list_new(&status, repo, &options) != 0) {
+        return false;
+    }
+
+    bool dirty = git_status_list_entrycount(status) > 0;
+    git_status_list_free(status);
+    return dirty;
+#else
+    return !executeGitCommand("git status --porcelain").empty();
+#endif
 }
 
 int ragger_git_get_modified_files(char*** files, size_t* count) {
@@ -300,9 +668,55 @@ int ragger_git_get_modified_files(char*** files, size_t* count) {
         return RAGGER_ERROR_INVALID_ARGUMENT;
     }
 
-    // TODO: Implement modified files detection
     *count = 0;
     *files = nullptr;
+
+#ifdef RAGGER_HAVE_LIBGIT2
+    git_repository* repo = openRepository();
+    if (!repo) {
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+
+    git_status_list* status = nullptr;
+    git_status_options options = GIT_STATUS_OPTIONS_INIT;
+    options.show = GIT_STATUS_SHOW_INDEX_AND_WORKDIR;
+    if (git_status_list_new(&status, repo, &options) != 0) {
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+
+    std::vector<std::string> modified;
+    size_t entries = git_status_list_entrycount(status);
+    for (size_t i = 0; i < entries; ++i) {
+        const git_status_entry* entry = git_status_byindex(status, i);
+        if (!entry) continue;
+        const char* path = nullptr;
+        if (entry->index_to_workdir && entry->index_to_workdir->new_file.path) {
+            path = entry->index_to_workdir->new_file.path;
+        } else if (entry->head_to_index && entry->head_to_index->new_file.path) {
+            path = entry->head_to_index->new_file.path;
+        }
+        if (path) {
+            modified.push_back(path);
+        }
+    }
+    git_status_list_free(status);
+#else
+    std::vector<std::string> modified;
+    for (const auto& line : splitLines(executeGitCommand("git status --porcelain"))) {
+        if (line.length() > 3) {
+            modified.push_back(line.substr(3));
+        }
+    }
+#endif
+
+    *count = modified.size();
+    if (*count > 0) {
+        *files = new char*[*count];
+        for (size_t i = 0; i < *count; ++i) {
+            (*files)[i] = new char[modified[i].length() + 1];
+            strcpy((*files)[i], modified[i].c_str());
+        }
+    }
     return RAGGER_SUCCESS;
 }
 
@@ -369,61 +783,293 @@ ProjectStandards analyzeProjectStandards(const std::string& filePath) {
 }
 
 // Pillar 3: Documentation Integration
-std::vector<DocumentationInfo> findRelevantDocumentation(const std::string& query, const std::string& filePath) {
-    std::vector<DocumentationInfo> docs;
-    
-    // Search in common documentation files
+//
+// The documentation corpus is persisted to .ragger/doc_cache.bin in an
+// mmap-friendly layout: a fixed header, one record per file (path, content
+// hash, size, mtime and blob offsets), then a single content blob holding
+// path bytes, a 500-character excerpt and the lowercased full text. Loading
+// is a single mmap; entries are invalidated per file by content hash.
+
+struct DocCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t entryCount;
+};
+
+struct DocCacheRecord {
+    uint64_t pathOffset;
+    uint64_t pathLength;
+    uint64_t contentHash;
+    uint64_t fileSize;
+    int64_t mtime;
+    uint64_t excerptOffset;
+    uint64_t excerptLength;
+    uint64_t loweredOffset;
+    uint64_t loweredLength;
+};
+
+static const uint32_t DOC_CACHE_VERSION = 1;
+static const char DOC_CACHE_MAGIC[4] = {'R', 'G', 'D', 'C'};
+static const size_t DOC_EXCERPT_LENGTH = 500;
+
+static uint64_t docContentHash(const std::string& content) {
+    // FNV-1a
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char c : content) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static std::string docCachePath() {
+    return g_state->repositoryRoot + "/.ragger/doc_cache.bin";
+}
+
+struct DocFileStat {
+    std::string path;
+    uint64_t size;
+    int64_t mtime;
+};
+
+// Enumerate the documentation corpus (same locations the scan always used)
+static std::vector<DocFileStat> collectDocumentationFiles() {
+    std::vector<DocFileStat> files;
     std::vector<std::string> docFiles = {
         "README.md", "CONTRIBUTING.md", "docs/", "doc/"
     };
-    
+
+    auto addFile = [&files](const std::filesystem::path& path) {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(path, ec);
+        if (ec) return;
+        auto mtime = std::filesystem::last_write_time(path, ec);
+        if (ec) return;
+        DocFileStat stat;
+        stat.path = path.string();
+        stat.size = static_cast<uint64_t>(size);
+        stat.mtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+        files.push_back(stat);
+    };
+
     for (const auto& docFile : docFiles) {
         std::string fullPath = g_state->repositoryRoot + "/" + docFile;
-        if (std::filesystem::exists(fullPath)) {
-            if (std::filesystem::is_directory(fullPath)) {
-                // Search all files in directory
-                for (const auto& entry : std::filesystem::recursive_directory_iterator(fullPath)) {
-                    if (entry.is_regular_file() && 
-                        (entry.path().extension() == ".md" || entry.path().extension() == ".txt")) {
-                        std::ifstream file(entry.path());
-                        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-                        
-                        // Simple keyword matching
-                        std::string lowerContent = content;
-                        std::string lowerQuery = query;
-                        std::transform(lowerContent.begin(), lowerContent.end(), lowerContent.begin(), ::tolower);
-                        std::transform(lowerQuery.begin(), lowerQuery.end(), lowerQuery.begin(), ::tolower);
-                        
-                        if (lowerContent.find(lowerQuery) != std::string::npos) {
-                            DocumentationInfo info;
-                            info.sourceFile = entry.path().string();
-                            info.content = content.substr(0, 500); // First 500 chars
-                            info.relevance = "High";
-                            docs.push_back(info);
-                        }
-                    }
-                }
-            } else {
-                // Single file
-                std::ifstream file(fullPath);
-                std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-                
-                std::string lowerContent = content;
-                std::string lowerQuery = query;
-                std::transform(lowerContent.begin(), lowerContent.end(), lowerContent.begin(), ::tolower);
-                std::transform(lowerQuery.begin(), lowerQuery.end(), lowerQuery.begin(), ::tolower);
-                
-                if (lowerContent.find(lowerQuery) != std::string::npos) {
-                    DocumentationInfo info;
-                    info.sourceFile = fullPath;
-                    info.content = content.substr(0, 500);
-                    info.relevance = "High";
-                    docs.push_back(info);
+        if (!std::filesystem::exists(fullPath)) continue;
+
+        if (std::filesystem::is_directory(fullPath)) {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(fullPath)) {
+                if (entry.is_regular_file() &&
+                    (entry.path().extension() == ".md" || entry.path().extension() == ".txt")) {
+                    addFile(entry.path());
                 }
             }
+        } else {
+            addFile(fullPath);
         }
     }
-    
+
+    std::sort(files.begin(), files.end(),
+              [](const DocFileStat& a, const DocFileStat& b) { return a.path < b.path; });
+    return files;
+}
+
+static std::string readFileContent(const std::string& path) {
+    std::ifstream file(path);
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+static void unmapDocCache() {
+    if (g_state->docMapping) {
+        munmap(g_state->docMapping, g_state->docMappingSize);
+        g_state->docMapping = nullptr;
+        g_state->docMappingSize = 0;
+    }
+    g_state->docViews.clear();
+    g_state->docFallbackBlob.clear();
+}
+
+// Map the cache file and populate docViews if it matches the current corpus.
+// A size/mtime match accepts an entry cheaply; on mismatch the file content
+// is re-hashed so touched-but-unchanged files do not force a rebuild.
+static bool tryLoadMappedDocCache(const std::vector<DocFileStat>& files) {
+    int fd = open(docCachePath().c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(DocCacheHeader)) {
+        close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const char* base = static_cast<const char*>(mapping);
+    const DocCacheHeader* header = reinterpret_cast<const DocCacheHeader*>(base);
+    if (memcmp(header->magic, DOC_CACHE_MAGIC, 4) != 0 ||
+        header->version != DOC_CACHE_VERSION ||
+        header->entryCount != files.size() ||
+        sizeof(DocCacheHeader) + header->entryCount * sizeof(DocCacheRecord) > size) {
+        munmap(mapping, size);
+        return false;
+    }
+
+    const DocCacheRecord* records =
+        reinterpret_cast<const DocCacheRecord*>(base + sizeof(DocCacheHeader));
+
+    std::vector<DocCacheView> views;
+    for (size_t i = 0; i < files.size(); ++i) {
+        const DocCacheRecord& record = records[i];
+        if (record.pathOffset + record.pathLength > size ||
+            record.excerptOffset + record.excerptLength > size ||
+            record.loweredOffset + record.loweredLength > size) {
+            munmap(mapping, size);
+            return false;
+        }
+
+        std::string recordPath(base + record.pathOffset, record.pathLength);
+        if (recordPath != files[i].path) {
+            munmap(mapping, size);
+            return false;
+        }
+
+        if (record.fileSize != files[i].size || record.mtime != files[i].mtime) {
+            // Per-file invalidation: only a content hash mismatch rejects
+            if (docContentHash(readFileContent(files[i].path)) != record.contentHash) {
+                munmap(mapping, size);
+                return false;
+            }
+        }
+
+        DocCacheView view;
+        view.path = std::move(recordPath);
+        view.excerpt = std::string_view(base + record.excerptOffset, record.excerptLength);
+        view.loweredContent = std::string_view(base + record.loweredOffset, record.loweredLength);
+        views.push_back(std::move(view));
+    }
+
+    unmapDocCache();
+    g_state->docMapping = mapping;
+    g_state->docMappingSize = size;
+    g_state->docViews = std::move(views);
+    return true;
+}
+
+// Rescan the corpus and rewrite the cache file (atomically, via rename).
+// If the file cannot be written the views fall back to an in-memory blob.
+static void rebuildDocCache(const std::vector<DocFileStat>& files) {
+    std::vector<DocCacheRecord> records(files.size());
+    std::string blob;
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        std::string content = readFileContent(files[i].path);
+        std::string lowered = content;
+        std::transform(lowered.begin(), lowered.end(), lowered.begin(), ::tolower);
+        std::string excerpt = content.substr(0, DOC_EXCERPT_LENGTH);
+
+        DocCacheRecord& record = records[i];
+        record.contentHash = docContentHash(content);
+        record.fileSize = files[i].size;
+        record.mtime = files[i].mtime;
+        record.pathOffset = blob.size();
+        record.pathLength = files[i].path.size();
+        blob += files[i].path;
+        record.excerptOffset = blob.size();
+        record.excerptLength = excerpt.size();
+        blob += excerpt;
+        record.loweredOffset = blob.size();
+        record.loweredLength = lowered.size();
+        blob += lowered;
+    }
+
+    // Blob offsets are relative to the start of the file
+    size_t blobStart = sizeof(DocCacheHeader) + records.size() * sizeof(DocCacheRecord);
+    for (auto& record : records) {
+        record.pathOffset += blobStart;
+        record.excerptOffset += blobStart;
+        record.loweredOffset += blobStart;
+    }
+
+    DocCacheHeader header;
+    memcpy(header.magic, DOC_CACHE_MAGIC, 4);
+    header.version = DOC_CACHE_VERSION;
+    header.entryCount = records.size();
+
+    std::string cacheFile = docCachePath();
+    std::string tempFile = cacheFile + ".tmp";
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(cacheFile).parent_path(), ec);
+
+    bool written = false;
+    {
+        std::ofstream out(tempFile, std::ios::binary | std::ios::trunc);
+        if (out) {
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(records.data()),
+                      records.size() * sizeof(DocCacheRecord));
+            out.write(blob.data(), blob.size());
+            written = out.good();
+        }
+    }
+    if (written) {
+        std::filesystem::rename(tempFile, cacheFile, ec);
+        written = !ec;
+    }
+
+    if (written && tryLoadMappedDocCache(files)) {
+        return;
+    }
+
+    // Could not persist (read-only checkout, etc.) — serve from memory
+    unmapDocCache();
+    g_state->docFallbackBlob = std::move(blob);
+    const char* base = g_state->docFallbackBlob.data();
+    for (const auto& record : records) {
+        DocCacheView view;
+        view.path = std::string(base + record.pathOffset - blobStart, record.pathLength);
+        view.excerpt = std::string_view(base + record.excerptOffset - blobStart, record.excerptLength);
+        view.loweredContent = std::string_view(base + record.loweredOffset - blobStart, record.loweredLength);
+        g_state->docViews.push_back(std::move(view));
+    }
+}
+
+static void ensureDocumentationCache() {
+    if (g_state->docCacheLoaded) {
+        return;
+    }
+
+    std::vector<DocFileStat> files = collectDocumentationFiles();
+    if (!tryLoadMappedDocCache(files)) {
+        rebuildDocCache(files);
+    }
+    g_state->docCacheLoaded = true;
+}
+
+std::vector<DocumentationInfo> findRelevantDocumentation(const std::string& query, const std::string& filePath) {
+    std::vector<DocumentationInfo> docs;
+
+    std::lock_guard<std::mutex> lock(g_state->docMutex);
+    ensureDocumentationCache();
+
+    std::string lowerQuery = query;
+    std::transform(lowerQuery.begin(), lowerQuery.end(), lowerQuery.begin(), ::tolower);
+
+    for (const auto& view : g_state->docViews) {
+        if (view.loweredContent.find(lowerQuery) != std::string_view::npos) {
+            DocumentationInfo info;
+            info.sourceFile = view.path;
+            info.content = std::string(view.excerpt);
+            info.relevance = "High";
+            docs.push_back(info);
+        }
+    }
+
     return docs;
 }
 
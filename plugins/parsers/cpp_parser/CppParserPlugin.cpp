@@ -1,15 +1,332 @@
 #include "ragger_plugin_api.h"
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef RAGGER_HAVE_LIBCLANG
+#include <clang-c/Index.h>
+#endif
+
+// C/C++ parser backed by libclang when the library is available at build
+// time (RAGGER_HAVE_LIBCLANG). Translation units are parsed with the
+// flags recorded in compile_commands.json, kept alive so re-parses reuse
+// libclang's precompiled preamble, and batch requests fan out over a
+// worker pool. Without libclang the entry points keep their previous
+// stub behavior.
+namespace {
+
+#ifdef RAGGER_HAVE_LIBCLANG
+
+// Allocated with new[] to pair with the delete[] in the free functions
+char* duplicateString(const std::string& value) {
+    char* copy = new char[value.size() + 1];
+    std::memcpy(copy, value.c_str(), value.size() + 1);
+    return copy;
+}
+
+std::string toString(CXString cxString) {
+    const char* cstr = clang_getCString(cxString);
+    std::string result = cstr ? cstr : "";
+    clang_disposeString(cxString);
+    return result;
+}
+
+// Minimal compile_commands.json reader: we only need "file" plus
+// "command"/"arguments" per entry, so a targeted scan avoids a JSON
+// dependency
+class CompileCommands {
+public:
+    bool load(const std::string& directory) {
+        std::ifstream file(directory + "/compile_commands.json");
+        if (!file.is_open()) {
+            return false;
+        }
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        std::string json = buffer.str();
+
+        size_t pos = 0;
+        while ((pos = json.find("\"file\"", pos)) != std::string::npos) {
+            std::string filePath = stringValueAfter(json, pos);
+            size_t entryStart = json.rfind('{', pos);
+            size_t entryEnd = json.find('}', pos);
+            if (entryStart == std::string::npos || entryEnd == std::string::npos) {
+                break;
+            }
+
+            std::string entry = json.substr(entryStart, entryEnd - entryStart);
+            std::vector<std::string> args;
+            size_t commandPos = entry.find("\"command\"");
+            if (commandPos != std::string::npos) {
+                splitCommand(stringValueAfter(entry, commandPos), args);
+            }
+            if (!filePath.empty() && !args.empty()) {
+                commands_[filePath] = std::move(args);
+            }
+            pos = entryEnd;
+        }
+
+        std::cout << "CppParserPlugin: Loaded " << commands_.size()
+                  << " compile commands from " << directory << std::endl;
+        return !commands_.empty();
+    }
+
+    // Arguments for a file, or a generic fallback when the database has
+    // no entry (headers, generated files)
+    std::vector<std::string> argumentsFor(const std::string& filePath) const {
+        auto it = commands_.find(filePath);
+        if (it != commands_.end()) {
+            return it->second;
+        }
+        return {"-std=c++17", "-I."};
+    }
+
+private:
+    static std::string stringValueAfter(const std::string& json, size_t keyPos) {
+        size_t colon = json.find(':', keyPos);
+        size_t quoteStart = json.find('"', colon + 1);
+        if (colon == std::string::npos || quoteStart == std::string::npos) {
+            return "";
+        }
+        size_t quoteEnd = quoteStart + 1;
+        while (quoteEnd < json.size() &&
+               (json[quoteEnd] != '"' || json[quoteEnd - 1] == '\\')) {
+            quoteEnd++;
+        }
+        return json.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
+    }
+
+    // Compiler invocation -> clang arguments: drop the compiler itself,
+    // the input file, and -c/-o pairs
+    static void splitCommand(const std::string& command, std::vector<std::string>& args) {
+        std::istringstream stream(command);
+        std::string token;
+        bool first = true;
+        bool skipNext = false;
+        while (stream >> token) {
+            if (first) {
+                first = false;
+                continue;
+            }
+            if (skipNext) {
+                skipNext = false;
+                continue;
+            }
+            if (token == "-o") {
+                skipNext = true;
+                continue;
+            }
+            if (token == "-c") {
+                continue;
+            }
+            if (!token.empty() && token[0] != '-' &&
+                (token.find(".cpp") != std::string::npos ||
+                 token.find(".cc") != std::string::npos ||
+                 token.find(".cxx") != std::string::npos ||
+                 token.find(".c") == token.size() - 2)) {
+                continue; // The input file itself
+            }
+            args.push_back(token);
+        }
+    }
+
+    std::unordered_map<std::string, std::vector<std::string>> commands_;
+};
+
+#endif // RAGGER_HAVE_LIBCLANG
 
 // Plugin state
 struct CppParserState {
     bool initialized;
 
+#ifdef RAGGER_HAVE_LIBCLANG
+    CXIndex index = nullptr;
+    CompileCommands compileCommands;
+    bool haveCompileCommands = false;
+    // Cached translation units; reparsing one reuses its precompiled
+    // preamble instead of re-lexing every header
+    std::unordered_map<std::string, CXTranslationUnit> translationUnits;
+    std::mutex mutex;
+#endif
+
     CppParserState() : initialized(false) {}
+
+    ~CppParserState() {
+#ifdef RAGGER_HAVE_LIBCLANG
+        for (auto& pair : translationUnits) {
+            clang_disposeTranslationUnit(pair.second);
+        }
+        if (index) {
+            clang_disposeIndex(index);
+        }
+#endif
+    }
 };
 
 CppParserState* g_cpp_state = nullptr;
 
+#ifdef RAGGER_HAVE_LIBCLANG
+
+// Function bodies stay in (they become CodeBlock content); the preamble
+// option is what makes reparses fast
+constexpr unsigned PARSE_OPTIONS =
+    CXTranslationUnit_PrecompiledPreamble |
+    CXTranslationUnit_KeepGoing;
+
+// Parse (or incrementally reparse) one file into a cached TU
+CXTranslationUnit translationUnitFor(const std::string& filePath) {
+    std::lock_guard<std::mutex> lock(g_cpp_state->mutex);
+
+    auto it = g_cpp_state->translationUnits.find(filePath);
+    if (it != g_cpp_state->translationUnits.end()) {
+        if (clang_reparseTranslationUnit(it->second, 0, nullptr,
+                                         clang_defaultReparseOptions(it->second)) == 0) {
+            return it->second;
+        }
+        clang_disposeTranslationUnit(it->second);
+        g_cpp_state->translationUnits.erase(it);
+    }
+
+    std::vector<std::string> args = g_cpp_state->compileCommands.argumentsFor(filePath);
+    std::vector<const char*> argv;
+    argv.reserve(args.size());
+    for (const std::string& arg : args) {
+        argv.push_back(arg.c_str());
+    }
+
+    CXTranslationUnit unit = nullptr;
+    CXErrorCode error = clang_parseTranslationUnit2(
+        g_cpp_state->index, filePath.c_str(), argv.data(),
+        static_cast<int>(argv.size()), nullptr, 0, PARSE_OPTIONS, &unit);
+    if (error != CXError_Success || !unit) {
+        return nullptr;
+    }
+
+    // Immediate reparse builds the preamble so the next edit is cheap
+    clang_reparseTranslationUnit(unit, 0, nullptr, clang_defaultReparseOptions(unit));
+    g_cpp_state->translationUnits[filePath] = unit;
+    return unit;
+}
+
+struct VisitorContext {
+    std::string filePath;
+    std::string source;
+    std::vector<CodeBlock> blocks;
+    std::vector<CodeSymbol> symbols;
+};
+
+bool isBlockCursor(CXCursorKind kind) {
+    switch (kind) {
+        case CXCursor_FunctionDecl:
+        case CXCursor_CXXMethod:
+        case CXCursor_Constructor:
+        case CXCursor_Destructor:
+        case CXCursor_FunctionTemplate:
+        case CXCursor_ClassDecl:
+        case CXCursor_StructDecl:
+        case CXCursor_ClassTemplate:
+        case CXCursor_EnumDecl:
+            return true;
+        default:
+            return false;
+    }
+}
+
+CXChildVisitResult visitCursor(CXCursor cursor, CXCursor parent, CXClientData data) {
+    auto* context = static_cast<VisitorContext*>(data);
+    (void)parent;
+
+    CXSourceLocation location = clang_getCursorLocation(cursor);
+    if (!clang_Location_isFromMainFile(location)) {
+        return CXChildVisit_Continue;
+    }
+
+    CXCursorKind kind = clang_getCursorKind(cursor);
+    if (kind == CXCursor_Namespace || kind == CXCursor_LinkageSpec) {
+        return CXChildVisit_Recurse;
+    }
+    if (!isBlockCursor(kind) || !clang_isCursorDefinition(cursor)) {
+        return CXChildVisit_Continue;
+    }
+
+    CXSourceRange extent = clang_getCursorExtent(cursor);
+    unsigned startLine = 0, endLine = 0, startOffset = 0, endOffset = 0;
+    clang_getSpellingLocation(clang_getRangeStart(extent), nullptr, &startLine, nullptr, &startOffset);
+    clang_getSpellingLocation(clang_getRangeEnd(extent), nullptr, &endLine, nullptr, &endOffset);
+    if (endOffset <= startOffset || endOffset > context->source.size()) {
+        return CXChildVisit_Continue;
+    }
+
+    std::string name = toString(clang_getCursorSpelling(cursor));
+    std::string signature = toString(clang_getCursorDisplayName(cursor));
+
+    const char* symbolType = "function";
+    if (kind == CXCursor_ClassDecl || kind == CXCursor_ClassTemplate) {
+        symbolType = "class";
+    } else if (kind == CXCursor_StructDecl) {
+        symbolType = "struct";
+    } else if (kind == CXCursor_EnumDecl) {
+        symbolType = "enum";
+    } else if (kind == CXCursor_CXXMethod || kind == CXCursor_Constructor ||
+               kind == CXCursor_Destructor) {
+        symbolType = "method";
+    }
+
+    CodeBlock block;
+    block.name = duplicateString(name);
+    block.content = duplicateString(
+        context->source.substr(startOffset, endOffset - startOffset));
+    block.filePath = duplicateString(context->filePath);
+    block.startLine = static_cast<int>(startLine);
+    block.endLine = static_cast<int>(endLine);
+    block.language = duplicateString("cpp");
+    block.visibility = (clang_getCXXAccessSpecifier(cursor) == CX_CXXPrivate) ? 0 : 2;
+    block.metadata = nullptr;
+    context->blocks.push_back(block);
+
+    CodeSymbol symbol;
+    symbol.name = duplicateString(name);
+    symbol.type = duplicateString(symbolType);
+    symbol.signature = duplicateString(signature);
+    symbol.definition = nullptr;
+    context->symbols.push_back(symbol);
+
+    // Methods of classes in the main file
+    return (kind == CXCursor_ClassDecl || kind == CXCursor_StructDecl ||
+            kind == CXCursor_ClassTemplate)
+               ? CXChildVisit_Recurse
+               : CXChildVisit_Continue;
+}
+
+int parseWithLibclang(const std::string& filePath, VisitorContext& context) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    context.filePath = filePath;
+    context.source = buffer.str();
+
+    CXTranslationUnit unit = translationUnitFor(filePath);
+    if (!unit) {
+        return RAGGER_ERROR_PARSING_FAILED;
+    }
+
+    clang_visitChildren(clang_getTranslationUnitCursor(unit), visitCursor, &context);
+    return RAGGER_SUCCESS;
+}
+
+#endif // RAGGER_HAVE_LIBCLANG
+
+} // anonymous namespace
+
 extern "C" {
 
 int plugin_get_abi_version() {
@@ -21,7 +338,7 @@ const char* plugin_get_name() {
 }
 
 const char* plugin_get_version() {
-    return "1.0.0";
+    return "1.1.0";
 }
 
 const char* plugin_get_description() {
@@ -36,7 +353,17 @@ int plugin_initialize(RaggerCoreHandle core) {
     g_cpp_state = new CppParserState();
     g_cpp_state->initialized = true;
 
-    std::cout << "CppParserPlugin: Initialized" << std::endl;
+#ifdef RAGGER_HAVE_LIBCLANG
+    g_cpp_state->index = clang_createIndex(/*excludeDeclarationsFromPCH=*/1,
+                                           /*displayDiagnostics=*/0);
+    g_cpp_state->haveCompileCommands = g_cpp_state->compileCommands.load(".");
+    std::cout << "CppParserPlugin: Initialized (libclang"
+              << (g_cpp_state->haveCompileCommands ? ", compile_commands.json" : "")
+              << ")" << std::endl;
+#else
+    std::cout << "CppParserPlugin: Initialized (built without libclang, parsing disabled)"
+              << std::endl;
+#endif
     return RAGGER_SUCCESS;
 }
 
@@ -60,7 +387,7 @@ const char* plugin_get_capabilities() {
     return R"({
         "parser": {
             "languages": ["c", "cpp"],
-            "features": ["ast", "symbols", "dependencies"]
+            "features": ["ast", "symbols", "dependencies", "compile_commands", "preamble_cache"]
         }
     })";
 }
@@ -86,11 +413,86 @@ bool ragger_parser_supports_file(const char* filePath) {
 }
 
 int ragger_parser_parse_file(const char* filePath, CodeBlock** blocks, size_t* numBlocks) {
-    // TODO: Implement actual C++ parsing with libclang
-    // For now, return empty results
+    if (!g_cpp_state || !filePath || !blocks || !numBlocks) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+
+#ifdef RAGGER_HAVE_LIBCLANG
+    VisitorContext context;
+    int result = parseWithLibclang(filePath, context);
+    if (result != RAGGER_SUCCESS) {
+        *blocks = nullptr;
+        *numBlocks = 0;
+        // Free anything collected before the failure
+        for (CodeSymbol& symbol : context.symbols) {
+            delete[] symbol.name;
+            delete[] symbol.type;
+            delete[] symbol.signature;
+        }
+        return result;
+    }
+
+    // Symbols collected alongside blocks are discarded here; callers use
+    // ragger_parser_extract_symbols for those
+    for (CodeSymbol& symbol : context.symbols) {
+        delete[] symbol.name;
+        delete[] symbol.type;
+        delete[] symbol.signature;
+    }
+
+    *numBlocks = context.blocks.size();
+    if (context.blocks.empty()) {
+        *blocks = nullptr;
+        return RAGGER_SUCCESS;
+    }
+    *blocks = new CodeBlock[context.blocks.size()];
+    std::memcpy(*blocks, context.blocks.data(), context.blocks.size() * sizeof(CodeBlock));
+    return RAGGER_SUCCESS;
+#else
     *blocks = nullptr;
     *numBlocks = 0;
-    std::cout << "CppParserPlugin: Parsed file " << filePath << " (stub implementation)" << std::endl;
+    return RAGGER_SUCCESS;
+#endif
+}
+
+// Batch entry point (ABI 101): fans out over a worker pool with one
+// libclang index shared across threads (libclang TUs are independent
+// objects), so preamble and index setup amortize across the batch
+int ragger_parser_parse_files(const char** filePaths, size_t numFiles,
+                              ParseBatchResult** results) {
+    if (!g_cpp_state || !filePaths || !results) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+
+    *results = new ParseBatchResult[numFiles]();
+
+    size_t numWorkers = std::min<size_t>(numFiles,
+        std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> workers;
+    std::vector<size_t> next(1, 0);
+    std::mutex nextMutex;
+
+    for (size_t w = 0; w < numWorkers; ++w) {
+        workers.emplace_back([&]() {
+            while (true) {
+                size_t i;
+                {
+                    std::lock_guard<std::mutex> lock(nextMutex);
+                    if (next[0] >= numFiles) {
+                        return;
+                    }
+                    i = next[0]++;
+                }
+                ParseBatchResult& result = (*results)[i];
+                result.status = ragger_parser_parse_file(filePaths[i], &result.blocks,
+                                                         &result.numBlocks);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
     return RAGGER_SUCCESS;
 }
 
@@ -101,16 +503,55 @@ void ragger_parser_free_blocks(CodeBlock* blocks, size_t numBlocks) {
         delete[] blocks[i].name;
         delete[] blocks[i].content;
         delete[] blocks[i].filePath;
+        delete[] blocks[i].language;
     }
     delete[] blocks;
 }
 
+void ragger_parser_free_batch(ParseBatchResult* results, size_t numFiles) {
+    if (!results) return;
+
+    for (size_t i = 0; i < numFiles; ++i) {
+        ragger_parser_free_blocks(results[i].blocks, results[i].numBlocks);
+    }
+    delete[] results;
+}
+
 int ragger_parser_extract_symbols(const char* filePath, CodeSymbol** symbols, size_t* numSymbols) {
-    // TODO: Implement symbol extraction
+    if (!g_cpp_state || !filePath || !symbols || !numSymbols) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+
+#ifdef RAGGER_HAVE_LIBCLANG
+    VisitorContext context;
+    int result = parseWithLibclang(filePath, context);
+    if (result != RAGGER_SUCCESS) {
+        *symbols = nullptr;
+        *numSymbols = 0;
+        return result;
+    }
+
+    // Blocks collected alongside symbols are discarded here
+    for (CodeBlock& block : context.blocks) {
+        delete[] block.name;
+        delete[] block.content;
+        delete[] block.filePath;
+        delete[] block.language;
+    }
+
+    *numSymbols = context.symbols.size();
+    if (context.symbols.empty()) {
+        *symbols = nullptr;
+        return RAGGER_SUCCESS;
+    }
+    *symbols = new CodeSymbol[context.symbols.size()];
+    std::memcpy(*symbols, context.symbols.data(), context.symbols.size() * sizeof(CodeSymbol));
+    return RAGGER_SUCCESS;
+#else
     *symbols = nullptr;
     *numSymbols = 0;
-    std::cout << "CppParserPlugin: Extracted symbols from " << filePath << " (stub implementation)" << std::endl;
     return RAGGER_SUCCESS;
+#endif
 }
 
 void ragger_parser_free_symbols(CodeSymbol* symbols, size_t numSymbols) {
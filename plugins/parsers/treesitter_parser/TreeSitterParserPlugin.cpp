@@ -1,11 +1,24 @@
 #include "ragger_plugin_api.h"
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <unordered_map>
 #include <vector>
-#include <string>
-#include <cstring>
 
-// Tree-sitter integration (simplified for now - would use actual tree-sitter library)
+#ifdef RAGGER_HAVE_TREE_SITTER
+#include <tree_sitter/api.h>
+#include <dlfcn.h>
+#endif
+
+// Tree-sitter integration. When the library is available at build time
+// (RAGGER_HAVE_TREE_SITTER) we parse real syntax trees with grammars
+// loaded from libtree-sitter-<lang>.so and reparse incrementally via
+// ts_tree_edit; otherwise a brace-scanning fallback extracts blocks so
+// the plugin stays useful on machines without tree-sitter installed.
+// Either way, a cached parse per file means a re-parse only returns the
+// CodeBlocks touched by the edit, not the whole file.
 namespace {
 
 // Language support mapping
@@ -16,16 +29,140 @@ struct LanguageInfo {
     bool supported;
 };
 
+// Allocated with new[] to pair with the delete[] in free_blocks
+char* duplicateString(const std::string& value) {
+    char* copy = new char[value.size() + 1];
+    std::memcpy(copy, value.c_str(), value.size() + 1);
+    return copy;
+}
+
+// Parser-internal block representation; converted to CodeBlock on return
+struct ExtractedBlock {
+    std::string name;
+    std::string content;
+    uint32_t startLine; // 1-based
+    uint32_t endLine;
+    size_t startByte;
+    size_t endByte;
+};
+
+// Byte range touched by an edit, computed by prefix/suffix comparison of
+// the old and new source
+struct EditRange {
+    size_t startByte;
+    size_t oldEndByte;
+    size_t newEndByte;
+    bool changed;
+};
+
+EditRange computeEditRange(const std::string& oldSource, const std::string& newSource) {
+    EditRange edit{0, 0, 0, false};
+    if (oldSource == newSource) {
+        return edit;
+    }
+
+    size_t prefix = 0;
+    size_t maxPrefix = std::min(oldSource.size(), newSource.size());
+    while (prefix < maxPrefix && oldSource[prefix] == newSource[prefix]) {
+        prefix++;
+    }
+
+    size_t suffix = 0;
+    size_t maxSuffix = std::min(oldSource.size(), newSource.size()) - prefix;
+    while (suffix < maxSuffix &&
+           oldSource[oldSource.size() - 1 - suffix] == newSource[newSource.size() - 1 - suffix]) {
+        suffix++;
+    }
+
+    edit.startByte = prefix;
+    edit.oldEndByte = oldSource.size() - suffix;
+    edit.newEndByte = newSource.size() - suffix;
+    edit.changed = true;
+    return edit;
+}
+
+#ifdef RAGGER_HAVE_TREE_SITTER
+
+TSPoint pointAt(const std::string& source, size_t byteOffset) {
+    TSPoint point{0, 0};
+    for (size_t i = 0; i < byteOffset && i < source.size(); ++i) {
+        if (source[i] == '\n') {
+            point.row++;
+            point.column = 0;
+        } else {
+            point.column++;
+        }
+    }
+    return point;
+}
+
+// Node types that become CodeBlocks, across the grammars we load
+bool isBlockNodeType(const char* type) {
+    static const char* const BLOCK_TYPES[] = {
+        "function_definition", "function_declaration", "function_item",
+        "method_definition", "method_declaration",
+        "class_specifier", "class_declaration", "class_definition",
+        "struct_specifier", "struct_item", "enum_specifier",
+        "impl_item", "trait_item", "interface_declaration",
+        "decorated_definition", "namespace_definition"
+    };
+    for (const char* blockType : BLOCK_TYPES) {
+        if (std::strcmp(type, blockType) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif // RAGGER_HAVE_TREE_SITTER
+
 class TreeSitterParser {
 private:
     std::unordered_map<std::string, LanguageInfo> languages_;
     bool initialized_;
 
+    struct FileState {
+        std::string source;
+        std::vector<ExtractedBlock> blocks;
+#ifdef RAGGER_HAVE_TREE_SITTER
+        TSTree* tree = nullptr;
+#endif
+    };
+
+    std::unordered_map<std::string, FileState> fileStates_;
+
+#ifdef RAGGER_HAVE_TREE_SITTER
+    TSParser* parser_;
+    std::unordered_map<std::string, const TSLanguage*> grammars_;
+    std::vector<void*> grammarHandles_;
+#endif
+
 public:
-    TreeSitterParser() : initialized_(false) {
+    TreeSitterParser()
+        : initialized_(false)
+#ifdef RAGGER_HAVE_TREE_SITTER
+        , parser_(ts_parser_new())
+#endif
+    {
         initializeLanguages();
     }
 
+    ~TreeSitterParser() {
+#ifdef RAGGER_HAVE_TREE_SITTER
+        for (auto& pair : fileStates_) {
+            if (pair.second.tree) {
+                ts_tree_delete(pair.second.tree);
+            }
+        }
+        if (parser_) {
+            ts_parser_delete(parser_);
+        }
+        for (void* handle : grammarHandles_) {
+            dlclose(handle);
+        }
+#endif
+    }
+
     void initializeLanguages() {
         // Initialize supported languages
         languages_["c"] = {"C", ".c", "tree-sitter-c", true};
@@ -38,7 +175,7 @@ public:
         languages_["rust"] = {"Rust", ".rs", "tree-sitter-rust", true};
         languages_["json"] = {"JSON", ".json", "tree-sitter-json", true};
         languages_["yaml"] = {"YAML", ".yaml", "tree-sitter-yaml", true};
-        
+
         initialized_ = true;
     }
 
@@ -56,9 +193,9 @@ public:
         if (dotPos == std::string::npos) {
             return "";
         }
-        
+
         std::string extension = filePath.substr(dotPos);
-        
+
         for (const auto& pair : languages_) {
             if (pair.second.extension == extension) {
                 return pair.first;
@@ -76,29 +213,285 @@ public:
             return RAGGER_ERROR_PARSING_FAILED;
         }
 
-        // For now, create a simple block containing the entire file
-        // In a real implementation, this would parse the AST and extract meaningful blocks
-        *blocks = new CodeBlock[1];
-        *numBlocks = 1;
-
-        // Note: CodeBlock uses const char* so we need to store the strings
-        // In a real implementation, these would be managed by the plugin
-        static std::string storedName = filePath;
-        static std::string storedContent(content, contentSize);
-        static std::string storedFilePath = filePath;
-        static std::string storedLanguage = "cpp";
-        
-        (*blocks)[0].name = storedName.c_str();
-        (*blocks)[0].content = storedContent.c_str();
-        (*blocks)[0].filePath = storedFilePath.c_str();
-        (*blocks)[0].startLine = 1;
-        (*blocks)[0].endLine = 1; // Would be calculated from actual parsing
-        (*blocks)[0].language = storedLanguage.c_str();
-        (*blocks)[0].visibility = 2; // public
-        (*blocks)[0].metadata = nullptr;
-        
+        std::string newSource(content, contentSize);
+        FileState& state = fileStates_[filePath];
+
+        bool haveOldParse = !state.source.empty() || !state.blocks.empty();
+        EditRange edit = computeEditRange(state.source, newSource);
+        if (haveOldParse && !edit.changed) {
+            // Unchanged file: nothing to re-emit
+            *blocks = nullptr;
+            *numBlocks = 0;
+            return RAGGER_SUCCESS;
+        }
+
+        std::vector<ExtractedBlock> extracted;
+#ifdef RAGGER_HAVE_TREE_SITTER
+        int result = parseWithTreeSitter(language, newSource, state, edit, haveOldParse, extracted);
+        if (result != RAGGER_SUCCESS) {
+            return result;
+        }
+#else
+        extractBlocksHeuristic(filePath, language, newSource, extracted);
+#endif
+
+        // On a re-parse, only emit blocks that overlap the edited region;
+        // everything else is already in the index
+        std::vector<const ExtractedBlock*> toEmit;
+        for (const ExtractedBlock& block : extracted) {
+            if (!haveOldParse ||
+                (block.endByte >= edit.startByte && block.startByte <= edit.newEndByte)) {
+                toEmit.push_back(&block);
+            }
+        }
+
+        state.source = std::move(newSource);
+        state.blocks = std::move(extracted);
+
+        *numBlocks = toEmit.size();
+        if (toEmit.empty()) {
+            *blocks = nullptr;
+            return RAGGER_SUCCESS;
+        }
+
+        *blocks = new CodeBlock[toEmit.size()];
+        for (size_t i = 0; i < toEmit.size(); ++i) {
+            CodeBlock& out = (*blocks)[i];
+            out.name = duplicateString(toEmit[i]->name);
+            out.content = duplicateString(toEmit[i]->content);
+            out.filePath = duplicateString(filePath);
+            out.startLine = toEmit[i]->startLine;
+            out.endLine = toEmit[i]->endLine;
+            out.language = duplicateString(language);
+            out.visibility = 2; // public
+            out.metadata = nullptr;
+        }
+
         return RAGGER_SUCCESS;
     }
+
+    void forgetFile(const std::string& filePath) {
+        auto it = fileStates_.find(filePath);
+        if (it == fileStates_.end()) {
+            return;
+        }
+#ifdef RAGGER_HAVE_TREE_SITTER
+        if (it->second.tree) {
+            ts_tree_delete(it->second.tree);
+        }
+#endif
+        fileStates_.erase(it);
+    }
+
+private:
+#ifdef RAGGER_HAVE_TREE_SITTER
+    // Grammars ship as shared objects exporting tree_sitter_<lang>()
+    const TSLanguage* grammarFor(const std::string& language) {
+        auto cached = grammars_.find(language);
+        if (cached != grammars_.end()) {
+            return cached->second;
+        }
+
+        const LanguageInfo& info = languages_[language];
+        std::string libraryName = "lib" + info.grammar + ".so";
+        void* handle = dlopen(libraryName.c_str(), RTLD_NOW);
+        if (!handle) {
+            std::cerr << "TreeSitterParserPlugin: Failed to load grammar " << libraryName
+                      << ": " << dlerror() << std::endl;
+            grammars_[language] = nullptr;
+            return nullptr;
+        }
+
+        std::string symbol = info.grammar; // tree-sitter-cpp -> tree_sitter_cpp
+        for (char& c : symbol) {
+            if (c == '-') c = '_';
+        }
+
+        auto factory = reinterpret_cast<const TSLanguage* (*)()>(dlsym(handle, symbol.c_str()));
+        if (!factory) {
+            std::cerr << "TreeSitterParserPlugin: Missing symbol " << symbol
+                      << " in " << libraryName << std::endl;
+            dlclose(handle);
+            grammars_[language] = nullptr;
+            return nullptr;
+        }
+
+        grammarHandles_.push_back(handle);
+        grammars_[language] = factory();
+        return grammars_[language];
+    }
+
+    int parseWithTreeSitter(const std::string& language, const std::string& newSource,
+                            FileState& state, const EditRange& edit, bool haveOldParse,
+                            std::vector<ExtractedBlock>& extracted) {
+        const TSLanguage* grammar = grammarFor(language);
+        if (!grammar || !ts_parser_set_language(parser_, grammar)) {
+            return RAGGER_ERROR_PARSING_FAILED;
+        }
+
+        TSTree* oldTree = nullptr;
+        if (haveOldParse && state.tree && edit.changed) {
+            // Tell the old tree about the edit so the parser can reuse
+            // every node outside the changed region
+            TSInputEdit inputEdit;
+            inputEdit.start_byte = static_cast<uint32_t>(edit.startByte);
+            inputEdit.old_end_byte = static_cast<uint32_t>(edit.oldEndByte);
+            inputEdit.new_end_byte = static_cast<uint32_t>(edit.newEndByte);
+            inputEdit.start_point = pointAt(state.source, edit.startByte);
+            inputEdit.old_end_point = pointAt(state.source, edit.oldEndByte);
+            inputEdit.new_end_point = pointAt(newSource, edit.newEndByte);
+            ts_tree_edit(state.tree, &inputEdit);
+            oldTree = state.tree;
+        }
+
+        TSTree* newTree = ts_parser_parse_string(parser_, oldTree, newSource.c_str(),
+                                                 static_cast<uint32_t>(newSource.size()));
+        if (!newTree) {
+            return RAGGER_ERROR_PARSING_FAILED;
+        }
+
+        if (state.tree) {
+            ts_tree_delete(state.tree);
+        }
+        state.tree = newTree;
+
+        collectBlocks(ts_tree_root_node(newTree), newSource, extracted, 0);
+        return RAGGER_SUCCESS;
+    }
+
+    void collectBlocks(TSNode node, const std::string& source,
+                       std::vector<ExtractedBlock>& extracted, int depth) const {
+        uint32_t childCount = ts_node_named_child_count(node);
+        for (uint32_t i = 0; i < childCount; ++i) {
+            TSNode child = ts_node_named_child(node, i);
+            const char* type = ts_node_type(child);
+
+            if (isBlockNodeType(type)) {
+                if (std::strcmp(type, "namespace_definition") == 0 && depth < 2) {
+                    // Descend into namespaces instead of emitting one
+                    // giant block for the whole namespace body
+                    collectBlocks(child, source, extracted, depth + 1);
+                    continue;
+                }
+
+                ExtractedBlock block;
+                block.startByte = ts_node_start_byte(child);
+                block.endByte = ts_node_end_byte(child);
+                block.startLine = ts_node_start_point(child).row + 1;
+                block.endLine = ts_node_end_point(child).row + 1;
+                block.content = source.substr(block.startByte, block.endByte - block.startByte);
+                block.name = nodeName(child, source);
+                extracted.push_back(std::move(block));
+            } else if (depth < 2) {
+                // Grammars wrap declarations (e.g. declaration_list,
+                // template_declaration); look one level deeper
+                collectBlocks(child, source, extracted, depth + 1);
+            }
+        }
+    }
+
+    std::string nodeName(TSNode node, const std::string& source) const {
+        // Most grammars expose the identifier through a "name" or
+        // "declarator" field
+        TSNode name = ts_node_child_by_field_name(node, "name", 4);
+        if (ts_node_is_null(name)) {
+            name = ts_node_child_by_field_name(node, "declarator", 10);
+        }
+        if (ts_node_is_null(name)) {
+            return ts_node_type(node);
+        }
+        uint32_t start = ts_node_start_byte(name);
+        uint32_t end = ts_node_end_byte(name);
+        return source.substr(start, end - start);
+    }
+#else
+    // Fallback block extraction: top-level definitions found by brace
+    // scanning. Much coarser than a syntax tree, but it produces stable
+    // byte ranges so the incremental re-emission logic above still works
+    void extractBlocksHeuristic(const std::string& filePath, const std::string& language,
+                                const std::string& source,
+                                std::vector<ExtractedBlock>& extracted) const {
+        size_t lineStart = 0;
+        uint32_t lineNumber = 1;
+        int braceDepth = 0;
+        ExtractedBlock current;
+        bool inBlock = false;
+        uint32_t pendingStartLine = 1;
+        size_t pendingStartByte = 0;
+
+        for (size_t i = 0; i <= source.size(); ++i) {
+            char c = (i < source.size()) ? source[i] : '\n';
+
+            if (c == '{') {
+                if (braceDepth == 0 && !inBlock) {
+                    inBlock = true;
+                    current = ExtractedBlock();
+                    current.startByte = pendingStartByte;
+                    current.startLine = pendingStartLine;
+                    current.name = signatureName(source, pendingStartByte, i);
+                }
+                braceDepth++;
+            } else if (c == '}') {
+                braceDepth--;
+                if (braceDepth == 0 && inBlock) {
+                    current.endByte = i + 1;
+                    current.endLine = lineNumber;
+                    current.content = source.substr(current.startByte,
+                                                    current.endByte - current.startByte);
+                    extracted.push_back(std::move(current));
+                    inBlock = false;
+                }
+            } else if (c == '\n') {
+                lineNumber++;
+                if (braceDepth == 0 && !inBlock) {
+                    pendingStartByte = i + 1;
+                    pendingStartLine = lineNumber;
+                }
+                lineStart = i + 1;
+            }
+        }
+        (void)lineStart;
+
+        // Files with no braced structure (JSON, YAML, headers full of
+        // declarations) still get one whole-file block
+        if (extracted.empty() && !source.empty()) {
+            ExtractedBlock block;
+            block.name = filePath;
+            block.content = source;
+            block.startByte = 0;
+            block.endByte = source.size();
+            block.startLine = 1;
+            block.endLine = lineNumber;
+            extracted.push_back(std::move(block));
+        }
+        (void)language;
+    }
+
+    // Best-effort identifier: last token before the parameter list or
+    // opening brace
+    std::string signatureName(const std::string& source, size_t from, size_t to) const {
+        size_t nameEnd = source.find('(', from);
+        if (nameEnd == std::string::npos || nameEnd > to) {
+            nameEnd = to;
+        }
+        size_t end = nameEnd;
+        while (end > from && std::isspace(static_cast<unsigned char>(source[end - 1]))) {
+            end--;
+        }
+        size_t start = end;
+        while (start > from) {
+            char c = source[start - 1];
+            if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_' && c != ':' && c != '~') {
+                break;
+            }
+            start--;
+        }
+        if (start >= end) {
+            return "(anonymous)";
+        }
+        return source.substr(start, end - start);
+    }
+#endif
 };
 
 // Global parser instance
@@ -117,7 +510,7 @@ const char* plugin_get_name() {
 }
 
 const char* plugin_get_version() {
-    return "1.0.0";
+    return "1.1.0";
 }
 
 const char* plugin_get_description() {
@@ -130,7 +523,12 @@ int plugin_initialize(RaggerCoreHandle core) {
     }
 
     g_parser = new TreeSitterParser();
-    std::cout << "TreeSitterParserPlugin: Initialized" << std::endl;
+#ifdef RAGGER_HAVE_TREE_SITTER
+    std::cout << "TreeSitterParserPlugin: Initialized (tree-sitter runtime)" << std::endl;
+#else
+    std::cout << "TreeSitterParserPlugin: Initialized (heuristic fallback, "
+                 "built without tree-sitter)" << std::endl;
+#endif
     return RAGGER_SUCCESS;
 }
 
@@ -154,7 +552,7 @@ const char* plugin_get_capabilities() {
     return R"({
         "parser": {
             "languages": ["c", "cpp", "python", "javascript", "typescript", "java", "go", "rust", "json", "yaml"],
-            "features": ["ast", "symbols", "syntax_highlighting", "multi_language"]
+            "features": ["ast", "symbols", "syntax_highlighting", "multi_language", "incremental"]
         }
     })";
 }
@@ -162,7 +560,7 @@ const char* plugin_get_capabilities() {
 // Parser-specific functions
 const char** ragger_parser_get_supported_languages(size_t* count) {
     static const char* languages[] = {
-        "c", "cpp", "python", "javascript", "typescript", 
+        "c", "cpp", "python", "javascript", "typescript",
         "java", "go", "rust", "json", "yaml"
     };
     *count = 10;
@@ -181,16 +579,34 @@ int ragger_parser_parse_file(const char* filePath, CodeBlock** blocks, size_t* n
         return RAGGER_ERROR_INVALID_ARGUMENT;
     }
 
-    // For now, read the file content (in real implementation, this would be passed)
-    // This is a simplified version - real implementation would receive content
-    std::string content = "// Simplified content for demo";
-    
-    int result = g_parser->parseFile(filePath, content.c_str(), content.length(), blocks, numBlocks);
-    
-    std::cout << "TreeSitterParserPlugin: Parsed file " << filePath 
-              << " (stub implementation)" << std::endl;
-    
-    return result;
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    std::string content = buffer.str();
+
+    return g_parser->parseFile(filePath, content.c_str(), content.size(), blocks, numBlocks);
+}
+
+// Same parse path for callers that already hold the buffer (editors,
+// the file watcher); avoids a disk round-trip and enables incremental
+// reparse on unsaved content
+int ragger_parser_parse_content(const char* filePath, const char* content, size_t contentSize,
+                                CodeBlock** blocks, size_t* numBlocks) {
+    if (!g_parser || !filePath || !content || !blocks || !numBlocks) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+
+    return g_parser->parseFile(filePath, content, contentSize, blocks, numBlocks);
+}
+
+// Drops the cached tree and source for a deleted or renamed file
+void ragger_parser_forget_file(const char* filePath) {
+    if (g_parser && filePath) {
+        g_parser->forgetFile(filePath);
+    }
 }
 
 void ragger_parser_free_blocks(CodeBlock* blocks, size_t numBlocks) {
@@ -200,10 +616,38 @@ void ragger_parser_free_blocks(CodeBlock* blocks, size_t numBlocks) {
         delete[] blocks[i].name;
         delete[] blocks[i].content;
         delete[] blocks[i].filePath;
+        delete[] blocks[i].language;
     }
     delete[] blocks;
 }
 
+// Batch entry point (ABI 101): one cross-DSO call for many files, so the
+// grammar libraries load once for the whole batch. The parser state is
+// shared, so files are processed sequentially.
+int ragger_parser_parse_files(const char** filePaths, size_t numFiles,
+                              ParseBatchResult** results) {
+    if (!g_parser || !filePaths || !results) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+
+    *results = new ParseBatchResult[numFiles]();
+    for (size_t i = 0; i < numFiles; ++i) {
+        ParseBatchResult& result = (*results)[i];
+        result.status = ragger_parser_parse_file(filePaths[i], &result.blocks,
+                                                 &result.numBlocks);
+    }
+    return RAGGER_SUCCESS;
+}
+
+void ragger_parser_free_batch(ParseBatchResult* results, size_t numFiles) {
+    if (!results) return;
+
+    for (size_t i = 0; i < numFiles; ++i) {
+        ragger_parser_free_blocks(results[i].blocks, results[i].numBlocks);
+    }
+    delete[] results;
+}
+
 int ragger_parser_extract_symbols(const char* filePath, CodeSymbol** symbols, size_t* numSymbols) {
     if (!g_parser || !filePath || !symbols || !numSymbols) {
         return RAGGER_ERROR_INVALID_ARGUMENT;
@@ -212,10 +656,7 @@ int ragger_parser_extract_symbols(const char* filePath, CodeSymbol** symbols, si
     // Stub implementation - would extract symbols from AST
     *symbols = nullptr;
     *numSymbols = 0;
-    
-    std::cout << "TreeSitterParserPlugin: Extracted symbols from " << filePath 
-              << " (stub implementation)" << std::endl;
-    
+
     return RAGGER_SUCCESS;
 }
 
@@ -1,93 +1,154 @@
 #include "ragger_plugin_api.h"
+#include "ragger_plugin_api.hpp"
+#include "Tokenizer.h"
 #include <cmath>
+#include <cctype>
 #include <unordered_map>
+#include <queue>
+#include <string>
 #include <vector>
 #include <algorithm>
 #include <iostream>
+#include <fstream>
 #include <cstring>
+#include <mutex>
+#include <sqlite3.h>
 
 namespace {
 
-// BM25 Implementation
+// BM25 scoring. The scorer is stateless: corpus statistics (N, avgdl,
+// df) come from the core's SQLite index at query time, so there is no
+// in-memory shadow of the corpus to maintain or persist.
 class BM25Scorer {
 public:
-    BM25Scorer(float k1 = 1.5f, float b = 0.75f)
-        : k1_(k1), b_(b), totalDocs_(0) {}
+    BM25Scorer(float k1 = 1.5f, float b = 0.75f) : k1_(k1), b_(b) {}
 
-    void addDocument(const std::string& docId, const std::vector<std::string>& terms) {
-        docLengths_[docId] = terms.size();
-        totalDocs_++;
+    float scoreTerm(float tf, float df, float docLen, float avgDocLen, float totalDocs) const {
+        if (df <= 0.0f || tf <= 0.0f) return 0.0f;
 
-        for (const auto& term : terms) {
-            termFreq_[term][docId]++;
-            docFreq_[term]++;
-        }
+        float idf = std::log((totalDocs - df + 0.5f) / (df + 0.5f));
+        float tfNorm = (tf * (k1_ + 1)) / (tf + k1_ * (1 - b_ + b_ * docLen / avgDocLen));
+        return idf * tfNorm;
     }
 
-    float score(const std::string& docId, const std::vector<std::string>& queryTerms) {
-        if (docLengths_.find(docId) == docLengths_.end()) {
-            return 0.0f;
-        }
+private:
+    float k1_, b_;
+};
 
-        float score = 0.0f;
-        size_t docLen = docLengths_[docId];
-        float avgDocLen = computeAvgDocLength();
+// The core's index is hash-partitioned across shard databases
+// (data/index.db plus data/index.shardN.db, see IndexManager); rowids
+// are only unique per shard, so block identity across shards is the
+// shard-qualified id below.
+constexpr int GLOBAL_ID_SHARD_SHIFT = 48;
 
-        for (const auto& term : queryTerms) {
-            size_t tf = termFreq_[term][docId];
-            size_t df = docFreq_[term];
+int64_t makeGlobalBlockId(size_t shardIndex, sqlite3_int64 rowid) {
+    return (static_cast<int64_t>(shardIndex) << GLOBAL_ID_SHARD_SHIFT) | rowid;
+}
 
-            if (df == 0 || tf == 0) continue;
+size_t shardOfGlobalBlockId(int64_t globalId) {
+    return static_cast<size_t>(globalId >> GLOBAL_ID_SHARD_SHIFT);
+}
 
-            float idf = std::log((totalDocs_ - df + 0.5f) / (df + 0.5f));
-            float tfNorm = (tf * (k1_ + 1)) / (tf + k1_ * (1 - b_ + b_ * docLen / avgDocLen));
+sqlite3_int64 rowidOfGlobalBlockId(int64_t globalId) {
+    return globalId & ((int64_t(1) << GLOBAL_ID_SHARD_SHIFT) - 1);
+}
 
-            score += idf * tfNorm;
-        }
+// Plugin state
+struct BM25RankerState {
+    const RaggerCoreAPI* coreAPI; // Null when the core wired no API
+    BM25Scorer scorer;
+    float defaultWeight;
+    std::string rankingType;
+    // Read-only handles, one per index shard. Grow-only: the indexed-block
+    // event handler (bus thread) may open shards created after init while
+    // rank_blocks reads, hence the mutex; handles close only at shutdown.
+    std::mutex shardsMutex;
+    std::vector<sqlite3*> shardDbs;
+
+    // Result sets handed across the C ABI, keyed by the array pointer the
+    // caller got. The arena-backed wrapper owns every string and block, so
+    // free is one map erase instead of a per-string delete[] cascade.
+    // Overlapping requests rank concurrently, hence the mutex.
+    std::mutex resultsMutex;
+    std::unordered_map<RankingResult*, Ragger::Api::RankingResults> liveResults;
+
+    BM25RankerState()
+        : coreAPI(nullptr), defaultWeight(0.6f), rankingType("bm25") {}
 
-        return score;
+    ~BM25RankerState() {
+        for (sqlite3* db : shardDbs) {
+            if (db) {
+                sqlite3_close(db);
+            }
+        }
     }
+};
 
-private:
-    float k1_, b_;
-    size_t totalDocs_;
-    std::unordered_map<std::string, size_t> docLengths_;
-    std::unordered_map<std::string, std::unordered_map<std::string, size_t>> termFreq_;
-    std::unordered_map<std::string, size_t> docFreq_;
+BM25RankerState* g_state = nullptr;
 
-    float computeAvgDocLength() const {
-        if (docLengths_.empty()) return 0.0f;
+// The core's tokenizer guarantees query terms line up with stored postings
+std::vector<std::string> tokenizeQuery(const char* query) {
+    if (!query) return {};
+    return Ragger::Tokenizer::splitTokens(query);
+}
 
-        size_t totalLen = 0;
-        for (const auto& pair : docLengths_) {
-            totalLen += pair.second;
+// Opens index shards from the current count upward while the files
+// exist. Shard 0 keeps the original filename, shard N lives at
+// index.shardN.db (IndexManager naming). Caller holds shardsMutex.
+void openAvailableShardsLocked() {
+    for (size_t shard = g_state->shardDbs.size();; ++shard) {
+        std::string path = shard == 0
+            ? "data/index.db"
+            : "data/index.shard" + std::to_string(shard) + ".db";
+        std::ifstream probe(path);
+        if (!probe.good()) {
+            break;
         }
-        return static_cast<float>(totalLen) / docLengths_.size();
+        sqlite3* db = nullptr;
+        if (sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+            sqlite3_close(db);
+            break;
+        }
+        g_state->shardDbs.push_back(db);
     }
-};
+}
 
-// Plugin state
-struct BM25RankerState {
-    BM25Scorer* scorer;
-    float defaultWeight;
-    std::string rankingType;
+// Event payload convention for EVENT_CODEBLOCK_INDEXED: "docId\ncontent"
+// with docId the shard-qualified global block id. Postings and corpus
+// statistics are read from the index itself at query time (WAL readers
+// see the indexer's commits), so the only thing to react to is a block
+// landing in a shard created after this plugin opened its handles.
+void onCodeBlockIndexed(const EventData* event, void* /*userData*/) {
+    if (!g_state || !event || event->type != EVENT_CODEBLOCK_INDEXED || !event->data) {
+        return;
+    }
 
-    BM25RankerState() : scorer(nullptr), defaultWeight(0.6f), rankingType("bm25") {
-        scorer = new BM25Scorer();
+    std::string payload(static_cast<const char*>(event->data), event->dataSize);
+    size_t split = payload.find('\n');
+    if (split == std::string::npos) {
+        return;
     }
 
-    ~BM25RankerState() {
-        delete scorer;
+    int64_t globalId = 0;
+    try {
+        globalId = std::stoll(payload.substr(0, split));
+    } catch (...) {
+        return;
     }
-};
 
-BM25RankerState* g_state = nullptr;
+    std::lock_guard<std::mutex> lock(g_state->shardsMutex);
+    if (shardOfGlobalBlockId(globalId) >= g_state->shardDbs.size()) {
+        openAvailableShardsLocked();
+    }
+}
 
 } // anonymous namespace
 
 // Plugin API implementation
 extern "C" {
 
+void ragger_bm25_on_event(const EventData* event, void* userData);
+
 int plugin_get_abi_version() {
     return RAGGER_PLUGIN_ABI_VERSION;
 }
@@ -110,12 +171,32 @@ int plugin_initialize(RaggerCoreHandle core) {
     }
 
     g_state = new BM25RankerState();
+
+    // Open every shard of the core's index read-only; WAL mode lets us
+    // read while the indexer writes
+    {
+        std::lock_guard<std::mutex> lock(g_state->shardsMutex);
+        openAvailableShardsLocked();
+        if (g_state->shardDbs.empty()) {
+            std::cout << "BM25RankerPlugin: Index database not available yet" << std::endl;
+        }
+    }
+
+    // Watch indexed blocks so shards created after this point get opened
+    g_state->coreAPI = static_cast<const RaggerCoreAPI*>(core);
+    if (g_state->coreAPI && g_state->coreAPI->subscribe_event) {
+        g_state->coreAPI->subscribe_event(EVENT_CODEBLOCK_INDEXED, ragger_bm25_on_event, nullptr);
+    }
+
     std::cout << "BM25RankerPlugin: Initialized" << std::endl;
     return RAGGER_SUCCESS;
 }
 
 void plugin_shutdown() {
     if (g_state) {
+        if (g_state->coreAPI && g_state->coreAPI->unsubscribe_event) {
+            g_state->coreAPI->unsubscribe_event(EVENT_CODEBLOCK_INDEXED, ragger_bm25_on_event);
+        }
         delete g_state;
         g_state = nullptr;
     }
@@ -123,8 +204,16 @@ void plugin_shutdown() {
 }
 
 void plugin_register_events(EventCallback callback, void* userData) {
-    // Register for indexing events to update the scorer
-    // This would be implemented with the actual event system
+    // Subscription happens in plugin_initialize through the core API;
+    // nothing extra to register here
+    (void)callback;
+    (void)userData;
+}
+
+// Subscribed to EVENT_CODEBLOCK_INDEXED in plugin_initialize; keeps the
+// scorer's statistics in sync incrementally as blocks are indexed
+void ragger_bm25_on_event(const EventData* event, void* userData) {
+    onCodeBlockIndexed(event, userData);
 }
 
 void plugin_unregister_events() {
@@ -169,18 +258,177 @@ int ragger_ranker_rank_blocks(const ContextRequest* request, RankingResult** res
         return RAGGER_ERROR_INVALID_ARGUMENT;
     }
 
-    // For this implementation, we'll create some dummy results
-    // In a real implementation, this would score actual code blocks
-    *numResults = 3;
-    *results = new RankingResult[*numResults];
+    *results = nullptr;
+    *numResults = 0;
+
+    // Snapshot the shard handles; the event handler may append to the
+    // vector concurrently, but handles stay open until shutdown
+    std::vector<sqlite3*> shards;
+    {
+        std::lock_guard<std::mutex> lock(g_state->shardsMutex);
+        shards = g_state->shardDbs;
+    }
+    if (shards.empty()) {
+        return RAGGER_SUCCESS; // No index yet; nothing to rank
+    }
+
+    auto terms = tokenizeQuery(request->userQuery);
+    if (terms.empty()) {
+        return RAGGER_SUCCESS;
+    }
+
+    // Corpus-wide statistics for the BM25 formula, aggregated across all
+    // shards so idf and length normalization see the whole corpus
+    float totalDocs = 0.0f;
+    float totalLen = 0.0f;
+    sqlite3_stmt* stmt;
+    for (sqlite3* db : shards) {
+        if (sqlite3_prepare_v2(db,
+                "SELECT COUNT(*), COALESCE(SUM(len), 0) FROM "
+                "(SELECT SUM(frequency) AS len FROM inverted_index GROUP BY block_id)",
+                -1, &stmt, nullptr) == SQLITE_OK) {
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                totalDocs += static_cast<float>(sqlite3_column_double(stmt, 0));
+                totalLen += static_cast<float>(sqlite3_column_double(stmt, 1));
+            }
+            sqlite3_finalize(stmt);
+        }
+    }
+
+    if (totalDocs <= 0.0f || totalLen <= 0.0f) {
+        return RAGGER_SUCCESS;
+    }
+    float avgDocLen = totalLen / totalDocs;
+
+    // Accumulate per-block BM25 contributions term by term. Document
+    // frequency must be summed over shards before scoring, so each term
+    // first gathers its postings from every shard, then scores them with
+    // the global df.
+    struct Candidate {
+        float score;
+        float docLen;
+    };
+    std::unordered_map<int64_t, Candidate> candidates;
+
+    const char* postingsSql =
+        "SELECT ii.block_id, ii.frequency, "
+        "       (SELECT SUM(frequency) FROM inverted_index WHERE block_id = ii.block_id) AS len "
+        "FROM inverted_index ii WHERE ii.token = ?";
+
+    struct Posting {
+        int64_t globalId;
+        float tf;
+        float docLen;
+    };
+
+    for (const auto& term : terms) {
+        std::vector<Posting> postings;
+        float df = 0.0f;
+
+        for (size_t shard = 0; shard < shards.size(); ++shard) {
+            sqlite3* db = shards[shard];
+            if (sqlite3_prepare_v2(db, postingsSql, -1, &stmt, nullptr) != SQLITE_OK) {
+                return RAGGER_ERROR_RANKING_FAILED;
+            }
+            sqlite3_bind_text(stmt, 1, term.c_str(), -1, SQLITE_TRANSIENT);
+
+            while (sqlite3_step(stmt) == SQLITE_ROW) {
+                Posting posting;
+                posting.globalId = makeGlobalBlockId(shard, sqlite3_column_int64(stmt, 0));
+                posting.tf = static_cast<float>(sqlite3_column_double(stmt, 1));
+                posting.docLen = static_cast<float>(sqlite3_column_double(stmt, 2));
+                postings.push_back(posting);
+                df += 1.0f;
+            }
+            sqlite3_finalize(stmt);
+        }
+
+        for (const Posting& posting : postings) {
+            auto& candidate = candidates[posting.globalId];
+            candidate.docLen = posting.docLen;
+            candidate.score += g_state->scorer.scoreTerm(posting.tf, df, posting.docLen,
+                                                         avgDocLen, totalDocs);
+        }
+    }
+
+    if (candidates.empty()) {
+        return RAGGER_SUCCESS;
+    }
+
+    // Bounded min-heap keeps the top-k without sorting all candidates
+    static const size_t TOP_K = 20;
+    using ScoredBlock = std::pair<float, int64_t>;
+    std::priority_queue<ScoredBlock, std::vector<ScoredBlock>, std::greater<ScoredBlock>> heap;
+
+    for (const auto& pair : candidates) {
+        if (heap.size() < TOP_K) {
+            heap.push({pair.second.score, pair.first});
+        } else if (pair.second.score > heap.top().first) {
+            heap.pop();
+            heap.push({pair.second.score, pair.first});
+        }
+    }
+
+    std::vector<ScoredBlock> topBlocks;
+    while (!heap.empty()) {
+        topBlocks.push_back(heap.top());
+        heap.pop();
+    }
+    std::reverse(topBlocks.begin(), topBlocks.end()); // Highest score first
+
+    // Materialize CodeBlocks only for the winners, each from the shard
+    // its global id names. One prepared statement per shard, reused.
+    const char* materializeSql =
+        "SELECT file_path, name, content, start_line, end_line, block_type "
+        "FROM code_blocks WHERE id = ?";
+    std::vector<sqlite3_stmt*> shardStmts(shards.size(), nullptr);
+
+    Ragger::Api::RankingResults ranked;
+
+    for (const auto& scored : topBlocks) {
+        size_t shard = shardOfGlobalBlockId(scored.second);
+        if (shard >= shards.size()) {
+            continue;
+        }
+        if (!shardStmts[shard] &&
+            sqlite3_prepare_v2(shards[shard], materializeSql, -1,
+                               &shardStmts[shard], nullptr) != SQLITE_OK) {
+            shardStmts[shard] = nullptr;
+            continue;
+        }
+        sqlite3_stmt* materialize = shardStmts[shard];
+        sqlite3_bind_int64(materialize, 1, rowidOfGlobalBlockId(scored.second));
+
+        if (sqlite3_step(materialize) == SQLITE_ROW) {
+            CodeBlock& block = ranked.blocks().add(
+                reinterpret_cast<const char*>(sqlite3_column_text(materialize, 1)),
+                reinterpret_cast<const char*>(sqlite3_column_text(materialize, 2)),
+                reinterpret_cast<const char*>(sqlite3_column_text(materialize, 0)),
+                sqlite3_column_int(materialize, 3),
+                sqlite3_column_int(materialize, 4),
+                reinterpret_cast<const char*>(sqlite3_column_text(materialize, 5)));
+            ranked.add(&block, scored.first, g_state->rankingType.c_str());
+        }
 
-    for (size_t i = 0; i < *numResults; ++i) {
-        (*results)[i].block = nullptr; // Would point to actual CodeBlock
-        (*results)[i].score = 0.8f - (i * 0.1f); // Decreasing scores
-        (*results)[i].rankingType = new char[5];
-        strcpy(const_cast<char*>((*results)[i].rankingType), "bm25");
+        sqlite3_reset(materialize);
+    }
+    for (sqlite3_stmt* shardStmt : shardStmts) {
+        if (shardStmt) {
+            sqlite3_finalize(shardStmt);
+        }
     }
 
+    if (ranked.empty()) {
+        return RAGGER_SUCCESS;
+    }
+
+    // Hand out the C view and park the owning wrapper until free_results
+    *results = ranked.data();
+    *numResults = ranked.size();
+    {
+        std::lock_guard<std::mutex> lock(g_state->resultsMutex);
+        g_state->liveResults.emplace(*results, std::move(ranked));
+    }
     std::cout << "BM25RankerPlugin: Ranked " << *numResults << " blocks" << std::endl;
     return RAGGER_SUCCESS;
 }
@@ -188,7 +436,24 @@ int ragger_ranker_rank_blocks(const ContextRequest* request, RankingResult** res
 void ragger_ranker_free_results(RankingResult* results, size_t numResults) {
     if (!results) return;
 
+    // The wrapper owns every allocation; dropping it releases the whole
+    // result graph in one arena free
+    if (g_state) {
+        std::lock_guard<std::mutex> lock(g_state->resultsMutex);
+        if (g_state->liveResults.erase(results) > 0) {
+            return;
+        }
+    }
+
+    // Legacy path for arrays built with per-string allocations
     for (size_t i = 0; i < numResults; ++i) {
+        if (results[i].block) {
+            delete[] results[i].block->filePath;
+            delete[] results[i].block->name;
+            delete[] results[i].block->content;
+            delete[] results[i].block->language;
+            delete results[i].block;
+        }
         delete[] results[i].rankingType;
     }
     delete[] results;
@@ -0,0 +1,785 @@
+#include "ragger_plugin_api.h"
+#include "Tokenizer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <sqlite3.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+// Index geometry. The node records are fixed-size so the whole index can
+// live in one memory-mapped file and load without deserialization.
+constexpr uint32_t EMBEDDING_DIM = 128;
+constexpr uint32_t MAX_NEIGHBORS = 16;   // M
+constexpr uint32_t MAX_LEVELS = 4;
+constexpr uint32_t EF_CONSTRUCTION = 64;
+constexpr uint32_t EF_SEARCH = 64;
+constexpr uint32_t INITIAL_CAPACITY = 1024;
+constexpr size_t EMBED_BATCH_SIZE = 32;
+
+using Embedding = std::array<float, EMBEDDING_DIM>;
+
+// Feature-hashing embedder: tokens are hashed into a fixed number of
+// dimensions with sign hashing and log-TF weighting, then L2-normalized.
+// It is a deterministic stand-in with the same store/search interface a
+// model-backed embedder would use; swapping in one only changes this class.
+class HashingEmbedder {
+public:
+    static Embedding embed(const std::string& text) {
+        Embedding vec{};
+        std::unordered_map<std::string, int> freqs;
+        for (const auto& token : Ragger::Tokenizer::splitTokens(text)) {
+            freqs[token]++;
+        }
+
+        for (const auto& pair : freqs) {
+            size_t hash = std::hash<std::string>{}(pair.first);
+            size_t dim = hash % EMBEDDING_DIM;
+            float sign = ((hash >> 16) & 1) ? 1.0f : -1.0f;
+            vec[dim] += sign * (1.0f + std::log(static_cast<float>(pair.second)));
+        }
+
+        float norm = 0.0f;
+        for (float v : vec) norm += v * v;
+        norm = std::sqrt(norm);
+        if (norm > 0.0f) {
+            for (float& v : vec) v /= norm;
+        }
+        return vec;
+    }
+
+    // One call per batch keeps the interface ready for embedders where
+    // batching is the difference between interactive and not
+    static std::vector<Embedding> embedBatch(const std::vector<std::string>& texts) {
+        std::vector<Embedding> out;
+        out.reserve(texts.size());
+        for (const auto& text : texts) {
+            out.push_back(embed(text));
+        }
+        return out;
+    }
+};
+
+// HNSW index over block embeddings, held in a memory-mapped file.
+//
+// File layout: IndexHeader, then capacity fixed-size node records of
+// { blockId, level, vector, per-level neighbor lists }. Inserts write
+// through the mapping; growth doubles the file and remaps.
+class HnswStore {
+public:
+    struct IndexHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t dim;
+        uint32_t capacity;
+        uint32_t count;
+        int32_t entryPoint;
+        int32_t maxLevel;
+        uint32_t reserved;
+    };
+
+    static constexpr size_t NEIGHBOR_BLOCK_SIZE = sizeof(int32_t) * (1 + MAX_NEIGHBORS);
+    static constexpr size_t NODE_SIZE = sizeof(int64_t) + 2 * sizeof(int32_t) +
+                                        EMBEDDING_DIM * sizeof(float) +
+                                        MAX_LEVELS * NEIGHBOR_BLOCK_SIZE;
+
+    ~HnswStore() { close(); }
+
+    bool open(const std::string& path) {
+        path_ = path;
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) {
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd_, &st) != 0) {
+            close();
+            return false;
+        }
+
+        if (static_cast<size_t>(st.st_size) < sizeof(IndexHeader)) {
+            if (!initializeFile(INITIAL_CAPACITY)) {
+                close();
+                return false;
+            }
+        } else if (!mapFile(static_cast<size_t>(st.st_size))) {
+            close();
+            return false;
+        }
+
+        // Version 2: stored ids are shard-qualified global block ids, not
+        // raw rowids; version-1 stores are discarded rather than misread
+        IndexHeader* h = header();
+        if (memcmp(h->magic, "RGEV", 4) != 0 || h->version != 2 || h->dim != EMBEDDING_DIM) {
+            // Incompatible or corrupt; start over
+            unmapFile();
+            if (!initializeFile(INITIAL_CAPACITY)) {
+                close();
+                return false;
+            }
+        }
+
+        // Slot lookup for re-indexed blocks lives in RAM only
+        idToSlot_.clear();
+        for (uint32_t i = 0; i < header()->count; ++i) {
+            idToSlot_[nodeBlockId(i)] = i;
+        }
+        return true;
+    }
+
+    void close() {
+        unmapFile();
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    void flush() {
+        if (mapping_) {
+            msync(mapping_, mappingSize_, MS_ASYNC);
+        }
+    }
+
+    size_t size() const { return mapping_ ? header()->count : 0; }
+
+    void insert(int64_t blockId, const float* vec) {
+        if (!mapping_) {
+            return;
+        }
+
+        // Re-indexed block: overwrite the vector in place, keep the links
+        auto existing = idToSlot_.find(blockId);
+        if (existing != idToSlot_.end()) {
+            memcpy(nodeVector(existing->second), vec, EMBEDDING_DIM * sizeof(float));
+            return;
+        }
+
+        if (header()->count == header()->capacity && !grow()) {
+            return;
+        }
+
+        IndexHeader* h = header();
+        uint32_t slot = h->count++;
+        int32_t level = randomLevel();
+
+        nodeBlockId(slot) = blockId;
+        nodeLevel(slot) = level;
+        memcpy(nodeVector(slot), vec, EMBEDDING_DIM * sizeof(float));
+        for (uint32_t l = 0; l < MAX_LEVELS; ++l) {
+            neighborCount(slot, l) = 0;
+        }
+        idToSlot_[blockId] = slot;
+
+        if (h->entryPoint < 0) {
+            h->entryPoint = static_cast<int32_t>(slot);
+            h->maxLevel = level;
+            return;
+        }
+
+        // Greedy descent through the levels above the new node's level
+        uint32_t current = static_cast<uint32_t>(h->entryPoint);
+        for (int32_t l = h->maxLevel; l > level; --l) {
+            current = greedyClosest(vec, current, static_cast<uint32_t>(l));
+        }
+
+        // From the node's level down, link into the ef-construction
+        // neighborhood at each level
+        for (int32_t l = std::min(level, h->maxLevel); l >= 0; --l) {
+            auto candidates = searchLayer(vec, current, EF_CONSTRUCTION, static_cast<uint32_t>(l));
+            linkNode(slot, candidates, static_cast<uint32_t>(l));
+            if (!candidates.empty()) {
+                current = candidates.front().second;
+            }
+        }
+
+        if (level > h->maxLevel) {
+            h->maxLevel = level;
+            h->entryPoint = static_cast<int32_t>(slot);
+        }
+    }
+
+    // Returns up to k (similarity, blockId) pairs, most similar first
+    std::vector<std::pair<float, int64_t>> search(const float* query, size_t k) const {
+        std::vector<std::pair<float, int64_t>> results;
+        if (!mapping_ || header()->count == 0 || header()->entryPoint < 0) {
+            return results;
+        }
+
+        uint32_t current = static_cast<uint32_t>(header()->entryPoint);
+        for (int32_t l = header()->maxLevel; l > 0; --l) {
+            current = greedyClosest(query, current, static_cast<uint32_t>(l));
+        }
+
+        auto candidates = searchLayer(query, current, std::max<size_t>(EF_SEARCH, k), 0);
+        for (const auto& candidate : candidates) {
+            if (results.size() >= k) {
+                break;
+            }
+            results.push_back({-candidate.first, nodeBlockId(candidate.second)});
+        }
+        return results;
+    }
+
+private:
+    int fd_ = -1;
+    void* mapping_ = nullptr;
+    size_t mappingSize_ = 0;
+    std::string path_;
+    std::unordered_map<int64_t, uint32_t> idToSlot_;
+    mutable std::mt19937 rng_{std::random_device{}()};
+
+    IndexHeader* header() const { return static_cast<IndexHeader*>(mapping_); }
+
+    char* nodeBase(uint32_t slot) const {
+        return static_cast<char*>(mapping_) + sizeof(IndexHeader) + slot * NODE_SIZE;
+    }
+    int64_t& nodeBlockId(uint32_t slot) const {
+        return *reinterpret_cast<int64_t*>(nodeBase(slot));
+    }
+    int32_t& nodeLevel(uint32_t slot) const {
+        return *reinterpret_cast<int32_t*>(nodeBase(slot) + sizeof(int64_t));
+    }
+    float* nodeVector(uint32_t slot) const {
+        return reinterpret_cast<float*>(nodeBase(slot) + sizeof(int64_t) + 2 * sizeof(int32_t));
+    }
+    int32_t& neighborCount(uint32_t slot, uint32_t level) const {
+        char* base = nodeBase(slot) + sizeof(int64_t) + 2 * sizeof(int32_t) +
+                     EMBEDDING_DIM * sizeof(float) + level * NEIGHBOR_BLOCK_SIZE;
+        return *reinterpret_cast<int32_t*>(base);
+    }
+    int32_t* neighborIds(uint32_t slot, uint32_t level) const {
+        return &neighborCount(slot, level) + 1;
+    }
+
+    bool initializeFile(uint32_t capacity) {
+        size_t size = sizeof(IndexHeader) + static_cast<size_t>(capacity) * NODE_SIZE;
+        if (ftruncate(fd_, static_cast<off_t>(size)) != 0 || !mapFile(size)) {
+            return false;
+        }
+
+        IndexHeader* h = header();
+        memcpy(h->magic, "RGEV", 4);
+        h->version = 2;
+        h->dim = EMBEDDING_DIM;
+        h->capacity = capacity;
+        h->count = 0;
+        h->entryPoint = -1;
+        h->maxLevel = 0;
+        h->reserved = 0;
+        return true;
+    }
+
+    bool mapFile(size_t size) {
+        mapping_ = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (mapping_ == MAP_FAILED) {
+            mapping_ = nullptr;
+            return false;
+        }
+        mappingSize_ = size;
+        return true;
+    }
+
+    void unmapFile() {
+        if (mapping_) {
+            msync(mapping_, mappingSize_, MS_SYNC);
+            munmap(mapping_, mappingSize_);
+            mapping_ = nullptr;
+            mappingSize_ = 0;
+        }
+    }
+
+    bool grow() {
+        uint32_t newCapacity = header()->capacity * 2;
+        size_t newSize = sizeof(IndexHeader) + static_cast<size_t>(newCapacity) * NODE_SIZE;
+        unmapFile();
+        if (ftruncate(fd_, static_cast<off_t>(newSize)) != 0 || !mapFile(newSize)) {
+            return false;
+        }
+        header()->capacity = newCapacity;
+        return true;
+    }
+
+    // Level drawn from a geometric distribution, as in the HNSW paper
+    int32_t randomLevel() const {
+        std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+        int32_t level = 0;
+        while (uniform(rng_) < 0.5f && level < static_cast<int32_t>(MAX_LEVELS) - 1) {
+            ++level;
+        }
+        return level;
+    }
+
+    // Distance is negative dot product; vectors are normalized, so this
+    // orders candidates by cosine similarity
+    float distance(const float* a, const float* b) const {
+        float dot = 0.0f;
+        for (uint32_t i = 0; i < EMBEDDING_DIM; ++i) {
+            dot += a[i] * b[i];
+        }
+        return -dot;
+    }
+
+    uint32_t greedyClosest(const float* query, uint32_t start, uint32_t level) const {
+        uint32_t current = start;
+        float currentDist = distance(query, nodeVector(current));
+        bool improved = true;
+        while (improved) {
+            improved = false;
+            int32_t count = neighborCount(current, level);
+            const int32_t* ids = neighborIds(current, level);
+            for (int32_t i = 0; i < count; ++i) {
+                float d = distance(query, nodeVector(static_cast<uint32_t>(ids[i])));
+                if (d < currentDist) {
+                    currentDist = d;
+                    current = static_cast<uint32_t>(ids[i]);
+                    improved = true;
+                }
+            }
+        }
+        return current;
+    }
+
+    // Standard ef-bounded layer search; returns (distance, slot) sorted
+    // closest first
+    std::vector<std::pair<float, uint32_t>> searchLayer(const float* query, uint32_t start,
+                                                        size_t ef, uint32_t level) const {
+        using Scored = std::pair<float, uint32_t>;
+        std::priority_queue<Scored, std::vector<Scored>, std::greater<Scored>> toVisit;
+        std::priority_queue<Scored> best; // Max-heap: top is the worst kept
+        std::unordered_set<uint32_t> visited;
+
+        float startDist = distance(query, nodeVector(start));
+        toVisit.push({startDist, start});
+        best.push({startDist, start});
+        visited.insert(start);
+
+        while (!toVisit.empty()) {
+            Scored current = toVisit.top();
+            toVisit.pop();
+            if (current.first > best.top().first && best.size() >= ef) {
+                break;
+            }
+
+            int32_t count = neighborCount(current.second, level);
+            const int32_t* ids = neighborIds(current.second, level);
+            for (int32_t i = 0; i < count; ++i) {
+                uint32_t neighbor = static_cast<uint32_t>(ids[i]);
+                if (!visited.insert(neighbor).second) {
+                    continue;
+                }
+                float d = distance(query, nodeVector(neighbor));
+                if (best.size() < ef || d < best.top().first) {
+                    toVisit.push({d, neighbor});
+                    best.push({d, neighbor});
+                    if (best.size() > ef) {
+                        best.pop();
+                    }
+                }
+            }
+        }
+
+        std::vector<Scored> sorted;
+        sorted.reserve(best.size());
+        while (!best.empty()) {
+            sorted.push_back(best.top());
+            best.pop();
+        }
+        std::reverse(sorted.begin(), sorted.end());
+        return sorted;
+    }
+
+    void linkNode(uint32_t slot, const std::vector<std::pair<float, uint32_t>>& candidates,
+                  uint32_t level) {
+        size_t links = std::min<size_t>(candidates.size(), MAX_NEIGHBORS);
+        neighborCount(slot, level) = static_cast<int32_t>(links);
+        for (size_t i = 0; i < links; ++i) {
+            neighborIds(slot, level)[i] = static_cast<int32_t>(candidates[i].second);
+            addReverseLink(candidates[i].second, slot, level);
+        }
+    }
+
+    // Bidirectional links; a full neighbor list evicts its farthest entry
+    void addReverseLink(uint32_t from, uint32_t to, uint32_t level) {
+        int32_t& count = neighborCount(from, level);
+        int32_t* ids = neighborIds(from, level);
+
+        if (count < static_cast<int32_t>(MAX_NEIGHBORS)) {
+            ids[count++] = static_cast<int32_t>(to);
+            return;
+        }
+
+        const float* fromVec = nodeVector(from);
+        float newDist = distance(fromVec, nodeVector(to));
+        int32_t worst = -1;
+        float worstDist = newDist;
+        for (int32_t i = 0; i < count; ++i) {
+            float d = distance(fromVec, nodeVector(static_cast<uint32_t>(ids[i])));
+            if (d > worstDist) {
+                worstDist = d;
+                worst = i;
+            }
+        }
+        if (worst >= 0) {
+            ids[worst] = static_cast<int32_t>(to);
+        }
+    }
+};
+
+// Block ids in the HNSW store are shard-qualified: the high 16 bits name
+// the index shard, the low 48 the rowid within that shard's code_blocks
+// table. Plain rowids would collide once IndexManager splits the corpus
+// across data/index.db and data/index.shardN.db.
+constexpr int GLOBAL_ID_SHARD_SHIFT = 48;
+
+size_t shardOfGlobalBlockId(int64_t globalId) {
+    return static_cast<size_t>(globalId >> GLOBAL_ID_SHARD_SHIFT);
+}
+
+sqlite3_int64 rowidOfGlobalBlockId(int64_t globalId) {
+    return globalId & ((int64_t(1) << GLOBAL_ID_SHARD_SHIFT) - 1);
+}
+
+// Plugin state
+struct EmbeddingRankerState {
+    const RaggerCoreAPI* coreAPI; // Null when the core wired no API
+    HnswStore store;
+    // Indexed-block events arrive on the bus thread while rank_blocks
+    // runs on request threads; the mutex covers the store and the queue
+    std::mutex storeMutex;
+    float defaultWeight;
+    std::string rankingType;
+    std::vector<sqlite3*> shardDbs; // Read-only handles, one per index shard
+    std::string indexPath;
+
+    // Blocks waiting for the next batched embedding call
+    std::vector<std::pair<int64_t, std::string>> pendingBlocks;
+
+    EmbeddingRankerState()
+        : coreAPI(nullptr), defaultWeight(0.3f), rankingType("embedding"),
+          indexPath("data/embeddings.bin") {}
+
+    ~EmbeddingRankerState() {
+        for (sqlite3* db : shardDbs) {
+            if (db) {
+                sqlite3_close(db);
+            }
+        }
+    }
+};
+
+EmbeddingRankerState* g_state = nullptr;
+
+// Embed and insert everything queued since the last flush in one batch.
+// Caller holds storeMutex.
+void flushPendingEmbeddingsLocked() {
+    if (!g_state || g_state->pendingBlocks.empty()) {
+        return;
+    }
+
+    std::vector<std::string> texts;
+    texts.reserve(g_state->pendingBlocks.size());
+    for (const auto& pending : g_state->pendingBlocks) {
+        texts.push_back(pending.second);
+    }
+
+    std::vector<Embedding> vectors = HashingEmbedder::embedBatch(texts);
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        g_state->store.insert(g_state->pendingBlocks[i].first, vectors[i].data());
+    }
+
+    g_state->pendingBlocks.clear();
+    g_state->store.flush();
+}
+
+// Event payload convention for EVENT_CODEBLOCK_INDEXED: "docId\ncontent",
+// where docId is the shard-qualified global block id. Blocks are queued
+// and embedded in batches rather than one call per event.
+void onCodeBlockIndexed(const EventData* event, void* /*userData*/) {
+    if (!g_state || !event || event->type != EVENT_CODEBLOCK_INDEXED || !event->data) {
+        return;
+    }
+
+    std::string payload(static_cast<const char*>(event->data), event->dataSize);
+    size_t split = payload.find('\n');
+    if (split == std::string::npos) {
+        return;
+    }
+
+    int64_t blockId = 0;
+    try {
+        blockId = std::stoll(payload.substr(0, split));
+    } catch (...) {
+        return; // Non-numeric docId; not addressable in the block store
+    }
+
+    std::lock_guard<std::mutex> lock(g_state->storeMutex);
+    g_state->pendingBlocks.emplace_back(blockId, payload.substr(split + 1));
+    if (g_state->pendingBlocks.size() >= EMBED_BATCH_SIZE) {
+        flushPendingEmbeddingsLocked();
+    }
+}
+
+char* duplicateString(const char* text) {
+    if (!text) text = "";
+    size_t len = std::strlen(text);
+    char* copy = new char[len + 1];
+    std::memcpy(copy, text, len + 1);
+    return copy;
+}
+
+} // anonymous namespace
+
+// Plugin API implementation
+extern "C" {
+
+void ragger_embedding_on_event(const EventData* event, void* userData);
+
+int plugin_get_abi_version() {
+    return RAGGER_PLUGIN_ABI_VERSION;
+}
+
+const char* plugin_get_name() {
+    return "Embedding Ranker";
+}
+
+const char* plugin_get_version() {
+    return "1.0.0";
+}
+
+const char* plugin_get_description() {
+    return "Semantic ranking via embedding vectors with HNSW ANN search";
+}
+
+int plugin_initialize(RaggerCoreHandle core) {
+    if (g_state) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED; // Already initialized
+    }
+
+    g_state = new EmbeddingRankerState();
+
+    if (!g_state->store.open(g_state->indexPath)) {
+        std::cout << "EmbeddingRankerPlugin: Could not open embedding index at "
+                  << g_state->indexPath << std::endl;
+        delete g_state;
+        g_state = nullptr;
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    // Open every shard of the core's index read-only; WAL mode lets us
+    // read while the indexer writes. Shard 0 is data/index.db, higher
+    // shards follow IndexManager's index.shardN.db naming.
+    for (size_t shard = 0;; ++shard) {
+        std::string path = shard == 0
+            ? "data/index.db"
+            : "data/index.shard" + std::to_string(shard) + ".db";
+        if (::access(path.c_str(), F_OK) != 0) {
+            break;
+        }
+        sqlite3* db = nullptr;
+        if (sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+            sqlite3_close(db);
+            break;
+        }
+        g_state->shardDbs.push_back(db);
+    }
+    if (g_state->shardDbs.empty()) {
+        std::cout << "EmbeddingRankerPlugin: Index database not available yet" << std::endl;
+    }
+
+    // Keep the store current as blocks are indexed
+    g_state->coreAPI = static_cast<const RaggerCoreAPI*>(core);
+    if (g_state->coreAPI && g_state->coreAPI->subscribe_event) {
+        g_state->coreAPI->subscribe_event(EVENT_CODEBLOCK_INDEXED, ragger_embedding_on_event,
+                                          nullptr);
+    }
+
+    std::cout << "EmbeddingRankerPlugin: Initialized with " << g_state->store.size()
+              << " stored embeddings" << std::endl;
+    return RAGGER_SUCCESS;
+}
+
+void plugin_shutdown() {
+    if (g_state) {
+        if (g_state->coreAPI && g_state->coreAPI->unsubscribe_event) {
+            g_state->coreAPI->unsubscribe_event(EVENT_CODEBLOCK_INDEXED,
+                                                ragger_embedding_on_event);
+        }
+        {
+            std::lock_guard<std::mutex> lock(g_state->storeMutex);
+            flushPendingEmbeddingsLocked();
+            g_state->store.close();
+        }
+        delete g_state;
+        g_state = nullptr;
+    }
+    std::cout << "EmbeddingRankerPlugin: Shutdown" << std::endl;
+}
+
+void plugin_register_events(EventCallback callback, void* userData) {
+    // Subscription happens in plugin_initialize through the core API;
+    // nothing extra to register here
+    (void)callback;
+    (void)userData;
+}
+
+// Subscribed to EVENT_CODEBLOCK_INDEXED in plugin_initialize; keeps the
+// embedding store in sync incrementally as blocks are indexed
+void ragger_embedding_on_event(const EventData* event, void* userData) {
+    onCodeBlockIndexed(event, userData);
+}
+
+void plugin_unregister_events() {
+    // Unregister events
+}
+
+const char* plugin_get_capabilities() {
+    return R"({
+        "ranking": {
+            "type": "embedding",
+            "default_weight": 0.3,
+            "supports": ["semantic_similarity", "ann_search"]
+        }
+    })";
+}
+
+// Plugin interface functions (exported)
+extern "C" int ragger_plugin_get_interface(PluginHandle handle, PluginInterface* interface) {
+    if (!interface) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+
+    interface->type = PLUGIN_TYPE_RANKER;
+    interface->api = nullptr; // API functions are called directly
+
+    return RAGGER_SUCCESS;
+}
+
+const char* ragger_ranker_get_ranking_type() {
+    return g_state ? g_state->rankingType.c_str() : "embedding";
+}
+
+float ragger_ranker_get_default_weight() {
+    return g_state ? g_state->defaultWeight : 0.3f;
+}
+
+int ragger_ranker_rank_blocks(const ContextRequest* request, RankingResult** results, size_t* numResults) {
+    if (!g_state || !request || !results || !numResults) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+
+    *results = nullptr;
+    *numResults = 0;
+
+    if (!request->userQuery || request->userQuery[0] == '\0') {
+        return RAGGER_SUCCESS;
+    }
+
+    Embedding queryVec = HashingEmbedder::embed(request->userQuery);
+
+    static const size_t TOP_K = 20;
+    std::vector<std::pair<float, int64_t>> matches;
+    {
+        // Anything still queued must be searchable now
+        std::lock_guard<std::mutex> lock(g_state->storeMutex);
+        flushPendingEmbeddingsLocked();
+        if (g_state->store.size() == 0) {
+            return RAGGER_SUCCESS;
+        }
+        matches = g_state->store.search(queryVec.data(), TOP_K);
+    }
+    if (matches.empty()) {
+        return RAGGER_SUCCESS;
+    }
+
+    if (g_state->shardDbs.empty()) {
+        return RAGGER_SUCCESS; // No index yet; nothing to materialize
+    }
+
+    // Materialize CodeBlocks only for the winners; each match's global id
+    // names the shard holding its row
+    const char* materializeSql =
+        "SELECT file_path, name, content, start_line, end_line, block_type "
+        "FROM code_blocks WHERE id = ?";
+    std::vector<sqlite3_stmt*> shardStmts(g_state->shardDbs.size(), nullptr);
+
+    *results = new RankingResult[matches.size()];
+    size_t count = 0;
+
+    for (const auto& match : matches) {
+        size_t shard = shardOfGlobalBlockId(match.second);
+        if (shard >= g_state->shardDbs.size()) {
+            continue; // Stale entry from a shard that no longer exists
+        }
+        if (!shardStmts[shard] &&
+            sqlite3_prepare_v2(g_state->shardDbs[shard], materializeSql, -1,
+                               &shardStmts[shard], nullptr) != SQLITE_OK) {
+            shardStmts[shard] = nullptr;
+            continue;
+        }
+        sqlite3_stmt* stmt = shardStmts[shard];
+        sqlite3_bind_int64(stmt, 1, rowidOfGlobalBlockId(match.second));
+
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            CodeBlock* block = new CodeBlock();
+            block->filePath = duplicateString(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+            block->name = duplicateString(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)));
+            block->content = duplicateString(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2)));
+            block->startLine = sqlite3_column_int(stmt, 3);
+            block->endLine = sqlite3_column_int(stmt, 4);
+            block->language = duplicateString(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 5)));
+            block->visibility = 2;
+            block->metadata = nullptr;
+
+            (*results)[count].block = block;
+            // Cosine similarity mapped to [0, 1] so weights merge cleanly
+            (*results)[count].score = (match.first + 1.0f) / 2.0f;
+            (*results)[count].rankingType = duplicateString("embedding");
+            count++;
+        }
+
+        sqlite3_reset(stmt);
+    }
+    for (sqlite3_stmt* shardStmt : shardStmts) {
+        if (shardStmt) {
+            sqlite3_finalize(shardStmt);
+        }
+    }
+
+    *numResults = count;
+    std::cout << "EmbeddingRankerPlugin: Ranked " << *numResults << " blocks" << std::endl;
+    return RAGGER_SUCCESS;
+}
+
+void ragger_ranker_free_results(RankingResult* results, size_t numResults) {
+    if (!results) return;
+
+    for (size_t i = 0; i < numResults; ++i) {
+        if (results[i].block) {
+            delete[] results[i].block->filePath;
+            delete[] results[i].block->name;
+            delete[] results[i].block->content;
+            delete[] results[i].block->language;
+            delete results[i].block;
+        }
+        delete[] results[i].rankingType;
+    }
+    delete[] results;
+}
+
+} // extern "C"
@@ -6,11 +6,14 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <thread>
 
 namespace {
 
-// Simplified graph representation using adjacency lists
-// In a real implementation, this would use Boost Graph Library with CSR format
+// Code graph stored as compressed sparse rows over dense integer node
+// ids. Node id strings are interned once on insertion; edges accumulate
+// in a flat list and are packed into CSR arrays before ranking, so a
+// PageRank iteration is a single O(E) sweep with no hashing.
 class CodeGraph {
 private:
     struct GraphNode {
@@ -19,79 +22,193 @@ private:
         std::string name;
         std::string filePath;
         int lineNumber;
-        float importance; // Node importance score
-        
-        GraphNode() : lineNumber(0), importance(0.0f) {}
-        GraphNode(const std::string& nodeId, const std::string& nodeType, 
+
+        GraphNode() : lineNumber(0) {}
+        GraphNode(const std::string& nodeId, const std::string& nodeType,
                  const std::string& nodeName, const std::string& file, int line)
-            : id(nodeId), type(nodeType), name(nodeName), filePath(file), 
-              lineNumber(line), importance(1.0f) {}
+            : id(nodeId), type(nodeType), name(nodeName), filePath(file),
+              lineNumber(line) {}
     };
 
-    std::unordered_map<std::string, GraphNode> nodes_;
-    std::unordered_map<std::string, std::vector<std::string>> adjacencyList_;
-    std::unordered_map<std::string, float> pagerankScores_;
-    
+    std::vector<GraphNode> nodes_;
+    std::unordered_map<std::string, int> nodeIndex_; // Interned id -> dense index
+
+    // Edge list accumulated by addEdge, packed into CSR by buildCSR
+    std::vector<std::pair<int, int>> edges_;
+    std::vector<int> rowOffsets_;     // size V+1
+    std::vector<int> columnIndices_;  // size E, destination per out-edge
+    bool csrDirty_;
+
+    std::vector<float> pagerankScores_; // Indexed by dense node id
+
+    int internNode(const std::string& id) {
+        auto it = nodeIndex_.find(id);
+        if (it != nodeIndex_.end()) {
+            return it->second;
+        }
+        int index = static_cast<int>(nodes_.size());
+        nodes_.emplace_back();
+        nodes_.back().id = id;
+        nodeIndex_[id] = index;
+        return index;
+    }
+
+    void buildCSR() {
+        if (!csrDirty_) return;
+
+        size_t numNodes = nodes_.size();
+        rowOffsets_.assign(numNodes + 1, 0);
+        columnIndices_.assign(edges_.size(), 0);
+
+        for (const auto& edge : edges_) {
+            rowOffsets_[edge.first + 1]++;
+        }
+        for (size_t i = 1; i <= numNodes; ++i) {
+            rowOffsets_[i] += rowOffsets_[i - 1];
+        }
+
+        std::vector<int> cursor(rowOffsets_.begin(), rowOffsets_.end() - 1);
+        for (const auto& edge : edges_) {
+            columnIndices_[cursor[edge.first]++] = edge.second;
+        }
+
+        csrDirty_ = false;
+    }
+
 public:
-    void addNode(const std::string& id, const std::string& type, 
+    CodeGraph() : csrDirty_(true) {}
+
+    void addNode(const std::string& id, const std::string& type,
                 const std::string& name, const std::string& filePath, int line) {
-        nodes_[id] = GraphNode(id, type, name, filePath, line);
+        int index = internNode(id);
+        nodes_[index].type = type;
+        nodes_[index].name = name;
+        nodes_[index].filePath = filePath;
+        nodes_[index].lineNumber = line;
     }
-    
+
     void addEdge(const std::string& from, const std::string& to) {
-        adjacencyList_[from].push_back(to);
+        edges_.emplace_back(internNode(from), internNode(to));
+        csrDirty_ = true;
     }
-    
-    // Simplified PageRank implementation
+
+    // Standard push-style PageRank over the CSR arrays: O(E) per iteration.
+    // Large graphs partition the vertex range across threads, each pushing
+    // into its own score buffer, followed by a parallel reduce — the buffers
+    // keep threads from contending on destination vertices.
     void calculatePageRank(int iterations = 10) {
+        size_t numNodes = nodes_.size();
+        if (numNodes == 0) {
+            pagerankScores_.clear();
+            return;
+        }
+
+        buildCSR();
+
+        size_t numThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        // Thread startup costs more than it saves on small graphs
+        static const size_t PARALLEL_THRESHOLD = 16 * 1024;
+        if (numNodes < PARALLEL_THRESHOLD) {
+            numThreads = 1;
+        }
+
         const float damping = 0.85f;
-        const float initialScore = 1.0f / nodes_.size();
-        
-        // Initialize scores
-        for (const auto& pair : nodes_) {
-            pagerankScores_[pair.first] = initialScore;
+        const float initialScore = 1.0f / numNodes;
+        pagerankScores_.assign(numNodes, initialScore);
+
+        std::vector<std::vector<float>> threadScores(numThreads);
+        for (auto& buffer : threadScores) {
+            buffer.assign(numNodes, 0.0f);
         }
-        
-        // Iterative PageRank calculation
+        std::vector<float> newScores(numNodes, 0.0f);
+
+        size_t chunk = (numNodes + numThreads - 1) / numThreads;
+
         for (int iter = 0; iter < iterations; ++iter) {
-            std::unordered_map<std::string, float> newScores;
-            
-            for (const auto& nodePair : nodes_) {
-                const std::string& nodeId = nodePair.first;
-                float newScore = (1.0f - damping) / nodes_.size();
-                
-                // Sum contributions from incoming links
-                for (const auto& otherPair : nodes_) {
-                    const std::string& otherId = otherPair.first;
-                    if (otherId != nodeId) {
-                        auto it = adjacencyList_.find(otherId);
-                        if (it != adjacencyList_.end()) {
-                            const auto& neighbors = it->second;
-                            if (std::find(neighbors.begin(), neighbors.end(), nodeId) != neighbors.end()) {
-                                newScore += damping * pagerankScores_[otherId] / neighbors.size();
-                            }
-                        }
+            // Mass from dangling nodes (no out-edges) spreads uniformly
+            float danglingMass = 0.0f;
+            for (size_t v = 0; v < numNodes; ++v) {
+                if (rowOffsets_[v + 1] == rowOffsets_[v]) {
+                    danglingMass += pagerankScores_[v];
+                }
+            }
+
+            float base = (1.0f - damping) / numNodes + damping * danglingMass / numNodes;
+
+            auto pushRange = [&](size_t threadIndex) {
+                std::vector<float>& local = threadScores[threadIndex];
+                std::fill(local.begin(), local.end(), 0.0f);
+
+                size_t begin = threadIndex * chunk;
+                size_t end = std::min(numNodes, begin + chunk);
+                for (size_t v = begin; v < end; ++v) {
+                    int edgeBegin = rowOffsets_[v];
+                    int edgeEnd = rowOffsets_[v + 1];
+                    if (edgeBegin == edgeEnd) continue;
+
+                    float contribution = damping * pagerankScores_[v] / (edgeEnd - edgeBegin);
+                    for (int e = edgeBegin; e < edgeEnd; ++e) {
+                        local[columnIndices_[e]] += contribution;
+                    }
+                }
+            };
+
+            auto reduceRange = [&](size_t threadIndex) {
+                size_t begin = threadIndex * chunk;
+                size_t end = std::min(numNodes, begin + chunk);
+                for (size_t v = begin; v < end; ++v) {
+                    float sum = base;
+                    for (size_t t = 0; t < numThreads; ++t) {
+                        sum += threadScores[t][v];
                     }
+                    newScores[v] = sum;
+                }
+            };
+
+            if (numThreads == 1) {
+                pushRange(0);
+                reduceRange(0);
+            } else {
+                std::vector<std::thread> threads;
+                for (size_t t = 0; t < numThreads; ++t) {
+                    threads.emplace_back(pushRange, t);
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+
+                threads.clear();
+                for (size_t t = 0; t < numThreads; ++t) {
+                    threads.emplace_back(reduceRange, t);
+                }
+                for (auto& thread : threads) {
+                    thread.join();
                 }
-                
-                newScores[nodeId] = newScore;
             }
-            
-            pagerankScores_ = std::move(newScores);
+
+            pagerankScores_.swap(newScores);
         }
     }
-    
+
     float getNodeScore(const std::string& nodeId) const {
-        auto it = pagerankScores_.find(nodeId);
-        return it != pagerankScores_.end() ? it->second : 0.0f;
+        auto it = nodeIndex_.find(nodeId);
+        if (it == nodeIndex_.end() ||
+            static_cast<size_t>(it->second) >= pagerankScores_.size()) {
+            return 0.0f;
+        }
+        return pagerankScores_[it->second];
     }
-    
+
     void clear() {
         nodes_.clear();
-        adjacencyList_.clear();
+        nodeIndex_.clear();
+        edges_.clear();
+        rowOffsets_.clear();
+        columnIndices_.clear();
         pagerankScores_.clear();
+        csrDirty_ = true;
     }
-    
+
     size_t getNodeCount() const {
         return nodes_.size();
     }
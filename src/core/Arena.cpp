@@ -0,0 +1,49 @@
+#include "Arena.h"
+#include <cstring>
+
+namespace Ragger {
+
+void* Arena::allocate(size_t size) {
+    if (size == 0) size = 1;
+    size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+    Chunk& chunk = chunkWithRoom(size);
+    void* pointer = chunk.data.get() + chunk.used;
+    chunk.used += size;
+    bytesAllocated_ += size;
+    return pointer;
+}
+
+char* Arena::duplicateString(const char* source) {
+    if (!source) return nullptr;
+    size_t length = strlen(source);
+    char* copy = static_cast<char*>(allocate(length + 1));
+    memcpy(copy, source, length + 1);
+    return copy;
+}
+
+void Arena::reset() {
+    if (chunks_.size() > 1) {
+        chunks_.resize(1);
+    }
+    if (!chunks_.empty()) {
+        chunks_.front().used = 0;
+    }
+    bytesAllocated_ = 0;
+}
+
+Arena::Chunk& Arena::chunkWithRoom(size_t size) {
+    if (!chunks_.empty()) {
+        Chunk& current = chunks_.back();
+        if (current.capacity - current.used >= size) {
+            return current;
+        }
+    }
+
+    // Oversize requests get a dedicated chunk; normal ones a fresh block
+    size_t capacity = size > CHUNK_SIZE ? size : CHUNK_SIZE;
+    chunks_.push_back(Chunk{std::make_unique<char[]>(capacity), capacity, 0});
+    return chunks_.back();
+}
+
+} // namespace Ragger
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Ragger {
+
+// Bump allocator for per-request object graphs (CodeBlocks, strings,
+// result arrays). Allocations are pointer bumps into fixed-size chunks
+// and are never freed individually; destroying or resetting the arena
+// releases everything in one operation. Not thread-safe — one arena
+// serves one request.
+class Arena {
+public:
+    Arena() = default;
+    ~Arena() = default;
+
+    // Aligned for any object type; never returns nullptr (throws
+    // std::bad_alloc like the rest of the allocation paths)
+    void* allocate(size_t size);
+
+    // Arena-backed copy of a NUL-terminated string (nullptr passes through)
+    char* duplicateString(const char* source);
+
+    // Typed array helper for the plain C structs crossing the plugin ABI
+    template <typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "arena memory is reclaimed without running destructors");
+        T* array = static_cast<T*>(allocate(sizeof(T) * count));
+        for (size_t i = 0; i < count; i++) {
+            new (&array[i]) T();
+        }
+        return array;
+    }
+
+    // Drop all allocations but keep the first chunk for reuse
+    void reset();
+
+    size_t bytesAllocated() const { return bytesAllocated_; }
+
+private:
+    static const size_t CHUNK_SIZE = 64 * 1024;
+    static const size_t ALIGNMENT = alignof(std::max_align_t);
+
+    struct Chunk {
+        std::unique_ptr<char[]> data;
+        size_t capacity;
+        size_t used;
+    };
+
+    std::vector<Chunk> chunks_;
+    size_t bytesAllocated_ = 0;
+
+    Chunk& chunkWithRoom(size_t size);
+
+    // Prevent copying
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+};
+
+} // namespace Ragger
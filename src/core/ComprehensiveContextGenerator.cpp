@@ -1,4 +1,5 @@
 #include "ComprehensiveContextGenerator.h"
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -8,8 +9,8 @@
 namespace Ragger {
 namespace Core {
 
-ComprehensiveContextGenerator::ComprehensiveContextGenerator() 
-    : m_initialized(false) {
+ComprehensiveContextGenerator::ComprehensiveContextGenerator()
+    : m_initialized(false), m_contextBudget(std::chrono::milliseconds(500)) {
 }
 
 ComprehensiveContextGenerator::~ComprehensiveContextGenerator() {
@@ -41,6 +42,18 @@ bool ComprehensiveContextGenerator::initialize() {
 }
 
 void ComprehensiveContextGenerator::cleanup() {
+    // Wait for any abandoned pillars before unloading the libraries they
+    // may still be executing in
+    {
+        std::lock_guard<std::mutex> lock(m_pillarMutex);
+        for (auto& pillar : m_abandonedPillars) {
+            if (pillar.valid()) {
+                pillar.wait();
+            }
+        }
+        m_abandonedPillars.clear();
+    }
+
     for (auto& plugin : m_plugins) {
         if (plugin.handle) {
             dlclose(plugin.handle);
@@ -97,23 +110,83 @@ std::string ComprehensiveContextGenerator::generateComprehensiveContext(
         initialize();
     }
     
+    pruneAbandonedPillars();
+
+    // Dispatch the three pillars concurrently: latency becomes the slowest
+    // pillar instead of the sum of all three
+    auto gitFuture = std::async(std::launch::async, [this, filePath, startLine, endLine]() {
+        return generateGitContext(filePath, startLine, endLine);
+    });
+    auto analysisFuture = std::async(std::launch::async, [this, filePath]() {
+        return generateStaticAnalysisContext(filePath);
+    });
+    auto docsFuture = std::async(std::launch::async, [this, filePath, query]() {
+        return generateDocumentationContext(filePath, query);
+    });
+
+    // All pillars share one deadline; sections are assembled in fixed order
+    // as their results arrive, so one slow pillar (usually git on a cold
+    // cache) cannot push the whole prompt past the budget
+    const auto deadline = std::chrono::steady_clock::now() + m_contextBudget;
+
+    auto collectPillar = [this, deadline](std::future<std::string>& pillar,
+                                          const char* sectionHeader,
+                                          const char* pillarName) -> std::string {
+        auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining < std::chrono::steady_clock::duration::zero()) {
+            remaining = std::chrono::steady_clock::duration::zero();
+        }
+        if (pillar.wait_for(remaining) == std::future_status::ready) {
+            return pillar.get();
+        }
+
+        // Partial-result mode: park the overdue future (its destructor
+        // would block) and ship a placeholder section instead
+        std::cout << "ComprehensiveContextGenerator: " << pillarName
+                  << " pillar missed the " << m_contextBudget.count()
+                  << "ms budget, emitting partial context" << std::endl;
+        {
+            std::lock_guard<std::mutex> lock(m_pillarMutex);
+            m_abandonedPillars.push_back(std::move(pillar));
+        }
+        std::string placeholder = sectionHeader;
+        placeholder += "* **Status:** Not available within the context budget.\n";
+        return placeholder;
+    };
+
     std::string context = "=== COMPREHENSIVE RAG CONTEXT ===\n\n";
-    
-    // Generate Git Context
-    context += generateGitContext(filePath, startLine, endLine);
+    context += collectPillar(gitFuture, "### GIT CONTEXT\n", "git");
     context += "\n";
-    
-    // Generate Static Analysis Context
-    context += generateStaticAnalysisContext(filePath);
+    context += collectPillar(analysisFuture, "### PROJECT STANDARDS & ANALYSIS\n", "static analysis");
     context += "\n";
-    
-    // Generate Documentation Context
-    context += generateDocumentationContext(filePath, query);
+    context += collectPillar(docsFuture, "### RELEVANT DOCUMENTATION\n", "documentation");
     context += "\n";
-    
+
     return context;
 }
 
+void ComprehensiveContextGenerator::setContextBudget(std::chrono::milliseconds budget) {
+    if (budget.count() > 0) {
+        m_contextBudget = budget;
+    }
+}
+
+std::chrono::milliseconds ComprehensiveContextGenerator::getContextBudget() const {
+    return m_contextBudget;
+}
+
+void ComprehensiveContextGenerator::pruneAbandonedPillars() {
+    std::lock_guard<std::mutex> lock(m_pillarMutex);
+    m_abandonedPillars.erase(
+        std::remove_if(m_abandonedPillars.begin(), m_abandonedPillars.end(),
+                       [](std::future<std::string>& pillar) {
+                           return !pillar.valid() ||
+                                  pillar.wait_for(std::chrono::seconds(0)) ==
+                                      std::future_status::ready;
+                       }),
+        m_abandonedPillars.end());
+}
+
 std::string ComprehensiveContextGenerator::generateGitContext(const std::string& filePath, int startLine, int endLine) {
     // For now, we'll use a simplified implementation
     // In a full implementation, this would call the GitContextPlugin
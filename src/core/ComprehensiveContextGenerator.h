@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+#include <future>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <memory>
@@ -24,13 +27,20 @@ public:
     // Cleanup resources
     void cleanup();
     
-    // Main function to generate comprehensive context
+    // Main function to generate comprehensive context. The three pillars
+    // (git, static analysis, documentation) run concurrently; each gets a
+    // slice of the overall budget and a pillar that misses its deadline is
+    // replaced by a placeholder so the prompt still ships on time.
     std::string generateComprehensiveContext(
-        const std::string& filePath, 
-        const std::string& query, 
-        int startLine = 1, 
+        const std::string& filePath,
+        const std::string& query,
+        int startLine = 1,
         int endLine = 100);
 
+    // Overall latency budget for one context generation (default 500ms)
+    void setContextBudget(std::chrono::milliseconds budget);
+    std::chrono::milliseconds getContextBudget() const;
+
 private:
     // Load a specific plugin
     bool loadPlugin(const std::string& pluginName, const std::string& pluginClass);
@@ -40,9 +50,20 @@ private:
     std::string generateStaticAnalysisContext(const std::string& filePath);
     std::string generateDocumentationContext(const std::string& filePath, const std::string& query);
     
+    // Drop abandoned pillar futures that have since finished; waiting
+    // happens only in cleanup() so the request path never blocks on them
+    void pruneAbandonedPillars();
+
     // Plugin management
     std::vector<PluginInfo> m_plugins;
     bool m_initialized;
+
+    // Latency budget and pillars that overran it. An std::async future
+    // blocks in its destructor, so a timed-out pillar is parked here and
+    // collected later instead of stalling the caller.
+    std::chrono::milliseconds m_contextBudget;
+    std::vector<std::future<std::string>> m_abandonedPillars;
+    std::mutex m_pillarMutex;
 };
 
 } // namespace Core
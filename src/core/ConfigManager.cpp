@@ -8,6 +8,32 @@
 
 namespace Ragger {
 
+// One row per ConfigKey, in enum order; setDefaultValues walks this
+// table, so adding a key here is all a new setting needs
+const std::array<ConfigManager::KeyDescriptor, static_cast<size_t>(ConfigKey::COUNT)>
+ConfigManager::KEY_SCHEMA = {{
+    {"app.name",                        ValueType::String, "RAGger"},
+    {"app.version",                     ValueType::String, "0.1.0"},
+    {"app.log_level",                   ValueType::String, "info"},
+    {"indexing.max_file_size",          ValueType::Int,    "10485760"}, // 10MB
+    {"indexing.enable_incremental",     ValueType::Bool,   "true"},
+    {"indexing.debounce_ms",            ValueType::Int,    "500"},
+    {"indexing.database_path",          ValueType::String, "data/index.db"},
+    {"plugins.enable_sandbox",          ValueType::Bool,   "false"},
+    {"plugins.user_dir",                ValueType::String, "~/.ragger/plugins"},
+    {"plugins.project_dir",             ValueType::String, ".ragger/plugins"},
+    {"ui.backend",                      ValueType::String, "imgui"}, // or "qt"
+    {"ui.max_context_tokens",           ValueType::Int,    "8000"},
+    {"ui.show_token_count",             ValueType::Bool,   "true"},
+    {"llm.temperature",                 ValueType::Float,  "0.7"},
+    {"llm.max_tokens",                  ValueType::Int,    "2048"},
+    {"llm.default_model",               ValueType::String, "gpt-3.5-turbo"},
+    {"performance.thread_pool_size",    ValueType::Int,    "4"},
+    {"performance.memory_limit_mb",     ValueType::Int,    "512"},
+    {"performance.enable_caching",      ValueType::Bool,   "true"},
+    {"tokenizer.vocab_path",            ValueType::String, ""},
+}};
+
 ConfigManager::ConfigManager() : envOverrideEnabled_(true) {
     setDefaultValues();
 }
@@ -45,6 +71,13 @@ int ConfigManager::loadFromFile(const fs::path& configFile) {
 
                 // Store as string for now
                 config_[key] = value;
+
+                // Schema keys are parsed once here, not on every access
+                int schemaIndex = schemaIndexForName(key);
+                if (schemaIndex >= 0) {
+                    refreshTypedValue(static_cast<size_t>(schemaIndex), value);
+                    notifyChange(static_cast<ConfigKey>(schemaIndex));
+                }
             }
         }
 
@@ -182,19 +215,139 @@ int ConfigManager::getFloat(const std::string& key, float* value) const {
 }
 
 void ConfigManager::setString(const std::string& key, const std::string& value) {
-    config_[formatKey(key)] = value;
+    std::string fullKey = formatKey(key);
+    config_[fullKey] = value;
+
+    int schemaIndex = schemaIndexForName(fullKey);
+    if (schemaIndex >= 0) {
+        refreshTypedValue(static_cast<size_t>(schemaIndex), value);
+        notifyChange(static_cast<ConfigKey>(schemaIndex));
+    }
 }
 
 void ConfigManager::setInt(const std::string& key, int value) {
-    config_[formatKey(key)] = value;
+    std::string fullKey = formatKey(key);
+    config_[fullKey] = value;
+
+    int schemaIndex = schemaIndexForName(fullKey);
+    if (schemaIndex >= 0) {
+        refreshTypedValue(static_cast<size_t>(schemaIndex), std::to_string(value));
+        notifyChange(static_cast<ConfigKey>(schemaIndex));
+    }
 }
 
 void ConfigManager::setFloat(const std::string& key, float value) {
-    config_[formatKey(key)] = value;
+    std::string fullKey = formatKey(key);
+    config_[fullKey] = value;
+
+    int schemaIndex = schemaIndexForName(fullKey);
+    if (schemaIndex >= 0) {
+        refreshTypedValue(static_cast<size_t>(schemaIndex), std::to_string(value));
+        notifyChange(static_cast<ConfigKey>(schemaIndex));
+    }
 }
 
 void ConfigManager::setBool(const std::string& key, bool value) {
-    config_[formatKey(key)] = value;
+    std::string fullKey = formatKey(key);
+    config_[fullKey] = value;
+
+    int schemaIndex = schemaIndexForName(fullKey);
+    if (schemaIndex >= 0) {
+        refreshTypedValue(static_cast<size_t>(schemaIndex), value ? "true" : "false");
+        notifyChange(static_cast<ConfigKey>(schemaIndex));
+    }
+}
+
+const char* ConfigManager::getString(ConfigKey key) const {
+    return typedValues_[static_cast<size_t>(key)].stringValue.c_str();
+}
+
+int ConfigManager::getInt(ConfigKey key) const {
+    return typedValues_[static_cast<size_t>(key)].intValue;
+}
+
+float ConfigManager::getFloat(ConfigKey key) const {
+    return typedValues_[static_cast<size_t>(key)].floatValue;
+}
+
+bool ConfigManager::getBool(ConfigKey key) const {
+    return typedValues_[static_cast<size_t>(key)].boolValue;
+}
+
+int ConfigManager::subscribeChanges(ChangeCallback callback, void* userData) {
+    if (!callback) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+    changeListeners_.emplace_back(callback, userData);
+    return RAGGER_SUCCESS;
+}
+
+int ConfigManager::unsubscribeChanges(ChangeCallback callback) {
+    auto it = std::remove_if(changeListeners_.begin(), changeListeners_.end(),
+        [callback](const std::pair<ChangeCallback, void*>& listener) {
+            return listener.first == callback;
+        });
+    if (it == changeListeners_.end()) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+    changeListeners_.erase(it, changeListeners_.end());
+    return RAGGER_SUCCESS;
+}
+
+int ConfigManager::schemaIndexForName(const std::string& name) {
+    for (size_t i = 0; i < KEY_SCHEMA.size(); ++i) {
+        if (name == KEY_SCHEMA[i].name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void ConfigManager::refreshTypedValue(size_t index, const std::string& raw) {
+    const KeyDescriptor& descriptor = KEY_SCHEMA[index];
+    TypedSlot& slot = typedValues_[index];
+
+    // Environment overrides win; resolving them here keeps getenv off
+    // the read path
+    std::string effective = raw;
+    if (envOverrideEnabled_) {
+        std::string envValue = getEnvOverride(descriptor.name);
+        if (!envValue.empty()) {
+            effective = envValue;
+        }
+    }
+
+    slot.stringValue = effective;
+    switch (descriptor.type) {
+        case ValueType::Int:
+            try {
+                slot.intValue = std::stoi(effective);
+            } catch (...) {
+                std::cerr << "ConfigManager: Invalid integer for " << descriptor.name
+                          << ": '" << effective << "'" << std::endl;
+            }
+            slot.floatValue = static_cast<float>(slot.intValue);
+            break;
+        case ValueType::Float:
+            try {
+                slot.floatValue = std::stof(effective);
+            } catch (...) {
+                std::cerr << "ConfigManager: Invalid float for " << descriptor.name
+                          << ": '" << effective << "'" << std::endl;
+            }
+            break;
+        case ValueType::Bool:
+            slot.boolValue = (effective == "true" || effective == "1" || effective == "yes");
+            break;
+        case ValueType::String:
+            break;
+    }
+}
+
+void ConfigManager::notifyChange(ConfigKey key) {
+    for (const auto& listener : changeListeners_) {
+        listener.first(key, listener.second);
+    }
 }
 
 bool ConfigManager::hasKey(const std::string& key) const {
@@ -273,36 +426,28 @@ std::string ConfigManager::makeKey(const std::string& section, const std::string
 }
 
 void ConfigManager::setDefaultValues() {
-    // Core settings
-    setString("app.name", "RAGger");
-    setString("app.version", "0.1.0");
-    setString("app.log_level", "info");
-
-    // Indexing settings
-    setInt("indexing.max_file_size", 10485760); // 10MB
-    setBool("indexing.enable_incremental", true);
-    setInt("indexing.debounce_ms", 500);
-    setString("indexing.database_path", "data/index.db");
-
-    // Plugin settings
-    setBool("plugins.enable_sandbox", false);
-    setString("plugins.user_dir", "~/.ragger/plugins");
-    setString("plugins.project_dir", ".ragger/plugins");
-
-    // UI settings
-    setString("ui.backend", "imgui"); // or "qt"
-    setInt("ui.max_context_tokens", 8000);
-    setBool("ui.show_token_count", true);
-
-    // LLM settings
-    setFloat("llm.temperature", 0.7f);
-    setInt("llm.max_tokens", 2048);
-    setString("llm.default_model", "gpt-3.5-turbo");
-
-    // Performance settings
-    setInt("performance.thread_pool_size", 4);
-    setInt("performance.memory_limit_mb", 512);
-    setBool("performance.enable_caching", true);
+    // Everything comes from the schema table; defaults go through the
+    // same parse path as loaded values
+    for (size_t i = 0; i < KEY_SCHEMA.size(); ++i) {
+        const KeyDescriptor& descriptor = KEY_SCHEMA[i];
+        std::string raw = descriptor.defaultValue;
+
+        switch (descriptor.type) {
+            case ValueType::String:
+                config_[descriptor.name] = raw;
+                break;
+            case ValueType::Int:
+                config_[descriptor.name] = std::stoi(raw);
+                break;
+            case ValueType::Float:
+                config_[descriptor.name] = std::stof(raw);
+                break;
+            case ValueType::Bool:
+                config_[descriptor.name] = (raw == "true");
+                break;
+        }
+        refreshTypedValue(i, raw);
+    }
 }
 
 // JSON methods disabled - using simple key=value format instead
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <string>
 #include <unordered_map>
 #include <variant>
@@ -12,6 +13,34 @@ namespace fs = std::filesystem;
 
 namespace Ragger {
 
+// Compile-time configuration keys. Every key is registered once in the
+// schema table (ConfigManager.cpp) with its type and default; values are
+// parsed when set, so hot-path reads are a dense array index instead of
+// a map lookup plus string conversion.
+enum class ConfigKey : size_t {
+    APP_NAME = 0,
+    APP_VERSION,
+    APP_LOG_LEVEL,
+    INDEXING_MAX_FILE_SIZE,
+    INDEXING_ENABLE_INCREMENTAL,
+    INDEXING_DEBOUNCE_MS,
+    INDEXING_DATABASE_PATH,
+    PLUGINS_ENABLE_SANDBOX,
+    PLUGINS_USER_DIR,
+    PLUGINS_PROJECT_DIR,
+    UI_BACKEND,
+    UI_MAX_CONTEXT_TOKENS,
+    UI_SHOW_TOKEN_COUNT,
+    LLM_TEMPERATURE,
+    LLM_MAX_TOKENS,
+    LLM_DEFAULT_MODEL,
+    PERFORMANCE_THREAD_POOL_SIZE,
+    PERFORMANCE_MEMORY_LIMIT_MB,
+    PERFORMANCE_ENABLE_CACHING,
+    TOKENIZER_VOCAB_PATH,
+    COUNT
+};
+
 class ConfigManager {
 public:
     ConfigManager();
@@ -27,6 +56,19 @@ public:
     int getInt(const std::string& key, int* value) const;
     int getFloat(const std::string& key, float* value) const;
 
+    // Typed retrieval: values were parsed when set, so these are plain
+    // array reads with no hashing or conversion
+    const char* getString(ConfigKey key) const;
+    int getInt(ConfigKey key) const;
+    float getFloat(ConfigKey key) const;
+    bool getBool(ConfigKey key) const;
+
+    // Change notification so consumers can cache values instead of
+    // polling per event
+    using ChangeCallback = void (*)(ConfigKey key, void* userData);
+    int subscribeChanges(ChangeCallback callback, void* userData);
+    int unsubscribeChanges(ChangeCallback callback);
+
     // Value setting
     void setString(const std::string& key, const std::string& value);
     void setInt(const std::string& key, int value);
@@ -54,7 +96,28 @@ public:
 private:
     using ConfigValue = std::variant<std::string, int, float, bool>;
 
+    enum class ValueType { String, Int, Float, Bool };
+
+    // Schema entry: canonical key name, type, and default (as text)
+    struct KeyDescriptor {
+        const char* name;
+        ValueType type;
+        const char* defaultValue;
+    };
+
+    // Parsed value slot in the dense table
+    struct TypedSlot {
+        std::string stringValue;
+        int intValue = 0;
+        float floatValue = 0.0f;
+        bool boolValue = false;
+    };
+
+    static const std::array<KeyDescriptor, static_cast<size_t>(ConfigKey::COUNT)> KEY_SCHEMA;
+
     std::unordered_map<std::string, ConfigValue> config_;
+    std::array<TypedSlot, static_cast<size_t>(ConfigKey::COUNT)> typedValues_;
+    std::vector<std::pair<ChangeCallback, void*>> changeListeners_;
     std::string currentSection_;
     bool envOverrideEnabled_;
 
@@ -72,6 +135,11 @@ private:
     // Environment variable handling
     std::string getEnvOverride(const std::string& key) const;
 
+    // Typed table maintenance
+    static int schemaIndexForName(const std::string& name); // -1 if not a schema key
+    void refreshTypedValue(size_t index, const std::string& raw);
+    void notifyChange(ConfigKey key);
+
     // Validation helpers
     bool validateRequiredKeys() const;
     bool validateValueRanges() const;
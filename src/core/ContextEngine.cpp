@@ -1,43 +1,475 @@
 #include "ContextEngine.h"
+#include "IndexManager.h"
+#include "PluginManager.h"
+#include "Trace.h"
 #include "ragger_plugin_api.h"
 // spdlog disabled
 #include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace Ragger {
 
+namespace {
+
+// Deep-copy a ranker-owned block into the response arena so the
+// ranker's results can be freed
+CodeBlock* cloneBlock(Arena& arena, const CodeBlock* block) {
+    CodeBlock* copy = static_cast<CodeBlock*>(arena.allocate(sizeof(CodeBlock)));
+    copy->name = arena.duplicateString(block->name);
+    copy->content = arena.duplicateString(block->content);
+    copy->filePath = arena.duplicateString(block->filePath);
+    copy->startLine = block->startLine;
+    copy->endLine = block->endLine;
+    copy->language = arena.duplicateString(block->language);
+    copy->visibility = block->visibility;
+    copy->metadata = nullptr; // Plugin-specific data stays with the plugin
+    return copy;
+}
+
+// Identity key for deduplication across rankers
+std::string blockKey(const CodeBlock* block) {
+    std::string key = block->filePath ? block->filePath : "";
+    key += ':';
+    key += std::to_string(block->startLine);
+    key += '-';
+    key += std::to_string(block->endLine);
+    return key;
+}
+
+// accumulator[i] += weight * lane[i] over a contiguous score lane.
+// SSE2 processes four floats per step; the scalar tail handles the rest.
+void accumulateWeighted(float* accumulator, const float* lane, size_t count, float weight) {
+    size_t i = 0;
+
+#ifdef __SSE2__
+    __m128 w = _mm_set1_ps(weight);
+    for (; i + 4 <= count; i += 4) {
+        __m128 acc = _mm_loadu_ps(accumulator + i);
+        __m128 scores = _mm_loadu_ps(lane + i);
+        acc = _mm_add_ps(acc, _mm_mul_ps(scores, w));
+        _mm_storeu_ps(accumulator + i, acc);
+    }
+#endif
+
+    for (; i < count; i++) {
+        accumulator[i] += weight * lane[i];
+    }
+}
+
+} // anonymous namespace
+
 ContextEngine::ContextEngine(RaggerCoreAPI* coreAPI)
-    : coreAPI_(coreAPI), maxContextTokens_(8000) {
+    : coreAPI_(coreAPI), pluginManager_(nullptr), maxContextTokens_(8000),
+      indexManager_(nullptr), cacheBytes_(0), cacheBudget_(DEFAULT_CACHE_BUDGET) {
     // Default ranking weights (BM25, Graph, TF-IDF)
     rankingWeights_ = {0.6f, 0.3f, 0.1f};
     loadDefaultTemplates();
+
+    // Exact BPE counts when a vocabulary is configured; otherwise the
+    // counter's piece-based heuristic is used
+    const char* vocabPath = nullptr;
+    if (coreAPI_ && coreAPI_->get_config_string &&
+        coreAPI_->get_config_string("tokenizer.vocab_path", &vocabPath) == RAGGER_SUCCESS &&
+        vocabPath && vocabPath[0] != '\0') {
+        if (!tokenCounter_.loadVocabulary(vocabPath)) {
+            std::cout << "ContextEngine: Could not load tokenizer vocabulary from "
+                      << vocabPath << ", using heuristic token counts" << std::endl;
+        }
+    }
+}
+
+void ContextEngine::setPluginManager(PluginManager* pluginManager) {
+    pluginManager_ = pluginManager;
+}
+
+void ContextEngine::setIndexManager(IndexManager* indexManager) {
+    indexManager_ = indexManager;
 }
 
 int ContextEngine::generateContext(const ContextRequest* request, ContextResponse** response) {
+    RAGGER_TRACE_SPAN("generate-context");
+
     if (!request || !response) {
         return RAGGER_ERROR_INVALID_ARGUMENT;
     }
 
-    *response = new ContextResponse();
+    // Warm repeats of the same (query, block, weights) come straight out
+    // of the response cache without touching the rankers
+    std::string cacheKey;
+    if (cacheBudget_ > 0) {
+        cacheKey = cacheKeyFor(request);
+        if (lookupCachedResponse(cacheKey, response)) {
+            return RAGGER_SUCCESS;
+        }
+    }
+
+    // Everything reachable from the response lives in one arena, freed
+    // as a unit in freeResponse — no per-string delete pairs across DSOs
+    auto arena = std::make_unique<Arena>();
+
+    *response = static_cast<ContextResponse*>(arena->allocate(sizeof(ContextResponse)));
     (*response)->numResults = 0;
     (*response)->results = nullptr;
     (*response)->totalTokens = 0;
-    (*response)->promptTemplate = nullptr;
+    (*response)->promptTemplate = arena->duplicateString("default");
+
+    // Fan out to all loaded rankers, fuse their scores, and fill the
+    // response under the token budget
+    std::vector<RankerRun> runs = dispatchRankers(request);
+    int result = fillResponse(request, runs, *arena, *response);
+
+    // Return ranker-owned arrays now that winners are deep-copied
+    for (RankerRun& run : runs) {
+        if (run.results && run.api->free_results) {
+            run.api->free_results(run.results, run.numResults);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(arenaMutex_);
+        responseArenas_[*response] = std::move(arena);
+    }
+
+    if (result == RAGGER_SUCCESS && cacheBudget_ > 0) {
+        storeCachedResponse(cacheKey, *response);
+    }
+
+    return result;
+}
+
+// Cache key: the inputs that determine the response bit-for-bit. Index
+// state is handled separately via generations so an unrelated edit does
+// not change the key of every outstanding entry.
+std::string ContextEngine::cacheKeyFor(const ContextRequest* request) const {
+    std::string key = request->userQuery ? request->userQuery : "";
+    key += '\x1f';
+    if (request->primaryBlock) {
+        key += blockKey(request->primaryBlock);
+    }
+    key += '\x1f';
+    for (float weight : rankingWeights_) {
+        key += std::to_string(weight);
+        key += ',';
+    }
+    key += '\x1f';
+    key += std::to_string(request->maxTokens);
+    return key;
+}
+
+// An entry built at an older generation is still good as long as none of
+// its contributing files changed since; refresh its generation so the
+// per-file checks don't repeat on every hit
+bool ContextEngine::cachedEntryStillValid(CachedResponse& entry, uint64_t currentGeneration) {
+    if (entry.generation == currentGeneration || !indexManager_) {
+        return true;
+    }
+    for (const std::string& filePath : entry.contributingFiles) {
+        if (indexManager_->getFileGeneration(filePath) > entry.generation) {
+            return false;
+        }
+    }
+    entry.generation = currentGeneration;
+    return true;
+}
+
+bool ContextEngine::lookupCachedResponse(const std::string& key, ContextResponse** response) {
+    uint64_t currentGeneration = indexManager_ ? indexManager_->getIndexGeneration() : 0;
+
+    CachedResponse snapshot;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto it = cacheMap_.find(key);
+        if (it == cacheMap_.end()) {
+            return false;
+        }
+        if (!cachedEntryStillValid(*it->second, currentGeneration)) {
+            cacheBytes_ -= it->second->byteSize;
+            cacheList_.erase(it->second);
+            cacheMap_.erase(it);
+            return false;
+        }
+        // Move to the MRU position and copy out under the lock; the
+        // arena materialization below doesn't need it held
+        cacheList_.splice(cacheList_.begin(), cacheList_, it->second);
+        snapshot = cacheList_.front();
+    }
+
+    // Materialize a fresh arena-backed response so freeResponse keeps its
+    // usual semantics for cached and uncached responses alike
+    auto arena = std::make_unique<Arena>();
+    *response = static_cast<ContextResponse*>(arena->allocate(sizeof(ContextResponse)));
+    (*response)->numResults = snapshot.blocks.size();
+    (*response)->results = nullptr;
+    (*response)->totalTokens = snapshot.totalTokens;
+    (*response)->promptTemplate = arena->duplicateString("default");
+
+    if (!snapshot.blocks.empty()) {
+        (*response)->results = arena->allocateArray<RankingResult>(snapshot.blocks.size());
+        for (size_t i = 0; i < snapshot.blocks.size(); i++) {
+            const CachedBlock& cached = snapshot.blocks[i];
+            CodeBlock* block = static_cast<CodeBlock*>(arena->allocate(sizeof(CodeBlock)));
+            block->name = arena->duplicateString(cached.name.c_str());
+            block->content = arena->duplicateString(cached.content.c_str());
+            block->filePath = arena->duplicateString(cached.filePath.c_str());
+            block->startLine = cached.startLine;
+            block->endLine = cached.endLine;
+            block->language = arena->duplicateString(cached.language.c_str());
+            block->visibility = cached.visibility;
+            block->metadata = nullptr;
+
+            (*response)->results[i].block = block;
+            (*response)->results[i].score = cached.score;
+            (*response)->results[i].rankingType = arena->duplicateString("hybrid");
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(arenaMutex_);
+    responseArenas_[*response] = std::move(arena);
+    return true;
+}
+
+void ContextEngine::storeCachedResponse(const std::string& key, const ContextResponse* response) {
+    CachedResponse entry;
+    entry.key = key;
+    entry.generation = indexManager_ ? indexManager_->getIndexGeneration() : 0;
+    entry.totalTokens = response->totalTokens;
+    entry.byteSize = sizeof(CachedResponse) + key.size();
+
+    entry.blocks.reserve(response->numResults);
+    for (size_t i = 0; i < response->numResults; i++) {
+        const CodeBlock* block = response->results[i].block;
+        if (!block) continue;
+
+        CachedBlock cached;
+        cached.name = block->name ? block->name : "";
+        cached.content = block->content ? block->content : "";
+        cached.filePath = block->filePath ? block->filePath : "";
+        cached.language = block->language ? block->language : "";
+        cached.startLine = block->startLine;
+        cached.endLine = block->endLine;
+        cached.visibility = block->visibility;
+        cached.score = response->results[i].score;
+
+        entry.byteSize += sizeof(CachedBlock) + cached.name.size() + cached.content.size() +
+                          cached.filePath.size() + cached.language.size();
+        if (!cached.filePath.empty() &&
+            std::find(entry.contributingFiles.begin(), entry.contributingFiles.end(),
+                      cached.filePath) == entry.contributingFiles.end()) {
+            entry.contributingFiles.push_back(cached.filePath);
+        }
+        entry.blocks.push_back(std::move(cached));
+    }
+
+    if (entry.byteSize > cacheBudget_) {
+        return; // A single oversized response would evict everything else
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+
+    auto existing = cacheMap_.find(key);
+    if (existing != cacheMap_.end()) {
+        cacheBytes_ -= existing->second->byteSize;
+        cacheList_.erase(existing->second);
+        cacheMap_.erase(existing);
+    }
+
+    cacheBytes_ += entry.byteSize;
+    cacheList_.push_front(std::move(entry));
+    cacheMap_[key] = cacheList_.begin();
+
+    // Evict least recently used entries until the byte budget holds
+    while (cacheBytes_ > cacheBudget_ && !cacheList_.empty()) {
+        CachedResponse& victim = cacheList_.back();
+        cacheBytes_ -= victim.byteSize;
+        cacheMap_.erase(victim.key);
+        cacheList_.pop_back();
+    }
+}
+
+void ContextEngine::setContextCacheBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    cacheBudget_ = bytes;
+    while (cacheBytes_ > cacheBudget_ && !cacheList_.empty()) {
+        CachedResponse& victim = cacheList_.back();
+        cacheBytes_ -= victim.byteSize;
+        cacheMap_.erase(victim.key);
+        cacheList_.pop_back();
+    }
+}
+
+void ContextEngine::clearContextCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    cacheList_.clear();
+    cacheMap_.clear();
+    cacheBytes_ = 0;
+}
+
+// Run every loaded PLUGIN_TYPE_RANKER concurrently. BM25 and graph
+// ranking have very different latencies; paying the max instead of the
+// sum is the point of the fan-out.
+std::vector<ContextEngine::RankerRun> ContextEngine::dispatchRankers(const ContextRequest* request) {
+    RAGGER_TRACE_SPAN("rank");
 
-    // TODO: In a full implementation, this would:
-    // 1. Query ranking plugins with the request
-    // 2. Aggregate and filter results
-    // 3. Build context using templates
+    std::vector<RankerRun> runs;
+    if (!pluginManager_) {
+        return runs;
+    }
+
+    // No-op for eagerly loaded plugins; under lazy loading this is the
+    // point where rankers actually get initialized
+    pluginManager_->activatePluginsOfType(PLUGIN_TYPE_RANKER);
+
+    // Iterate the manager's registry keys: interfaces are looked up by
+    // the path-derived name plugins are registered under, not by the
+    // display name they self-report
+    for (const std::string& name : pluginManager_->getLoadedPlugins()) {
+        if (pluginManager_->getPluginType(name) != PLUGIN_TYPE_RANKER) {
+            continue;
+        }
+        const PluginInterface* interface = pluginManager_->getPluginInterface(name);
+        if (!interface || !interface->api) {
+            continue;
+        }
+        const RankerPluginAPI* api = static_cast<const RankerPluginAPI*>(interface->api);
+        if (!api->rank_blocks) {
+            continue;
+        }
+
+        RankerRun run;
+        run.api = api;
+        run.rankingType = api->get_ranking_type ? api->get_ranking_type() : name;
+        runs.push_back(std::move(run));
+    }
 
-    // Debug: Generated context for request
+    std::vector<std::thread> workers;
+    workers.reserve(runs.size());
+    for (RankerRun& run : runs) {
+        const char* traceStage = Trace::instance().internStageName("rank:" + run.rankingType);
+        workers.emplace_back([&run, request, traceStage]() {
+            TraceSpan span(traceStage); // Per-ranker attribution in profiles
+            run.status = run.api->rank_blocks(request, &run.results, &run.numResults);
+            if (run.status != RAGGER_SUCCESS) {
+                run.results = nullptr;
+                run.numResults = 0;
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    return runs;
+}
 
-    // Placeholder: set basic template with bounds checking
-    static const char* defaultTemplate = "default";
-    size_t templateLen = strlen(defaultTemplate);
-    (*response)->promptTemplate = new char[templateLen + 1];
-    strncpy(const_cast<char*>((*response)->promptTemplate), defaultTemplate, templateLen);
-    const_cast<char*>((*response)->promptTemplate)[templateLen] = '\0';
+// Map a ranker's self-reported type onto the configured fusion weights
+// (BM25, Graph, TF-IDF); unknown types fall into the last slot. Keys
+// must match what the rankers' get_ranking_type exports return.
+float ContextEngine::weightForRankingType(const std::string& rankingType) const {
+    size_t index;
+    if (rankingType == "bm25") {
+        index = 0;
+    } else if (rankingType == "graph_pagerank") {
+        index = 1;
+    } else {
+        index = 2;
+    }
+
+    if (index >= rankingWeights_.size()) {
+        return rankingWeights_.empty() ? 1.0f : rankingWeights_.back();
+    }
+    return rankingWeights_[index];
+}
+
+int ContextEngine::fillResponse(const ContextRequest* request, std::vector<RankerRun>& runs,
+                                Arena& arena, ContextResponse* response) {
+    // Assign dense indices to unique blocks so scores can live in
+    // contiguous structure-of-arrays lanes instead of a map
+    std::unordered_map<std::string, size_t> blockIndex;
+    std::vector<const CodeBlock*> blocks;
+
+    for (const RankerRun& run : runs) {
+        for (size_t i = 0; i < run.numResults; i++) {
+            const CodeBlock* block = run.results[i].block;
+            if (!block) continue;
+
+            auto [it, inserted] = blockIndex.try_emplace(blockKey(block), blocks.size());
+            if (inserted) {
+                blocks.push_back(block);
+            }
+        }
+    }
+
+    if (blocks.empty()) {
+        return RAGGER_SUCCESS;
+    }
+
+    // One score lane per ranker, fused with a vectorized weighted sum
+    std::vector<float> fusedScores(blocks.size(), 0.0f);
+    std::vector<float> lane(blocks.size());
+
+    for (const RankerRun& run : runs) {
+        if (run.numResults == 0) continue;
+
+        std::fill(lane.begin(), lane.end(), 0.0f);
+        for (size_t i = 0; i < run.numResults; i++) {
+            const RankingResult& entry = run.results[i];
+            if (!entry.block) continue;
+            lane[blockIndex[blockKey(entry.block)]] = entry.score;
+        }
+
+        accumulateWeighted(fusedScores.data(), lane.data(), lane.size(),
+                           weightForRankingType(run.rankingType));
+    }
+
+    // Only the top candidates can possibly fit the budget; partial_sort
+    // extracts them without ordering the full candidate set
+    std::vector<size_t> order(blocks.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+
+    size_t topN = std::min(order.size(), static_cast<size_t>(MAX_CANDIDATES));
+    std::partial_sort(order.begin(), order.begin() + topN, order.end(),
+                      [&fusedScores](size_t a, size_t b) {
+                          return fusedScores[a] > fusedScores[b];
+                      });
+    order.resize(topN);
+
+    // Admit best-first until the token budget is spent
+    int budget = maxContextTokens_;
+    if (request->maxTokens > 0 && static_cast<int>(request->maxTokens) < budget) {
+        budget = static_cast<int>(request->maxTokens);
+    }
+
+    std::vector<RankingResult> admitted;
+    uint32_t totalTokens = 0;
+    for (size_t index : order) {
+        const CodeBlock* block = blocks[index];
+        int tokens = block->content ? estimateTokenCount(block->content) : 0;
+        if (totalTokens + tokens > static_cast<uint32_t>(budget)) {
+            continue; // A smaller block further down may still fit
+        }
+
+        RankingResult copy;
+        copy.block = cloneBlock(arena, block);
+        copy.score = fusedScores[index];
+        copy.rankingType = arena.duplicateString("hybrid");
+        admitted.push_back(copy);
+        totalTokens += tokens;
+    }
+
+    if (!admitted.empty()) {
+        response->results = arena.allocateArray<RankingResult>(admitted.size());
+        std::copy(admitted.begin(), admitted.end(), response->results);
+        response->numResults = admitted.size();
+        response->totalTokens = totalTokens;
+    }
 
     return RAGGER_SUCCESS;
 }
@@ -45,17 +477,79 @@ int ContextEngine::generateContext(const ContextRequest* request, ContextRespons
 void ContextEngine::freeResponse(ContextResponse* response) {
     if (!response) return;
 
-    delete[] response->results;
-    delete[] response->promptTemplate;
-    delete response;
+    // The response and everything it points to came from one arena;
+    // dropping it frees the whole object graph at once
+    std::lock_guard<std::mutex> lock(arenaMutex_);
+    responseArenas_.erase(response);
 }
 
 int ContextEngine::loadTemplate(const std::string& name, const std::string& content) {
     templates_[name] = content;
+    compiledTemplates_[name] = compileTemplate(content);
     std::cout << "ContextEngine: Loaded template '" << name << "'" << std::endl;
     return RAGGER_SUCCESS;
 }
 
+// Parse {{VAR}} placeholders once at load time into a segment list so
+// rendering is a straight append pass with no per-render scanning
+ContextEngine::CompiledTemplate ContextEngine::compileTemplate(const std::string& content) {
+    CompiledTemplate compiled;
+    size_t pos = 0;
+
+    while (pos < content.size()) {
+        size_t open = content.find("{{", pos);
+        size_t close = (open == std::string::npos) ? std::string::npos
+                                                   : content.find("}}", open + 2);
+
+        if (close == std::string::npos) {
+            // No further complete placeholder; rest is literal
+            compiled.segments.push_back({content.substr(pos), false});
+            compiled.literalLength += content.size() - pos;
+            break;
+        }
+
+        if (open > pos) {
+            compiled.segments.push_back({content.substr(pos, open - pos), false});
+            compiled.literalLength += open - pos;
+        }
+        compiled.segments.push_back({content.substr(open + 2, close - open - 2), true});
+        pos = close + 2;
+    }
+
+    return compiled;
+}
+
+std::string ContextEngine::renderTemplate(
+    const CompiledTemplate& compiled,
+    const std::unordered_map<std::string, std::string>& variables) {
+    // Pre-size the output so rendering never reallocates
+    size_t totalLength = compiled.literalLength;
+    for (const auto& segment : compiled.segments) {
+        if (!segment.isVariable) continue;
+        auto it = variables.find(segment.text);
+        if (it != variables.end()) {
+            totalLength += it->second.size();
+        }
+    }
+
+    std::string output;
+    output.reserve(totalLength);
+
+    for (const auto& segment : compiled.segments) {
+        if (!segment.isVariable) {
+            output += segment.text;
+            continue;
+        }
+        auto it = variables.find(segment.text);
+        if (it != variables.end()) {
+            output += it->second;
+        }
+        // Unknown variables render as empty rather than leaking braces
+    }
+
+    return output;
+}
+
 int ContextEngine::getAvailableTemplates(std::vector<std::string>& templates) const {
     templates.clear();
     for (const auto& pair : templates_) {
@@ -88,37 +582,76 @@ int ContextEngine::getMaxContextTokens() const {
 std::string ContextEngine::buildPromptFromTemplate(const std::string& templateName,
                                                  const ContextRequest* request,
                                                  const ContextResponse* contextData) {
-    (void)request;    // Suppress unused parameter warning
-    (void)contextData; // Suppress unused parameter warning
-    std::string tmpl = getTemplate(templateName);
-    if (tmpl.empty()) {
-        tmpl = getTemplate("default");
+    auto it = compiledTemplates_.find(templateName);
+    if (it == compiledTemplates_.end()) {
+        it = compiledTemplates_.find("default");
+        if (it == compiledTemplates_.end()) {
+            return "";
+        }
     }
 
-    // TODO: Implement template variable substitution
-    // For now, return a basic prompt
-    return "Please analyze the following code and provide insights.";
+    std::unordered_map<std::string, std::string> variables;
+
+    if (request) {
+        if (request->userQuery) {
+            variables["REQUEST"] = request->userQuery;
+        }
+        if (request->primaryBlock && request->primaryBlock->content) {
+            variables["CODE"] = request->primaryBlock->content;
+        }
+    }
+
+    if (contextData && contextData->numResults > 0) {
+        std::string context;
+        for (size_t i = 0; i < contextData->numResults; i++) {
+            const CodeBlock* block = contextData->results[i].block;
+            if (!block || !block->content) continue;
+
+            if (block->filePath) {
+                context += "// ";
+                context += block->filePath;
+                context += '\n';
+            }
+            context += block->content;
+            context += '\n';
+        }
+        variables["CONTEXT"] = std::move(context);
+    }
+
+    return renderTemplate(it->second, variables);
 }
 
 int ContextEngine::estimateTokenCount(const std::string& text) const {
-    // Rough estimation: 1 token ≈ 4 characters for English text
-    // This is a simplification; actual tokenization is more complex
-    return text.length() / 4;
+    return tokenCounter_.countTokens(text);
 }
 
 std::string ContextEngine::truncateToTokenLimit(const std::string& text, int maxTokens) {
-    int estimatedTokens = estimateTokenCount(text);
-    if (estimatedTokens <= maxTokens) {
+    if (estimateTokenCount(text) <= maxTokens) {
         return text;
     }
 
-    // Simple truncation - in practice, you'd want smarter truncation
-    int targetLength = maxTokens * 4;
-    if (targetLength >= static_cast<int>(text.length())) {
-        return text;
+    // Binary search the longest character prefix that fits the budget;
+    // with real token counts a fixed chars-per-token guess is unreliable
+    size_t lo = 0;
+    size_t hi = text.length();
+    std::string_view view(text);
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo + 1) / 2;
+        if (tokenCounter_.countTokens(view.substr(0, mid)) <= maxTokens) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    // Prefer cutting at the preceding line break when one is nearby
+    size_t cut = text.rfind('\n', lo);
+    if (cut != std::string::npos && cut > lo / 2) {
+        lo = cut;
     }
 
-    return text.substr(0, targetLength) + "...";
+    return text.substr(0, lo) + "...";
 }
 
 void ContextEngine::loadDefaultTemplates() {
@@ -161,6 +694,9 @@ Follow these steps precisely:
 
     templates_["default"] = defaultTemplate;
     templates_["alpha_codium"] = alphaCodiumTemplate;
+    for (const auto& pair : templates_) {
+        compiledTemplates_[pair.first] = compileTemplate(pair.second);
+    }
 
     std::cout << "ContextEngine: Loaded " << templates_.size() << " default templates" << std::endl;
 }
@@ -1,20 +1,32 @@
 #pragma once
 
 #include "ragger_plugin_api.h"
+#include "Arena.h"
+#include "TokenCounter.h"
+#include <list>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 #include <string>
 
 namespace Ragger {
 
-struct RaggerCoreAPI;
+class PluginManager;
+class IndexManager;
 
 class ContextEngine {
 public:
     explicit ContextEngine(RaggerCoreAPI* coreAPI);
     ~ContextEngine() = default;
 
+    // Ranker plugins are resolved through the plugin manager at query time
+    void setPluginManager(PluginManager* pluginManager);
+
+    // Optional: enables generation-based cache invalidation. Without it
+    // the response cache still works but never expires entries.
+    void setIndexManager(IndexManager* indexManager);
+
     // Context generation
     int generateContext(const ContextRequest* request, ContextResponse** response);
     void freeResponse(ContextResponse* response);
@@ -32,11 +44,95 @@ public:
     void setMaxContextTokens(int maxTokens);
     int getMaxContextTokens() const;
 
+    // Response cache control
+    void setContextCacheBudget(size_t bytes); // 0 disables caching
+    void clearContextCache();
+
 private:
+    // A template parsed once at load time: alternating literal spans and
+    // variable slots, rendered by appending into one pre-sized buffer
+    struct CompiledTemplate {
+        struct Segment {
+            std::string text;   // Literal text, or the variable name
+            bool isVariable;
+        };
+        std::vector<Segment> segments;
+        size_t literalLength = 0; // Total bytes of literal text
+    };
+
     RaggerCoreAPI* coreAPI_;
+    PluginManager* pluginManager_;
     std::unordered_map<std::string, std::string> templates_;
+    std::unordered_map<std::string, CompiledTemplate> compiledTemplates_;
     std::vector<float> rankingWeights_;
     int maxContextTokens_;
+    mutable TokenCounter tokenCounter_;
+
+    // Upper bound on fused candidates considered for the budget; more
+    // than this can never fit a context window anyway
+    static const size_t MAX_CANDIDATES = 256;
+
+    // One ranker's output, collected by the fan-out threads
+    struct RankerRun {
+        const RankerPluginAPI* api;
+        std::string rankingType;
+        RankingResult* results;
+        size_t numResults;
+        int status;
+
+        RankerRun() : api(nullptr), results(nullptr), numResults(0), status(RAGGER_SUCCESS) {}
+    };
+
+    // Ranker fan-out and result fusion
+    std::vector<RankerRun> dispatchRankers(const ContextRequest* request);
+    float weightForRankingType(const std::string& rankingType) const;
+    int fillResponse(const ContextRequest* request, std::vector<RankerRun>& runs,
+                     Arena& arena, ContextResponse* response);
+
+    // One arena per outstanding response; freeResponse drops the whole
+    // per-request object graph in a single erase
+    std::mutex arenaMutex_;
+    std::unordered_map<ContextResponse*, std::unique_ptr<Arena>> responseArenas_;
+
+    // LRU response cache. A warm repeat of the same (query, primary
+    // block, weights) returns a materialized copy of the cached result
+    // instead of re-running the rank-and-render pipeline. Entries carry
+    // the index generation they were built at plus their contributing
+    // files, so a stale entry survives as long as none of its inputs
+    // actually changed.
+    struct CachedBlock {
+        std::string name;
+        std::string content;
+        std::string filePath;
+        std::string language;
+        int startLine;
+        int endLine;
+        uint32_t visibility;
+        float score;
+    };
+
+    struct CachedResponse {
+        std::string key;
+        uint64_t generation;
+        size_t byteSize;
+        uint32_t totalTokens;
+        std::vector<CachedBlock> blocks;
+        std::vector<std::string> contributingFiles;
+    };
+
+    static const size_t DEFAULT_CACHE_BUDGET = 16 * 1024 * 1024; // bytes
+
+    IndexManager* indexManager_;
+    std::mutex cacheMutex_;
+    std::list<CachedResponse> cacheList_; // Most recently used at front
+    std::unordered_map<std::string, std::list<CachedResponse>::iterator> cacheMap_;
+    size_t cacheBytes_;
+    size_t cacheBudget_;
+
+    std::string cacheKeyFor(const ContextRequest* request) const;
+    bool lookupCachedResponse(const std::string& key, ContextResponse** response);
+    void storeCachedResponse(const std::string& key, const ContextResponse* response);
+    bool cachedEntryStillValid(CachedResponse& entry, uint64_t currentGeneration);
 
     // Context building helpers
     std::string buildPromptFromTemplate(const std::string& templateName,
@@ -45,6 +141,12 @@ private:
     int estimateTokenCount(const std::string& text) const;
     std::string truncateToTokenLimit(const std::string& text, int maxTokens);
 
+    // Template compilation and rendering
+    static CompiledTemplate compileTemplate(const std::string& content);
+    static std::string renderTemplate(
+        const CompiledTemplate& compiled,
+        const std::unordered_map<std::string, std::string>& variables);
+
     // Default templates
     void loadDefaultTemplates();
 
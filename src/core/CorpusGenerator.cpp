@@ -0,0 +1,122 @@
+#include "CorpusGenerator.h"
+#include "Logger.h"
+#include "ragger_plugin_api.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace Ragger {
+
+namespace {
+
+// Shared identifier pool: names reused across files at duplicateTokenRatio,
+// which is what makes posting lists long and dedup work meaningful
+const char* const SHARED_IDENTIFIERS[] = {
+    "buffer", "context", "result", "handler", "manager", "config", "index",
+    "token", "parser", "request", "response", "callback", "payload", "stream",
+    "cursor", "entry", "record", "offset", "length", "status", "options",
+    "session", "channel", "worker", "queue", "cache", "digest", "symbol",
+    "scope", "module", "registry", "adapter", "factory", "visitor", "builder",
+    "iterator", "snapshot", "metadata", "fragment", "segment"
+};
+constexpr size_t NUM_SHARED_IDENTIFIERS =
+    sizeof(SHARED_IDENTIFIERS) / sizeof(SHARED_IDENTIFIERS[0]);
+
+} // anonymous namespace
+
+CorpusGenerator::CorpusGenerator(const CorpusShape& shape)
+    : shape_(shape) {
+}
+
+fs::path CorpusGenerator::pathForFile(size_t fileIndex) {
+    char shard[32];
+    char file[40];
+    snprintf(shard, sizeof(shard), "shard_%04zu", fileIndex / FILES_PER_SHARD);
+    snprintf(file, sizeof(file), "file_%07zu.cpp", fileIndex);
+    return fs::path(shard) / file;
+}
+
+std::string CorpusGenerator::buildFileContent(size_t fileIndex, std::mt19937& rng) const {
+    // Log-normal file sizes: mostly near the mean, a long tail of big files
+    std::lognormal_distribution<double> sizeDist(
+        std::log(static_cast<double>(std::max<size_t>(shape_.meanFileLines, 1))), 0.6);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::uniform_int_distribution<size_t> sharedPick(0, NUM_SHARED_IDENTIFIERS - 1);
+
+    size_t targetLines = std::clamp<size_t>(
+        static_cast<size_t>(sizeDist(rng)), 10, shape_.meanFileLines * 20);
+    size_t numFunctions = std::max<size_t>(targetLines / 6, 1);
+
+    std::string content;
+    content.reserve(targetLines * 48);
+    content += "// Synthetic file " + std::to_string(fileIndex) + "\n\n";
+
+    for (size_t fn = 0; fn < numFunctions; ++fn) {
+        // Duplicate-token ratio decides shared vs per-file identifiers
+        std::string localName;
+        if (coin(rng) < shape_.duplicateTokenRatio) {
+            localName = SHARED_IDENTIFIERS[sharedPick(rng)];
+        } else {
+            localName = "value_" + std::to_string(fileIndex) + "_" + std::to_string(fn);
+        }
+
+        content += "int process_" + std::to_string(fileIndex) + "_" +
+                   std::to_string(fn) + "(int " + localName + ") {\n";
+        content += "    int accumulated = " + localName + " * " +
+                   std::to_string(fn + 1) + ";\n";
+
+        // Symbol-graph fanout: deterministic calls into neighbouring files
+        if (fn == 0 && shape_.numFiles > 1) {
+            for (size_t k = 1; k <= shape_.symbolFanout; ++k) {
+                size_t target = (fileIndex + k * 31) % shape_.numFiles;
+                if (target == fileIndex) {
+                    continue;
+                }
+                content += "    accumulated += process_" + std::to_string(target) +
+                           "_0(accumulated);\n";
+            }
+        }
+
+        content += "    return accumulated;\n}\n\n";
+    }
+
+    return content;
+}
+
+int CorpusGenerator::generate(const fs::path& outputDir) {
+    std::error_code ec;
+    fs::create_directories(outputDir, ec);
+    if (ec) {
+        RAGGER_LOG_ERROR("CorpusGenerator: Failed to create " + outputDir.string() +
+                         ": " + ec.message());
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::mt19937 rng(shape_.seed);
+    size_t currentShard = SIZE_MAX;
+
+    for (size_t i = 0; i < shape_.numFiles; ++i) {
+        size_t shard = i / FILES_PER_SHARD;
+        if (shard != currentShard) {
+            fs::create_directories(outputDir / pathForFile(i).parent_path(), ec);
+            if (ec) {
+                return RAGGER_ERROR_INVALID_ARGUMENT;
+            }
+            currentShard = shard;
+        }
+
+        std::ofstream out(outputDir / pathForFile(i), std::ios::trunc);
+        if (!out.is_open()) {
+            RAGGER_LOG_ERROR("CorpusGenerator: Failed to write file " +
+                             std::to_string(i) + " under " + outputDir.string());
+            return RAGGER_ERROR_INDEXING_FAILED;
+        }
+        out << buildFileContent(i, rng);
+    }
+
+    RAGGER_LOG_INFO("CorpusGenerator: Generated " + std::to_string(shape_.numFiles) +
+                    " files under " + outputDir.string());
+    return RAGGER_SUCCESS;
+}
+
+} // namespace Ragger
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <random>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace Ragger {
+
+// Knobs controlling the shape of a generated corpus. Defaults produce a
+// small, quick corpus; scaling benchmarks crank numFiles up to 10k-1M.
+struct CorpusShape {
+    size_t numFiles = 1000;
+    size_t meanFileLines = 120;        // Log-normal spread around this
+    size_t symbolFanout = 4;           // Cross-file calls emitted per file
+    double duplicateTokenRatio = 0.3;  // Share of identifiers drawn from a shared pool
+    unsigned seed = 1234;              // Same seed + shape => byte-identical corpus
+};
+
+// Synthesizes repositories of C++-ish source files with controllable
+// shape so indexing and query benchmarks can be run at realistic scale.
+// Files are sharded into subdirectories of at most 1000 entries to keep
+// directory operations sane at large file counts.
+class CorpusGenerator {
+public:
+    explicit CorpusGenerator(const CorpusShape& shape);
+    ~CorpusGenerator() = default;
+
+    // Generates the corpus under outputDir (created if missing). Existing
+    // files are overwritten; returns RAGGER_SUCCESS or an error code.
+    int generate(const fs::path& outputDir);
+
+    // Relative path a given file index lands at, e.g. "shard_0003/file_0003201.cpp"
+    static fs::path pathForFile(size_t fileIndex);
+
+    static constexpr size_t FILES_PER_SHARD = 1000;
+
+private:
+    std::string buildFileContent(size_t fileIndex, std::mt19937& rng) const;
+
+    CorpusShape shape_;
+
+    // Prevent copying
+    CorpusGenerator(const CorpusGenerator&) = delete;
+    CorpusGenerator& operator=(const CorpusGenerator&) = delete;
+};
+
+} // namespace Ragger
@@ -1,4 +1,6 @@
 #include "EventBus.h"
+#include "Logger.h"
+#include "Trace.h"
 #include <algorithm>
 #include <chrono>
 #include <cstring>
@@ -7,8 +9,107 @@
 
 namespace Ragger {
 
+// EventLane implementation (Vyukov bounded queue, MPSC usage)
+
+EventBus::EventLane::EventLane()
+    : enqueuePos_(0), dequeuePos_(0) {
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+        slots_[i].item = nullptr;
+    }
+}
+
+EventBus::EventLane::~EventLane() {
+    // Drain anything left behind so queued copies don't leak
+    while (auto event = tryPop()) {
+        // unique_ptr releases the event
+    }
+}
+
+bool EventBus::EventLane::tryPush(std::unique_ptr<QueuedEvent> event) {
+    uint64_t pos = enqueuePos_.load(std::memory_order_relaxed);
+
+    for (;;) {
+        Slot& slot = slots_[pos & (CAPACITY - 1)];
+        uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+        if (diff == 0) {
+            // Slot is free; try to claim it
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.item = event.release();
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+            // CAS failed, pos was refreshed; retry
+        } else if (diff < 0) {
+            return false; // Lane is full
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+std::unique_ptr<EventBus::QueuedEvent> EventBus::EventLane::tryPop() {
+    uint64_t pos = dequeuePos_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[pos & (CAPACITY - 1)];
+    uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+    intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+    if (diff < 0) {
+        return nullptr; // Lane is empty
+    }
+
+    // Single consumer, so no CAS needed on the dequeue counter
+    dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+    std::unique_ptr<QueuedEvent> event(slot.item);
+    slot.item = nullptr;
+    slot.sequence.store(pos + CAPACITY, std::memory_order_release);
+    return event;
+}
+
+bool EventBus::EventLane::empty() const {
+    uint64_t pos = dequeuePos_.load(std::memory_order_relaxed);
+    const Slot& slot = slots_[pos & (CAPACITY - 1)];
+    uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+    return static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0;
+}
+
+size_t EventBus::EventLane::depth() const {
+    uint64_t enqueue = enqueuePos_.load(std::memory_order_relaxed);
+    uint64_t dequeue = dequeuePos_.load(std::memory_order_relaxed);
+    return enqueue > dequeue ? static_cast<size_t>(enqueue - dequeue) : 0;
+}
+
+std::shared_ptr<EventBus::SharedPayload> EventBus::SharedPayload::allocate(size_t size) {
+    return std::shared_ptr<SharedPayload>(new SharedPayload(size));
+}
+
+size_t EventBus::laneForPriority(int priority) {
+    if (priority > 0) return LANE_HIGH;
+    if (priority < 0) return LANE_LOW;
+    return LANE_NORMAL;
+}
+
+EventBus::LatencyStripe::LatencyStripe() {
+    for (size_t type = 0; type < MAX_EVENT_TYPES; ++type) {
+        for (size_t bucket = 0; bucket < NUM_LATENCY_BUCKETS; ++bucket) {
+            counts[type][bucket].store(0, std::memory_order_relaxed);
+        }
+        totals[type].store(0, std::memory_order_relaxed);
+        maxes[type].store(0, std::memory_order_relaxed);
+    }
+}
+
 EventBus::EventBus()
-    : minPriority_(INT_MIN), maxPriority_(INT_MAX), running_(false) {
+    : latencyStripes_(new LatencyStripe[NUM_LATENCY_STRIPES]),
+      minPriority_(INT_MIN), maxPriority_(INT_MAX), running_(false) {
+    // Pre-populate the per-type counters so the map never rehashes after
+    // construction and lock-free fetch_adds are safe against readers
+    for (int type = 1; type < static_cast<int>(MAX_EVENT_TYPES); ++type) {
+        stats_.eventsByType[static_cast<EventType>(type)].store(0, std::memory_order_relaxed);
+    }
+
     // Start processing thread
     running_ = true;
     processingThread_ = std::thread(&EventBus::processingLoop, this);
@@ -24,25 +125,11 @@ EventBus::~EventBus() {
 }
 
 int EventBus::emitEvent(const EventData* event) {
-    // Comprehensive input validation
-    if (!event) {
-        return RAGGER_ERROR_INVALID_ARGUMENT;
-    }
-    
-    if (event->type <= 0 || event->type > 8) { // Based on EventType enum
-        return RAGGER_ERROR_INVALID_ARGUMENT;
-    }
-    
-    if (event->dataSize > 1024 * 1024) { // Limit to 1MB
-        return RAGGER_ERROR_INVALID_ARGUMENT;
-    }
-    
-    if (event->data && event->dataSize == 0) {
-        return RAGGER_ERROR_INVALID_ARGUMENT;
-    }
-    
-    if (event->sourcePlugin && strlen(event->sourcePlugin) > 256) {
-        return RAGGER_ERROR_INVALID_ARGUMENT;
+    // Synchronous delivery never copies the payload, so the producer's
+    // buffer outlives the dispatch and only the header checks apply
+    int validation = validateEventHeader(event);
+    if (validation != RAGGER_SUCCESS) {
+        return validation;
     }
 
     std::lock_guard<std::mutex> lock(mutex_);
@@ -58,73 +145,186 @@ int EventBus::emitEvent(const EventData* event) {
     auto endTime = std::chrono::high_resolution_clock::now();
 
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
-    stats_.totalEventsProcessed++;
-    stats_.eventsByType[event->type]++;
-
-    // Update average processing time
-    if (stats_.totalEventsProcessed == 1) {
-        stats_.averageProcessingTime = duration.count();
-    } else {
-        stats_.averageProcessingTime =
-            (stats_.averageProcessingTime * (stats_.totalEventsProcessed - 1) + duration.count()) /
-            stats_.totalEventsProcessed;
-    }
+    stats_.totalEventsProcessed.fetch_add(1, std::memory_order_relaxed);
+    stats_.eventsByType[event->type].fetch_add(1, std::memory_order_relaxed);
+    recordLatency(event->type, static_cast<uint64_t>(duration.count()));
 
     return RAGGER_SUCCESS;
 }
 
-int EventBus::emitEventAsync(const EventData* event) {
-    // Comprehensive input validation
+// Checks that apply regardless of how the payload is carried; the
+// copied-payload size cap is layered on top in validateEvent
+int EventBus::validateEventHeader(const EventData* event) {
     if (!event) {
         return RAGGER_ERROR_INVALID_ARGUMENT;
     }
-    
+
     if (event->type <= 0 || event->type > 8) { // Based on EventType enum
         return RAGGER_ERROR_INVALID_ARGUMENT;
     }
-    
-    if (event->dataSize > 1024 * 1024) { // Limit to 1MB
-        return RAGGER_ERROR_INVALID_ARGUMENT;
-    }
-    
+
     if (event->data && event->dataSize == 0) {
         return RAGGER_ERROR_INVALID_ARGUMENT;
     }
-    
+
     if (event->sourcePlugin && strlen(event->sourcePlugin) > 256) {
         return RAGGER_ERROR_INVALID_ARGUMENT;
     }
 
-    std::lock_guard<std::mutex> lock(mutex_);
+    return RAGGER_SUCCESS;
+}
 
-    if (!shouldProcessEvent(event)) {
-        stats_.eventsDropped.fetch_add(1);
-        return RAGGER_SUCCESS;
+int EventBus::validateEvent(const EventData* event) {
+    int result = validateEventHeader(event);
+    if (result != RAGGER_SUCCESS) {
+        return result;
+    }
+
+    if (event->dataSize > MAX_COPIED_PAYLOAD) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+
+    return RAGGER_SUCCESS;
+}
+
+// Build a self-contained copy; filtering happens on the consumer side
+// so producers never touch the subscription mutex.
+std::unique_ptr<EventBus::QueuedEvent> EventBus::copyEvent(const EventData* event) {
+    auto eventCopy = std::make_unique<QueuedEvent>();
+    eventCopy->event.type = event->type;
+    eventCopy->event.timestamp = event->timestamp;
+    eventCopy->event.dataSize = event->dataSize;
+
+    if (event->sourcePlugin) {
+        eventCopy->sourcePlugin = event->sourcePlugin;
+        eventCopy->event.sourcePlugin = eventCopy->sourcePlugin.c_str();
+    } else {
+        eventCopy->event.sourcePlugin = nullptr;
     }
 
-    // Create event copy with proper memory management
-    auto eventCopy = std::make_unique<EventData>();
-    eventCopy->type = event->type;
-    eventCopy->timestamp = event->timestamp;
-    eventCopy->sourcePlugin = event->sourcePlugin;
-    eventCopy->dataSize = event->dataSize;
-    
-    // Copy data with proper memory management
     if (event->data && event->dataSize > 0) {
-        eventCopy->data = new char[event->dataSize];
-        std::memcpy(eventCopy->data, event->data, event->dataSize);
+        eventCopy->payload.reset(new char[event->dataSize]);
+        std::memcpy(eventCopy->payload.get(), event->data, event->dataSize);
+        eventCopy->event.data = eventCopy->payload.get();
+    } else {
+        eventCopy->event.data = nullptr;
+    }
+
+    return eventCopy;
+}
+
+// Reference the shared buffer instead of copying it; the queued event
+// holds a strong reference until delivery completes
+std::unique_ptr<EventBus::QueuedEvent> EventBus::wrapSharedEvent(
+        const EventData* event, std::shared_ptr<SharedPayload> payload) {
+    auto queued = std::make_unique<QueuedEvent>();
+    queued->event.type = event->type;
+    queued->event.timestamp = event->timestamp;
+
+    if (event->sourcePlugin) {
+        queued->sourcePlugin = event->sourcePlugin;
+        queued->event.sourcePlugin = queued->sourcePlugin.c_str();
+    } else {
+        queued->event.sourcePlugin = nullptr;
+    }
+
+    if (event->data) {
+        queued->event.data = event->data;
+        queued->event.dataSize = event->dataSize;
     } else {
-        eventCopy->data = nullptr;
+        // No explicit window: deliver the whole buffer
+        queued->event.data = payload->data();
+        queued->event.dataSize = payload->size();
+    }
+    queued->sharedPayload = std::move(payload);
+
+    return queued;
+}
+
+int EventBus::emitEventShared(const EventData* event, std::shared_ptr<SharedPayload> payload,
+                              int priority) {
+    if (!payload) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+
+    int validation = validateEventHeader(event);
+    if (validation != RAGGER_SUCCESS) {
+        return validation;
+    }
+
+    // An explicit data pointer must address a window inside the buffer
+    if (event->data) {
+        const char* begin = static_cast<const char*>(payload->data());
+        const char* window = static_cast<const char*>(event->data);
+        if (window < begin || event->dataSize > payload->size() ||
+            window + event->dataSize > begin + payload->size()) {
+            return RAGGER_ERROR_INVALID_ARGUMENT;
+        }
+    }
+
+    EventLane& lane = eventLanes_[laneForPriority(priority)];
+    if (!lane.tryPush(wrapSharedEvent(event, std::move(payload)))) {
+        // Bounded queue: report backpressure instead of blocking producers
+        stats_.eventsDropped.fetch_add(1);
+        return RAGGER_ERROR_OUT_OF_MEMORY;
     }
 
-    // Add to queue with default priority
-    eventQueue_.push({std::move(eventCopy), 0});
     eventCondition_.notify_one();
+    stats_.totalEventsEmitted.fetch_add(1);
+    return RAGGER_SUCCESS;
+}
+
+int EventBus::emitEventAsync(const EventData* event, int priority) {
+    int validation = validateEvent(event);
+    if (validation != RAGGER_SUCCESS) {
+        return validation;
+    }
+
+    auto eventCopy = copyEvent(event);
+
+    EventLane& lane = eventLanes_[laneForPriority(priority)];
+    if (!lane.tryPush(std::move(eventCopy))) {
+        // Bounded queue: report backpressure instead of blocking producers
+        stats_.eventsDropped.fetch_add(1);
+        return RAGGER_ERROR_OUT_OF_MEMORY;
+    }
 
+    eventCondition_.notify_one();
     stats_.totalEventsEmitted.fetch_add(1);
     return RAGGER_SUCCESS;
 }
 
+// Enqueue a whole run of events with one wakeup. Invalid or dropped
+// events are skipped rather than aborting the batch; the return value
+// tells the producer how many were accepted.
+size_t EventBus::emitEventsAsync(const EventData* events, size_t numEvents, int priority) {
+    if (!events || numEvents == 0) {
+        return 0;
+    }
+
+    EventLane& lane = eventLanes_[laneForPriority(priority)];
+    size_t accepted = 0;
+
+    for (size_t i = 0; i < numEvents; i++) {
+        if (validateEvent(&events[i]) != RAGGER_SUCCESS) {
+            continue;
+        }
+
+        if (!lane.tryPush(copyEvent(&events[i]))) {
+            // Bounded queue: drop the remainder under backpressure
+            stats_.eventsDropped.fetch_add(numEvents - i);
+            break;
+        }
+        accepted++;
+    }
+
+    if (accepted > 0) {
+        stats_.totalEventsEmitted.fetch_add(accepted);
+        eventCondition_.notify_one();
+    }
+    return accepted;
+}
+
 int EventBus::subscribe(EventType type, EventCallback callback, void* userData,
                        int priority, const char* filter) {
     if (!callback) {
@@ -134,13 +334,13 @@ int EventBus::subscribe(EventType type, EventCallback callback, void* userData,
     std::lock_guard<std::mutex> lock(mutex_);
 
     // Check if already subscribed
-    for (const auto& sub : subscriptions_) {
-        if (sub.type == type && sub.callback == callback && sub.userData == userData) {
+    for (const auto& sub : subscriptionsByType_[type]) {
+        if (sub.callback == callback && sub.userData == userData) {
             return RAGGER_ERROR_INVALID_ARGUMENT; // Already subscribed
         }
     }
 
-    subscriptions_.push_back({
+    insertSubscription({
         type,
         callback,
         userData,
@@ -149,10 +349,22 @@ int EventBus::subscribe(EventType type, EventCallback callback, void* userData,
         true
     });
 
-    std::cout << "EventBus: Subscribed to event type " << static_cast<int>(type) << " with priority " << priority << std::endl;
+    RAGGER_LOG_DEBUG("EventBus: Subscribed to event type " + std::to_string(static_cast<int>(type)) +
+                     " with priority " + std::to_string(priority));
     return RAGGER_SUCCESS;
 }
 
+// Keep each per-type vector ordered by priority (highest first) so
+// dispatch is a pre-ordered iteration with no per-event sort
+void EventBus::insertSubscription(Subscription&& subscription) {
+    std::vector<Subscription>& subs = subscriptionsByType_[subscription.type];
+    auto position = std::upper_bound(subs.begin(), subs.end(), subscription,
+        [](const Subscription& a, const Subscription& b) {
+            return a.priority > b.priority;
+        });
+    subs.insert(position, std::move(subscription));
+}
+
 int EventBus::unsubscribe(EventType type, EventCallback callback) {
     if (!callback) {
         return RAGGER_ERROR_INVALID_ARGUMENT;
@@ -160,14 +372,20 @@ int EventBus::unsubscribe(EventType type, EventCallback callback) {
 
     std::lock_guard<std::mutex> lock(mutex_);
 
-    auto it = std::remove_if(subscriptions_.begin(), subscriptions_.end(),
-        [type, callback](const Subscription& sub) {
-            return sub.type == type && sub.callback == callback;
+    auto typeIt = subscriptionsByType_.find(type);
+    if (typeIt == subscriptionsByType_.end()) {
+        return RAGGER_ERROR_INVALID_ARGUMENT; // Not found
+    }
+
+    std::vector<Subscription>& subs = typeIt->second;
+    auto it = std::remove_if(subs.begin(), subs.end(),
+        [callback](const Subscription& sub) {
+            return sub.callback == callback;
         });
 
-    if (it != subscriptions_.end()) {
-        subscriptions_.erase(it, subscriptions_.end());
-        std::cout << "EventBus: Unsubscribed from event type " << static_cast<int>(type) << std::endl;
+    if (it != subs.end()) {
+        subs.erase(it, subs.end());
+        RAGGER_LOG_DEBUG("EventBus: Unsubscribed from event type " + std::to_string(static_cast<int>(type)));
         return RAGGER_SUCCESS;
     }
 
@@ -184,7 +402,7 @@ int EventBus::subscribeMultiple(const EventType* types, size_t numTypes,
     std::lock_guard<std::mutex> lock(mutex_);
 
     for (size_t i = 0; i < numTypes; ++i) {
-        subscriptions_.push_back({
+        insertSubscription({
             types[i],
             callback,
             userData,
@@ -194,7 +412,8 @@ int EventBus::subscribeMultiple(const EventType* types, size_t numTypes,
         });
     }
 
-    std::cout << "EventBus: Subscribed to " << numTypes << " event types with priority " << priority << std::endl;
+    RAGGER_LOG_DEBUG("EventBus: Subscribed to " + std::to_string(numTypes) +
+                     " event types with priority " + std::to_string(priority));
     return RAGGER_SUCCESS;
 }
 
@@ -205,15 +424,18 @@ int EventBus::unsubscribeAll(EventCallback callback) {
 
     std::lock_guard<std::mutex> lock(mutex_);
 
-    auto it = std::remove_if(subscriptions_.begin(), subscriptions_.end(),
-        [callback](const Subscription& sub) {
-            return sub.callback == callback;
-        });
-
-    size_t removed = std::distance(it, subscriptions_.end());
-    subscriptions_.erase(it, subscriptions_.end());
+    size_t removed = 0;
+    for (auto& pair : subscriptionsByType_) {
+        std::vector<Subscription>& subs = pair.second;
+        auto it = std::remove_if(subs.begin(), subs.end(),
+            [callback](const Subscription& sub) {
+                return sub.callback == callback;
+            });
+        removed += std::distance(it, subs.end());
+        subs.erase(it, subs.end());
+    }
 
-    std::cout << "EventBus: Unsubscribed from " << removed << " subscriptions" << std::endl;
+    RAGGER_LOG_DEBUG("EventBus: Unsubscribed from " + std::to_string(removed) + " subscriptions");
     return RAGGER_SUCCESS;
 }
 
@@ -239,13 +461,126 @@ const EventBus::Stats& EventBus::getStats() const {
     return stats_;
 }
 
+// Bucket i covers [2^i, 2^(i+1)) microseconds; 0us lands in bucket 0
+size_t EventBus::bucketForMicros(uint64_t micros) {
+    size_t bucket = 0;
+    while (micros > 1 && bucket < NUM_LATENCY_BUCKETS - 1) {
+        micros >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+void EventBus::recordLatency(EventType type, uint64_t micros) {
+    size_t typeIndex = static_cast<size_t>(type);
+    if (typeIndex >= MAX_EVENT_TYPES) {
+        return;
+    }
+
+    // Stripe selection by thread id: threads almost always hit their own
+    // stripe, so the relaxed fetch_adds don't bounce cache lines
+    size_t stripeIndex = std::hash<std::thread::id>{}(std::this_thread::get_id()) % NUM_LATENCY_STRIPES;
+    LatencyStripe& stripe = latencyStripes_[stripeIndex];
+
+    stripe.counts[typeIndex][bucketForMicros(micros)].fetch_add(1, std::memory_order_relaxed);
+    stripe.totals[typeIndex].fetch_add(micros, std::memory_order_relaxed);
+
+    uint64_t observedMax = stripe.maxes[typeIndex].load(std::memory_order_relaxed);
+    while (micros > observedMax &&
+           !stripe.maxes[typeIndex].compare_exchange_weak(observedMax, micros,
+                                                          std::memory_order_relaxed)) {
+        // observedMax refreshed by the failed CAS; retry
+    }
+}
+
+EventBus::StatsSnapshot EventBus::getStatsSnapshot() const {
+    StatsSnapshot snapshot;
+    snapshot.totalEventsEmitted = stats_.totalEventsEmitted.load(std::memory_order_relaxed);
+    snapshot.totalEventsProcessed = stats_.totalEventsProcessed.load(std::memory_order_relaxed);
+    snapshot.eventsDropped = stats_.eventsDropped.load(std::memory_order_relaxed);
+
+    for (size_t lane = 0; lane < NUM_PRIORITY_LANES; ++lane) {
+        snapshot.queueDepths[lane] = eventLanes_[lane].depth();
+    }
+
+    // Merge the stripes; counters are monotonic, so a concurrent update
+    // at worst lands in the next snapshot
+    uint64_t grandTotalMicros = 0;
+    uint64_t grandCount = 0;
+    for (size_t s = 0; s < NUM_LATENCY_STRIPES; ++s) {
+        const LatencyStripe& stripe = latencyStripes_[s];
+        for (size_t type = 0; type < MAX_EVENT_TYPES; ++type) {
+            LatencyHistogram& histogram = snapshot.latencyByType[type];
+            for (size_t bucket = 0; bucket < NUM_LATENCY_BUCKETS; ++bucket) {
+                uint64_t count = stripe.counts[type][bucket].load(std::memory_order_relaxed);
+                histogram.buckets[bucket] += count;
+                histogram.count += count;
+            }
+            histogram.totalMicros += stripe.totals[type].load(std::memory_order_relaxed);
+            histogram.maxMicros = std::max(histogram.maxMicros,
+                                           stripe.maxes[type].load(std::memory_order_relaxed));
+        }
+    }
+    for (size_t type = 0; type < MAX_EVENT_TYPES; ++type) {
+        grandTotalMicros += snapshot.latencyByType[type].totalMicros;
+        grandCount += snapshot.latencyByType[type].count;
+    }
+
+    // Keep the legacy average coherent with the histogram data
+    if (grandCount > 0) {
+        stats_.averageProcessingTime.store(grandTotalMicros / grandCount, std::memory_order_relaxed);
+    }
+
+    return snapshot;
+}
+
+uint64_t EventBus::histogramPercentile(const LatencyHistogram& histogram, double percentile) {
+    if (histogram.count == 0 || percentile <= 0.0) {
+        return 0;
+    }
+    if (percentile >= 1.0) {
+        return histogram.maxMicros;
+    }
+
+    uint64_t threshold = static_cast<uint64_t>(percentile * static_cast<double>(histogram.count));
+    if (threshold == 0) {
+        threshold = 1;
+    }
+
+    uint64_t cumulative = 0;
+    for (size_t bucket = 0; bucket < NUM_LATENCY_BUCKETS; ++bucket) {
+        cumulative += histogram.buckets[bucket];
+        if (cumulative >= threshold) {
+            if (bucket == NUM_LATENCY_BUCKETS - 1) {
+                return histogram.maxMicros; // Open-ended last bucket
+            }
+            return static_cast<uint64_t>(1) << (bucket + 1); // Bucket upper bound
+        }
+    }
+    return histogram.maxMicros;
+}
+
 void EventBus::resetStats() {
     std::lock_guard<std::mutex> lock(mutex_);
     stats_.totalEventsEmitted.store(0);
     stats_.totalEventsProcessed.store(0);
     stats_.eventsDropped.store(0);
     stats_.averageProcessingTime.store(0);
-    stats_.eventsByType.clear();
+    // Zero the values in place; clearing the map would break the
+    // no-rehash invariant the lock-free counters rely on
+    for (auto& pair : stats_.eventsByType) {
+        pair.second.store(0);
+    }
+    for (size_t s = 0; s < NUM_LATENCY_STRIPES; ++s) {
+        LatencyStripe& stripe = latencyStripes_[s];
+        for (size_t type = 0; type < MAX_EVENT_TYPES; ++type) {
+            for (size_t bucket = 0; bucket < NUM_LATENCY_BUCKETS; ++bucket) {
+                stripe.counts[type][bucket].store(0);
+            }
+            stripe.totals[type].store(0);
+            stripe.maxes[type].store(0);
+        }
+    }
 }
 
 void EventBus::lock() {
@@ -262,60 +597,98 @@ bool EventBus::tryLock() {
 
 void EventBus::processingLoop() {
     while (running_) {
-        std::unique_lock<std::mutex> lock(mutex_);
+        if (!drainLanes()) {
+            // All lanes empty: sleep until a producer signals. The wait uses
+            // a timeout because producers push lock-free and the notify can
+            // race ahead of this wait.
+            std::unique_lock<std::mutex> lock(mutex_);
+            eventCondition_.wait_for(lock, std::chrono::milliseconds(10), [this]() {
+                return !running_;
+            });
+        }
+    }
 
-        // Wait for events or shutdown signal
-        eventCondition_.wait(lock, [this]() {
-            return !eventQueue_.empty() || !running_;
-        });
+    // Final drain so events emitted right before shutdown are delivered
+    drainLanes();
+}
 
-        if (!running_) break;
+bool EventBus::drainLanes() {
+    bool processedAny = false;
+    std::vector<std::unique_ptr<QueuedEvent>> batch;
+    batch.reserve(DRAIN_BATCH_SIZE);
+
+    // Drain highest-priority lane first; restart from the top after each
+    // batch so high-priority traffic preempts the lower lanes. Pulling a
+    // run of events per lock acquisition amortizes the filter check and
+    // stats update across the batch.
+    size_t lane = 0;
+    while (lane < NUM_PRIORITY_LANES) {
+        batch.clear();
+        while (batch.size() < DRAIN_BATCH_SIZE) {
+            auto item = eventLanes_[lane].tryPop();
+            if (!item) break;
+            batch.push_back(std::move(item));
+        }
 
-        // Process events in priority order
-        while (!eventQueue_.empty()) {
-            auto item = std::move(const_cast<EventQueueItem&>(eventQueue_.top()));
-            eventQueue_.pop();
+        if (batch.empty()) {
+            ++lane;
+            continue;
+        }
 
-            lock.unlock(); // Unlock while processing
+        processedAny = true;
+        lane = 0;
+
+        // One filter pass under the lock for the whole batch
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& item : batch) {
+                if (!shouldProcessEvent(&item->event)) {
+                    stats_.eventsDropped.fetch_add(1);
+                    item.reset();
+                }
+            }
+        }
 
+        // Per-event timing feeds the latency histograms; all accounting
+        // here is relaxed atomics, no mutex on the path
+        size_t delivered = 0;
+        for (auto& item : batch) {
+            if (!item) continue;
             auto startTime = std::chrono::high_resolution_clock::now();
-            processEvent(item.event.get());
+            processEvent(&item->event);
             auto endTime = std::chrono::high_resolution_clock::now();
 
             auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
+            recordLatency(item->event.type, static_cast<uint64_t>(duration.count()));
 
-            lock.lock(); // Re-lock for stats update
-
-            stats_.totalEventsProcessed.fetch_add(1);
-            stats_.eventsByType[item.event->type].fetch_add(1);
-
-            // Update average processing time
-            uint64_t currentCount = stats_.totalEventsProcessed.load();
-            if (currentCount == 1) {
-                stats_.averageProcessingTime.store(duration.count());
-            } else {
-                uint64_t currentAvg = stats_.averageProcessingTime.load();
-                stats_.averageProcessingTime.store(
-                    (currentAvg * (currentCount - 1) + duration.count()) / currentCount);
+            auto typeIt = stats_.eventsByType.find(item->event.type);
+            if (typeIt != stats_.eventsByType.end()) {
+                typeIt->second.fetch_add(1, std::memory_order_relaxed);
             }
+            delivered++;
+        }
+
+        if (delivered > 0) {
+            stats_.totalEventsProcessed.fetch_add(delivered, std::memory_order_relaxed);
         }
     }
+
+    return processedAny;
 }
 
 void EventBus::processEvent(const EventData* event) {
-    auto matchingSubs = findMatchingSubscriptions(event);
+    RAGGER_TRACE_SPAN("event-dispatch");
 
-    // Sort by priority (higher priority first)
-    std::sort(matchingSubs.begin(), matchingSubs.end(),
-        [](const Subscription* a, const Subscription* b) {
-            return a->priority > b->priority;
-        });
+    // Indexed lookup; the per-type vector is already priority-ordered
+    auto typeIt = subscriptionsByType_.find(event->type);
+    if (typeIt == subscriptionsByType_.end()) {
+        return;
+    }
 
-    // Call callbacks
-    for (auto* sub : matchingSubs) {
-        if (sub->enabled) {
+    for (auto& sub : typeIt->second) {
+        if (sub.matches(event)) {
             try {
-                sub->callback(event, sub->userData);
+                sub.callback(event, sub.userData);
             } catch (const std::exception& e) {
                 std::cerr << "EventBus: Exception in event callback: " << e.what() << std::endl;
             }
@@ -344,18 +717,6 @@ bool EventBus::shouldProcessEvent(const EventData* event) const {
     return true;
 }
 
-std::vector<EventBus::Subscription*> EventBus::findMatchingSubscriptions(const EventData* event) {
-    std::vector<Subscription*> matching;
-
-    for (auto& sub : subscriptions_) {
-        if (sub.type == event->type && sub.matches(event)) {
-            matching.push_back(&sub);
-        }
-    }
-
-    return matching;
-}
-
 bool EventBus::Subscription::matches(const EventData* event) const {
     if (!enabled) return false;
 
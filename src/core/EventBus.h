@@ -5,7 +5,6 @@
 #include <unordered_map>
 #include <mutex>
 #include <memory>
-#include <queue>
 #include <string>
 #include <thread>
 #include <atomic>
@@ -18,9 +17,43 @@ public:
     EventBus();
     ~EventBus();
 
+    // Copied async payloads stay capped: the bus memcpys them into the
+    // queue, so oversized events must use the shared-payload path instead
+    static const size_t MAX_COPIED_PAYLOAD = 1024 * 1024;
+
+    // Refcounted immutable payload. The producer fills the buffer once,
+    // hands it to emitEventShared and drops its reference; the bus pins
+    // the buffer until the last subscriber has run, so large payloads
+    // (whole-file parse results, ranking batches) move through the bus
+    // without a memcpy and without the copied-payload size cap.
+    class SharedPayload {
+    public:
+        static std::shared_ptr<SharedPayload> allocate(size_t size);
+
+        void* data() { return data_.get(); }
+        const void* data() const { return data_.get(); }
+        size_t size() const { return size_; }
+
+    private:
+        SharedPayload(size_t size) : data_(new char[size]), size_(size) {}
+        std::unique_ptr<char[]> data_;
+        size_t size_;
+    };
+
     // Event emission
     int emitEvent(const EventData* event);
-    int emitEventAsync(const EventData* event);
+    int emitEventAsync(const EventData* event, int priority = 0);
+
+    // Zero-copy emission: the queued event references the shared buffer
+    // instead of copying it. event->data must be null (defaults to the
+    // whole buffer) or point into the buffer with dataSize inside it.
+    int emitEventShared(const EventData* event, std::shared_ptr<SharedPayload> payload,
+                        int priority = 0);
+
+    // Batch emission: validates and enqueues the whole run with a single
+    // wakeup, amortizing per-event overhead during bulk indexing. Returns
+    // the number of events accepted (dropped events count against stats).
+    size_t emitEventsAsync(const EventData* events, size_t numEvents, int priority = 0);
 
     // Event subscription
     int subscribe(EventType type, EventCallback callback, void* userData,
@@ -38,6 +71,9 @@ public:
     void setEventFilter(EventType type, const char* filter);
     void setPriorityRange(int minPriority, int maxPriority);
 
+    // Per-priority lanes drained highest-first by the processing thread
+    static const size_t NUM_PRIORITY_LANES = 3;
+
     // Statistics and monitoring
     struct Stats {
         std::atomic<uint64_t> totalEventsEmitted{0};
@@ -47,6 +83,38 @@ public:
         std::unordered_map<EventType, std::atomic<uint64_t>> eventsByType;
     };
 
+    // Valid EventType values are 1..8; slot 0 is unused so histograms
+    // can be indexed by the raw enum value
+    static const size_t MAX_EVENT_TYPES = 9;
+    // Power-of-two latency buckets: bucket i covers [2^i, 2^(i+1)) us,
+    // the last bucket is open-ended
+    static const size_t NUM_LATENCY_BUCKETS = 20;
+
+    struct LatencyHistogram {
+        uint64_t count = 0;
+        uint64_t totalMicros = 0;
+        uint64_t maxMicros = 0;
+        uint64_t buckets[NUM_LATENCY_BUCKETS] = {};
+    };
+
+    // Point-in-time merge of the lock-free accounting state: per-type
+    // latency distributions plus the current depth of each priority lane.
+    // Cheap enough to poll from a monitoring loop.
+    struct StatsSnapshot {
+        uint64_t totalEventsEmitted = 0;
+        uint64_t totalEventsProcessed = 0;
+        uint64_t eventsDropped = 0;
+        uint64_t queueDepths[NUM_PRIORITY_LANES] = {}; // Sampled at snapshot time
+        LatencyHistogram latencyByType[MAX_EVENT_TYPES];
+    };
+
+    StatsSnapshot getStatsSnapshot() const;
+
+    // Approximate percentile (0 < percentile <= 1) from the bucket
+    // boundaries; returns the upper bound of the bucket the percentile
+    // falls in, or maxMicros for the open-ended last bucket
+    static uint64_t histogramPercentile(const LatencyHistogram& histogram, double percentile);
+
     const Stats& getStats() const;
     void resetStats();
 
@@ -67,19 +135,72 @@ private:
         bool matches(const EventData* event) const;
     };
 
-    struct EventQueueItem {
-        std::unique_ptr<EventData> event;
-        int priority;
+    // Self-contained copy of an event queued for async delivery. Exactly
+    // one of payload (owned copy) or sharedPayload (pinned reference) is
+    // set when the event carries data.
+    struct QueuedEvent {
+        EventData event;
+        std::string sourcePlugin;
+        std::unique_ptr<char[]> payload;
+        std::shared_ptr<SharedPayload> sharedPayload;
+    };
 
-        bool operator<(const EventQueueItem& other) const {
-            return priority < other.priority; // Higher priority first
-        }
+    // Bounded lock-free multi-producer/single-consumer ring buffer
+    // (Vyukov-style sequence slots). Producers reserve a slot with a CAS
+    // on the enqueue counter and then write the slot; the processing
+    // thread is the only consumer.
+    class EventLane {
+    public:
+        static const size_t CAPACITY = 4096; // Must be a power of two
+
+        EventLane();
+        ~EventLane();
+
+        bool tryPush(std::unique_ptr<QueuedEvent> event);
+        std::unique_ptr<QueuedEvent> tryPop();
+        bool empty() const;
+        size_t depth() const; // Approximate; counters are read relaxed
+
+    private:
+        struct Slot {
+            std::atomic<uint64_t> sequence;
+            QueuedEvent* item;
+        };
+
+        Slot slots_[CAPACITY];
+        std::atomic<uint64_t> enqueuePos_;
+        std::atomic<uint64_t> dequeuePos_;
     };
 
-    std::vector<Subscription> subscriptions_;
-    std::priority_queue<EventQueueItem> eventQueue_;
+    static const int LANE_HIGH = 0;
+    static const int LANE_NORMAL = 1;
+    static const int LANE_LOW = 2;
+
+    // Dispatch table: per-type vectors kept sorted by priority (highest
+    // first) at subscribe time — subscribe is rare, emit is hot
+    std::unordered_map<EventType, std::vector<Subscription>> subscriptionsByType_;
+    EventLane eventLanes_[NUM_PRIORITY_LANES];
     mutable std::mutex mutex_;
-    Stats stats_;
+    mutable Stats stats_; // averageProcessingTime is refreshed from snapshots
+
+    // Lock-free latency accounting. Threads record into one of a few
+    // atomic stripes picked by thread id (relaxed fetch_adds, no mutex
+    // anywhere on the path); getStatsSnapshot merges the stripes on
+    // read. Striping instead of true thread-locals keeps block lifetime
+    // tied to the bus without a TLS registry.
+    static const size_t NUM_LATENCY_STRIPES = 8;
+
+    struct LatencyStripe {
+        std::atomic<uint64_t> counts[MAX_EVENT_TYPES][NUM_LATENCY_BUCKETS];
+        std::atomic<uint64_t> totals[MAX_EVENT_TYPES];
+        std::atomic<uint64_t> maxes[MAX_EVENT_TYPES];
+        LatencyStripe();
+    };
+
+    std::unique_ptr<LatencyStripe[]> latencyStripes_;
+
+    void recordLatency(EventType type, uint64_t micros);
+    static size_t bucketForMicros(uint64_t micros);
 
     std::unordered_map<std::string, bool> globalFilters_;
     std::unordered_map<EventType, std::string> eventFilters_;
@@ -91,10 +212,20 @@ private:
     std::thread processingThread_;
     std::condition_variable eventCondition_;
 
+    // Events delivered per stats/filter lock acquisition on the consumer side
+    static const size_t DRAIN_BATCH_SIZE = 32;
+
     void processingLoop();
+    bool drainLanes();
+    static size_t laneForPriority(int priority);
+    static int validateEvent(const EventData* event);
+    static int validateEventHeader(const EventData* event); // Shared path: no size cap
+    static std::unique_ptr<QueuedEvent> copyEvent(const EventData* event);
+    static std::unique_ptr<QueuedEvent> wrapSharedEvent(const EventData* event,
+                                                        std::shared_ptr<SharedPayload> payload);
     void processEvent(const EventData* event);
     bool shouldProcessEvent(const EventData* event) const;
-    std::vector<Subscription*> findMatchingSubscriptions(const EventData* event);
+    void insertSubscription(Subscription&& subscription);
 
     // Prevent copying
     EventBus(const EventBus&) = delete;
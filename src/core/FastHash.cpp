@@ -0,0 +1,101 @@
+#include "FastHash.h"
+#include <cstring>
+
+namespace Ragger {
+
+namespace {
+
+const uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+const uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+const uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+const uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+const uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+uint64_t rotl64(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t read64(const unsigned char* p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t read32(const unsigned char* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint64_t round64(uint64_t accumulator, uint64_t input) {
+    accumulator += input * PRIME64_2;
+    accumulator = rotl64(accumulator, 31);
+    return accumulator * PRIME64_1;
+}
+
+uint64_t mergeRound64(uint64_t hash, uint64_t accumulator) {
+    hash ^= round64(0, accumulator);
+    return hash * PRIME64_1 + PRIME64_4;
+}
+
+} // anonymous namespace
+
+uint64_t FastHash::hash64(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* end = p + size;
+    uint64_t hash;
+
+    if (size >= 32) {
+        uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+        uint64_t v2 = seed + PRIME64_2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME64_1;
+
+        const unsigned char* limit = end - 32;
+        do {
+            v1 = round64(v1, read64(p));
+            v2 = round64(v2, read64(p + 8));
+            v3 = round64(v3, read64(p + 16));
+            v4 = round64(v4, read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        hash = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        hash = mergeRound64(hash, v1);
+        hash = mergeRound64(hash, v2);
+        hash = mergeRound64(hash, v3);
+        hash = mergeRound64(hash, v4);
+    } else {
+        hash = seed + PRIME64_5;
+    }
+
+    hash += size;
+
+    while (p + 8 <= end) {
+        hash ^= round64(0, read64(p));
+        hash = rotl64(hash, 27) * PRIME64_1 + PRIME64_4;
+        p += 8;
+    }
+
+    if (p + 4 <= end) {
+        hash ^= static_cast<uint64_t>(read32(p)) * PRIME64_1;
+        hash = rotl64(hash, 23) * PRIME64_2 + PRIME64_3;
+        p += 4;
+    }
+
+    while (p < end) {
+        hash ^= (*p) * PRIME64_5;
+        hash = rotl64(hash, 11) * PRIME64_1;
+        p++;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+} // namespace Ragger
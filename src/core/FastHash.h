@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Ragger {
+
+// Fast non-cryptographic 64-bit hashing (the xxHash64 algorithm) for
+// change detection, where we only need collision resistance good enough
+// to compare a file against its own previous contents. Runs at memory
+// bandwidth on mapped input, where SHA256 caps out around 500 MB/s per
+// core. Use SHA256 (FileUtils::getFileHash) where an externally
+// comparable digest is required.
+class FastHash {
+public:
+    static uint64_t hash64(const void* data, size_t size, uint64_t seed = 0);
+
+private:
+    FastHash() = delete; // Static utility class
+};
+
+} // namespace Ragger
@@ -0,0 +1,287 @@
+#include "FileDiscovery.h"
+#include "ragger_plugin_api.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace Ragger {
+
+namespace {
+
+// gitignore-style glob match: `*` and `?` do not cross '/', `**`
+// matches any run of characters including '/'. Recursive so nested
+// wildcards each keep their own backtrack point; ignore patterns are
+// short enough that the worst case never matters.
+bool globMatch(const char* pattern, const char* text) {
+    while (*pattern) {
+        if (*pattern == '*') {
+            bool crossesSlash = (pattern[1] == '*');
+            while (*pattern == '*') ++pattern;
+
+            // "**/" also matches zero directories
+            if (crossesSlash && *pattern == '/') {
+                if (globMatch(pattern + 1, text)) {
+                    return true;
+                }
+            }
+
+            if (*pattern == '\0') {
+                return crossesSlash || strchr(text, '/') == nullptr;
+            }
+
+            // Try every split point the star is allowed to reach
+            for (const char* rest = text; ; ++rest) {
+                if (globMatch(pattern, rest)) {
+                    return true;
+                }
+                if (*rest == '\0' || (!crossesSlash && *rest == '/')) {
+                    return false;
+                }
+            }
+        } else if (*pattern == '?') {
+            if (*text == '\0' || *text == '/') {
+                return false;
+            }
+            ++pattern;
+            ++text;
+        } else {
+            if (*pattern != *text) {
+                return false;
+            }
+            ++pattern;
+            ++text;
+        }
+    }
+    return *text == '\0';
+}
+
+std::string trimRight(const std::string& s) {
+    size_t end = s.size();
+    while (end > 0 && (s[end - 1] == ' ' || s[end - 1] == '\t' || s[end - 1] == '\r')) {
+        --end;
+    }
+    return s.substr(0, end);
+}
+
+} // anonymous namespace
+
+int IgnoreRules::loadFromFile(const fs::path& ignoreFile) {
+    std::ifstream file(ignoreFile);
+    if (!file.is_open()) {
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        addPatternLine(line);
+    }
+    return RAGGER_SUCCESS;
+}
+
+void IgnoreRules::addPatternLine(const std::string& rawLine) {
+    std::string line = trimRight(rawLine);
+    if (line.empty() || line[0] == '#') {
+        return;
+    }
+
+    Pattern pattern;
+    pattern.negated = false;
+    pattern.directoryOnly = false;
+    pattern.anchored = false;
+
+    size_t start = 0;
+    if (line[start] == '!') {
+        pattern.negated = true;
+        ++start;
+    }
+    if (start < line.size() && line[start] == '/') {
+        pattern.anchored = true;
+        ++start;
+    }
+
+    std::string glob = line.substr(start);
+    if (!glob.empty() && glob.back() == '/') {
+        pattern.directoryOnly = true;
+        glob.pop_back();
+    }
+    if (glob.empty()) {
+        return;
+    }
+
+    // gitignore semantics: a slash anywhere in the pattern anchors it to
+    // the ignore file's directory; a bare name matches at any depth
+    if (glob.find('/') != std::string::npos) {
+        pattern.anchored = true;
+    }
+
+    pattern.glob = std::move(glob);
+    patterns_.push_back(std::move(pattern));
+}
+
+int IgnoreRules::match(const std::string& relativePath, bool isDirectory) const {
+    // Last matching pattern wins, so scan back to front and stop at the
+    // first hit
+    for (auto it = patterns_.rbegin(); it != patterns_.rend(); ++it) {
+        if (it->directoryOnly && !isDirectory) {
+            continue;
+        }
+
+        bool matched;
+        if (it->anchored) {
+            matched = globMatch(it->glob.c_str(), relativePath.c_str());
+        } else {
+            // Unanchored: match the basename at any depth
+            size_t slash = relativePath.rfind('/');
+            const char* basename = (slash == std::string::npos)
+                ? relativePath.c_str()
+                : relativePath.c_str() + slash + 1;
+            matched = globMatch(it->glob.c_str(), basename);
+        }
+
+        if (matched) {
+            return it->negated ? 0 : 1;
+        }
+    }
+    return -1;
+}
+
+bool FileDiscovery::isIgnored(const std::shared_ptr<const RuleChain>& chain,
+                              const fs::path& path, bool isDirectory) {
+    // .git is never indexable and is hard-pruned without consulting rules
+    if (isDirectory && path.filename() == ".git") {
+        return true;
+    }
+
+    // Deeper ignore files override shallower ones
+    for (const RuleChain* link = chain.get(); link; link = link->parent.get()) {
+        if (link->rules.empty()) {
+            continue;
+        }
+        std::error_code ec;
+        fs::path relative = path.lexically_relative(link->baseDir);
+        if (relative.empty() || *relative.begin() == "..") {
+            continue;
+        }
+        int verdict = link->rules.match(relative.generic_string(), isDirectory);
+        if (verdict >= 0) {
+            return verdict == 1;
+        }
+    }
+    return false;
+}
+
+std::vector<fs::path> FileDiscovery::discover(const fs::path& root, const FileFilter& filter,
+                                              size_t numThreads) {
+    std::vector<fs::path> results;
+    std::error_code ec;
+    if (!fs::is_directory(root, ec)) {
+        return results;
+    }
+
+    if (numThreads == 0) {
+        numThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    struct PendingDir {
+        fs::path path;
+        std::shared_ptr<const RuleChain> rules;
+    };
+
+    std::deque<PendingDir> queue;
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    size_t busyWorkers = 0;
+    bool done = false;
+
+    std::mutex resultsMutex;
+
+    queue.push_back({root, nullptr});
+
+    // Each worker pops a directory, loads its ignore files, filters its
+    // entries, and feeds surviving subdirectories back into the queue.
+    // Traversal ends when the queue is empty and no worker is mid-dir.
+    auto workerLoop = [&]() {
+        for (;;) {
+            PendingDir dir;
+            {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                queueCondition.wait(lock, [&]() { return !queue.empty() || done; });
+                if (queue.empty()) {
+                    return;
+                }
+                dir = std::move(queue.front());
+                queue.pop_front();
+                ++busyWorkers;
+            }
+
+            // Merge this directory's ignore files onto the inherited
+            // chain; .raggerignore loads after .gitignore so its rules
+            // take precedence
+            std::shared_ptr<const RuleChain> rules = dir.rules;
+            {
+                auto link = std::make_shared<RuleChain>();
+                link->parent = dir.rules;
+                link->baseDir = dir.path;
+                link->rules.loadFromFile(dir.path / ".gitignore");
+                link->rules.loadFromFile(dir.path / ".raggerignore");
+                if (!link->rules.empty()) {
+                    rules = std::move(link);
+                }
+            }
+
+            std::vector<fs::path> localFiles;
+            std::vector<PendingDir> localDirs;
+
+            std::error_code iterEc;
+            for (const auto& entry : fs::directory_iterator(dir.path, iterEc)) {
+                std::error_code entryEc;
+                if (entry.is_directory(entryEc)) {
+                    // Prune before descending: ignored subtrees are
+                    // never even listed
+                    if (!isIgnored(rules, entry.path(), true)) {
+                        localDirs.push_back({entry.path(), rules});
+                    }
+                } else if (entry.is_regular_file(entryEc)) {
+                    if (!isIgnored(rules, entry.path(), false) && filter(entry.path())) {
+                        localFiles.push_back(entry.path());
+                    }
+                }
+            }
+
+            if (!localFiles.empty()) {
+                std::lock_guard<std::mutex> lock(resultsMutex);
+                results.insert(results.end(),
+                               std::make_move_iterator(localFiles.begin()),
+                               std::make_move_iterator(localFiles.end()));
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                for (auto& sub : localDirs) {
+                    queue.push_back(std::move(sub));
+                }
+                --busyWorkers;
+                if (queue.empty() && busyWorkers == 0) {
+                    done = true;
+                }
+            }
+            queueCondition.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < numThreads; ++i) {
+        workers.emplace_back(workerLoop);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    return results;
+}
+
+} // namespace Ragger
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace Ragger {
+
+// Compiled ignore rules from one .gitignore/.raggerignore file. Patterns
+// are matched gitignore-style: `*` and `?` stop at path separators,
+// `**` crosses them, a leading `/` anchors to the ignore file's
+// directory, a trailing `/` restricts to directories, and `!` negates.
+// Within one file the last matching pattern wins.
+class IgnoreRules {
+public:
+    // Parse an ignore file; missing files leave the rule set empty
+    int loadFromFile(const fs::path& ignoreFile);
+    void addPatternLine(const std::string& line);
+
+    bool empty() const { return patterns_.empty(); }
+
+    // Match a path given relative to the ignore file's directory.
+    // Returns 1 (ignored), 0 (explicitly unignored) or -1 (no rule).
+    int match(const std::string& relativePath, bool isDirectory) const;
+
+private:
+    struct Pattern {
+        std::string glob;
+        bool negated;
+        bool directoryOnly;
+        bool anchored; // Leading slash or interior slash: match full relative path
+    };
+
+    std::vector<Pattern> patterns_;
+};
+
+// Parallel gitignore-aware directory traversal. Worker threads share a
+// queue of pending directories; each pops one, merges that directory's
+// ignore files onto the inherited rule chain, and prunes ignored
+// subtrees BEFORE descending — so enumeration cost scales with the
+// relevant files, not the total tree (build/, .git/, node_modules/ are
+// never walked). Used by IndexManager::discoverFiles.
+class FileDiscovery {
+public:
+    // Returns true for files the caller wants collected
+    using FileFilter = std::function<bool(const fs::path&)>;
+
+    // numThreads == 0 picks hardware_concurrency. Result order is
+    // unspecified (parallel traversal).
+    static std::vector<fs::path> discover(const fs::path& root, const FileFilter& filter,
+                                          size_t numThreads = 0);
+
+private:
+    // One link in the inherited rule chain; deeper ignore files override
+    // shallower ones, so evaluation walks child to parent
+    struct RuleChain {
+        std::shared_ptr<const RuleChain> parent;
+        fs::path baseDir;
+        IgnoreRules rules;
+    };
+
+    static bool isIgnored(const std::shared_ptr<const RuleChain>& chain,
+                          const fs::path& path, bool isDirectory);
+};
+
+} // namespace Ragger
@@ -1,5 +1,6 @@
 #include "FileUtils.h"
 #include "ragger_plugin_api.h"
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -8,8 +9,80 @@
 #include <openssl/evp.h>
 #include <openssl/sha.h>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace Ragger {
 
+FileView::~FileView() {
+    unmap();
+}
+
+FileView::FileView(FileView&& other) noexcept
+    : data_(other.data_), size_(other.size_), mapped_(other.mapped_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.mapped_ = false;
+}
+
+FileView& FileView::operator=(FileView&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        data_ = other.data_;
+        size_ = other.size_;
+        mapped_ = other.mapped_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.mapped_ = false;
+    }
+    return *this;
+}
+
+int FileView::map(const fs::path& path) {
+    unmap();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    if (st.st_size == 0) {
+        // Nothing to map; an empty view is still valid
+        ::close(fd);
+        mapped_ = true;
+        return RAGGER_SUCCESS;
+    }
+
+    void* mapping = mmap(nullptr, static_cast<size_t>(st.st_size),
+                         PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file alive
+    if (mapping == MAP_FAILED) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    data_ = static_cast<const char*>(mapping);
+    size_ = static_cast<size_t>(st.st_size);
+    mapped_ = true;
+    return RAGGER_SUCCESS;
+}
+
+void FileView::unmap() {
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+}
+
 int FileUtils::readFile(const fs::path& path, char** content, size_t* size) {
     // Input validation
     if (!content || !size) {
@@ -20,30 +93,22 @@ int FileUtils::readFile(const fs::path& path, char** content, size_t* size) {
         return RAGGER_ERROR_INVALID_ARGUMENT;
     }
     
-    try {
-        std::ifstream file(path, std::ios::binary | std::ios::ate);
-        if (!file) {
-            return RAGGER_ERROR_FILE_NOT_FOUND;
-        }
-
-        std::streamsize fileSize = file.tellg();
-        file.seekg(0, std::ios::beg);
-
-        *content = new char[fileSize + 1];
-        if (!file.read(*content, fileSize)) {
-            delete[] *content;
-            return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
-        }
-
-        (*content)[fileSize] = '\0';
-        *size = fileSize;
-
-        return RAGGER_SUCCESS;
+    // Map the file and copy once into the caller-owned buffer; callers
+    // that can work on a borrowed span should use FileView directly
+    FileView fileView;
+    int result = fileView.map(path);
+    if (result != RAGGER_SUCCESS) {
+        return result;
+    }
 
-    } catch (const std::exception& e) {
-        std::cerr << "FileUtils: Error reading file " << path.string() << ": " << e.what() << std::endl;
-        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    *content = new char[fileView.size() + 1];
+    if (fileView.size() > 0) {
+        memcpy(*content, fileView.data(), fileView.size());
     }
+    (*content)[fileView.size()] = '\0';
+    *size = fileView.size();
+
+    return RAGGER_SUCCESS;
 }
 
 int FileUtils::writeFile(const fs::path& path, const char* content, size_t size) {
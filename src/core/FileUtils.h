@@ -1,12 +1,45 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <filesystem>
 
 namespace fs = std::filesystem;
 
 namespace Ragger {
 
+// Read-only memory-mapped view of a file. Callers get string_view spans
+// straight into the page cache, so hashing, tokenizing and parsing the
+// same file share one mapping instead of each making a heap copy. The
+// mapping is released when the view is destroyed or remapped; spans must
+// not outlive it. Move-only.
+class FileView {
+public:
+    FileView() = default;
+    ~FileView();
+
+    FileView(FileView&& other) noexcept;
+    FileView& operator=(FileView&& other) noexcept;
+
+    // Map the file read-only; any previous mapping is released first
+    int map(const fs::path& path);
+    void unmap();
+
+    bool isMapped() const { return mapped_; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    std::string_view view() const { return std::string_view(data_, size_); }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+
+    // Prevent copying
+    FileView(const FileView&) = delete;
+    FileView& operator=(const FileView&) = delete;
+};
+
 class FileUtils {
 public:
     // File operations
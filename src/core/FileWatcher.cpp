@@ -0,0 +1,244 @@
+#include "FileWatcher.h"
+#include "EventBus.h"
+#include "IndexManager.h"
+#include "ragger_plugin_api.h"
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace Ragger {
+
+namespace {
+
+// Directory events we care about: content changes plus renames in/out,
+// which is how editors usually save
+const uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_CREATE | IN_MOVED_TO |
+                            IN_DELETE | IN_MOVED_FROM;
+
+const char* WATCHER_SOURCE = "core.filewatcher";
+
+} // anonymous namespace
+
+FileWatcher::FileWatcher(IndexManager* indexManager, EventBus* eventBus)
+    : indexManager_(indexManager), eventBus_(eventBus),
+      inotifyFd_(-1), debounceDelay_(500), running_(false) {
+}
+
+FileWatcher::~FileWatcher() {
+    stop();
+}
+
+int FileWatcher::watchDirectory(const fs::path& directory) {
+    if (!fs::exists(directory) || !fs::is_directory(directory)) {
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+
+    if (inotifyFd_ < 0) {
+        inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotifyFd_ < 0) {
+            std::cerr << "FileWatcher: inotify_init failed: " << strerror(errno) << std::endl;
+            return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+        }
+    }
+
+    int result = addWatch(directory);
+    if (result != RAGGER_SUCCESS) {
+        return result;
+    }
+
+    try {
+        for (const auto& entry : fs::recursive_directory_iterator(
+                 directory, fs::directory_options::skip_permission_denied)) {
+            if (entry.is_directory()) {
+                addWatch(entry.path());
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "FileWatcher: Error walking " << directory.string()
+                  << ": " << e.what() << std::endl;
+    }
+
+    return RAGGER_SUCCESS;
+}
+
+int FileWatcher::start() {
+    if (running_.load()) {
+        return RAGGER_SUCCESS;
+    }
+    if (inotifyFd_ < 0) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED; // Nothing watched yet
+    }
+
+    running_.store(true);
+    watcherThread_ = std::thread(&FileWatcher::watcherLoop, this);
+    std::cout << "FileWatcher: Started" << std::endl;
+    return RAGGER_SUCCESS;
+}
+
+void FileWatcher::stop() {
+    if (running_.exchange(false)) {
+        if (watcherThread_.joinable()) {
+            watcherThread_.join();
+        }
+        std::cout << "FileWatcher: Stopped" << std::endl;
+    }
+
+    if (inotifyFd_ >= 0) {
+        ::close(inotifyFd_);
+        inotifyFd_ = -1;
+    }
+
+    std::lock_guard<std::mutex> lock(watchMutex_);
+    watchedDirectories_.clear();
+    pendingChanges_.clear();
+}
+
+void FileWatcher::setDebounceDelay(int milliseconds) {
+    debounceDelay_ = milliseconds;
+}
+
+void FileWatcher::watcherLoop() {
+    while (running_.load()) {
+        struct pollfd pfd;
+        pfd.fd = inotifyFd_;
+        pfd.events = POLLIN;
+
+        // Wake often enough to flush debounced paths on time
+        int timeout = std::max(10, debounceDelay_ / 4);
+        int ready = poll(&pfd, 1, timeout);
+
+        if (ready > 0 && (pfd.revents & POLLIN)) {
+            readEvents();
+        }
+        flushQuietChanges();
+    }
+}
+
+void FileWatcher::readEvents() {
+    // Large enough for a burst of events with long names
+    char buffer[16 * 1024] __attribute__((aligned(8)));
+
+    for (;;) {
+        ssize_t length = read(inotifyFd_, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break; // EAGAIN: burst drained
+        }
+
+        ssize_t offset = 0;
+        while (offset < length) {
+            const struct inotify_event* event =
+                reinterpret_cast<const struct inotify_event*>(buffer + offset);
+            offset += sizeof(struct inotify_event) + event->len;
+
+            fs::path directory;
+            {
+                std::lock_guard<std::mutex> lock(watchMutex_);
+                if (event->mask & IN_IGNORED) {
+                    watchedDirectories_.erase(event->wd);
+                    continue;
+                }
+                auto it = watchedDirectories_.find(event->wd);
+                if (it == watchedDirectories_.end()) {
+                    continue;
+                }
+                directory = it->second;
+            }
+
+            if (event->len == 0) {
+                continue;
+            }
+            fs::path path = directory / event->name;
+
+            if (event->mask & IN_ISDIR) {
+                // New subtrees get watched as they appear
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    watchDirectory(path);
+                }
+                continue;
+            }
+
+            bool removed = (event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0;
+            recordChange(path, removed);
+        }
+    }
+}
+
+void FileWatcher::recordChange(const fs::path& path, bool removed) {
+    std::lock_guard<std::mutex> lock(watchMutex_);
+    PendingChange& change = pendingChanges_[path.string()];
+    change.lastEvent = std::chrono::steady_clock::now();
+    change.removed = removed;
+}
+
+// Reindex paths whose burst has gone quiet for the debounce delay
+void FileWatcher::flushQuietChanges() {
+    std::vector<std::pair<std::string, bool>> ready;
+    auto now = std::chrono::steady_clock::now();
+    auto quietPeriod = std::chrono::milliseconds(debounceDelay_);
+
+    {
+        std::lock_guard<std::mutex> lock(watchMutex_);
+        for (auto it = pendingChanges_.begin(); it != pendingChanges_.end();) {
+            if (now - it->second.lastEvent >= quietPeriod) {
+                ready.emplace_back(it->first, it->second.removed);
+                it = pendingChanges_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    if (ready.empty()) {
+        return;
+    }
+
+    for (const auto& [path, removed] : ready) {
+        if (removed || !fs::exists(path)) {
+            indexManager_->removeFromIndex(path);
+            continue;
+        }
+        if (indexManager_->updateFileIndex(path) == RAGGER_SUCCESS) {
+            emitFileEvent(EVENT_FILE_PARSED, path);
+        }
+    }
+
+    // One completion event per flushed batch, not per file
+    emitFileEvent(EVENT_INDEXING_COMPLETED, "");
+}
+
+int FileWatcher::addWatch(const fs::path& directory) {
+    int wd = inotify_add_watch(inotifyFd_, directory.c_str(), WATCH_MASK);
+    if (wd < 0) {
+        std::cerr << "FileWatcher: inotify_add_watch failed for "
+                  << directory.string() << ": " << strerror(errno) << std::endl;
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    std::lock_guard<std::mutex> lock(watchMutex_);
+    watchedDirectories_[wd] = directory;
+    return RAGGER_SUCCESS;
+}
+
+void FileWatcher::emitFileEvent(int type, const std::string& path) {
+    if (!eventBus_) {
+        return;
+    }
+
+    EventData event;
+    event.type = static_cast<EventType>(type);
+    event.timestamp = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    event.sourcePlugin = WATCHER_SOURCE;
+    event.data = path.empty() ? nullptr : const_cast<char*>(path.c_str());
+    event.dataSize = path.empty() ? 0 : path.size() + 1;
+
+    // Async emission copies the payload, so the stack path is safe
+    eventBus_->emitEventAsync(&event);
+}
+
+} // namespace Ragger
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace Ragger {
+
+class EventBus;
+class IndexManager;
+
+// inotify-based filesystem watcher driving incremental reindexing.
+// Change bursts (editor save-then-rename, git checkout) are coalesced
+// per path with a debounce delay; once a path has been quiet for that
+// long it is fed to IndexManager::updateFileIndex (or removeFromIndex
+// for deletions) and EVENT_FILE_PARSED / EVENT_INDEXING_COMPLETED are
+// emitted so rankers update incrementally. Index freshness then costs
+// proportional to the change rate instead of a periodic full sweep.
+class FileWatcher {
+public:
+    FileWatcher(IndexManager* indexManager, EventBus* eventBus);
+    ~FileWatcher();
+
+    // Recursively watch a directory tree (new subdirectories are picked
+    // up as they appear)
+    int watchDirectory(const fs::path& directory);
+
+    int start();
+    void stop();
+    bool isRunning() const { return running_.load(); }
+
+    // Quiet period before a changed path is reindexed
+    void setDebounceDelay(int milliseconds);
+
+private:
+    // A path waiting out its debounce window
+    struct PendingChange {
+        std::chrono::steady_clock::time_point lastEvent;
+        bool removed;
+    };
+
+    IndexManager* indexManager_;
+    EventBus* eventBus_;
+    int inotifyFd_;
+    int debounceDelay_;
+
+    std::atomic<bool> running_;
+    std::thread watcherThread_;
+
+    std::mutex watchMutex_; // Guards watchedDirectories_ and pendingChanges_
+    std::unordered_map<int, fs::path> watchedDirectories_; // watch descriptor -> dir
+    std::unordered_map<std::string, PendingChange> pendingChanges_;
+
+    void watcherLoop();
+    void readEvents();
+    void flushQuietChanges();
+    int addWatch(const fs::path& directory);
+    void recordChange(const fs::path& path, bool removed);
+    void emitFileEvent(int type, const std::string& path);
+
+    // Prevent copying
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+};
+
+} // namespace Ragger
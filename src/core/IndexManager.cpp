@@ -1,6 +1,22 @@
 #include "IndexManager.h"
+#include "EventBus.h"
+#include "FastHash.h"
+#include "Logger.h"
+#include "Trace.h"
+#include "FileUtils.h"
+#include "FileDiscovery.h"
+#include "IndexSnapshot.h"
+#include "Tokenizer.h"
 // spdlog disabled
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <thread>
 #include <sstream>
 #include <iostream>
 #include <openssl/evp.h>
@@ -9,7 +25,8 @@
 namespace Ragger {
 
 IndexManager::IndexManager()
-    : db_(nullptr), maxFileSize_(10 * 1024 * 1024), debounceDelay_(500) {
+    : numShards_(DEFAULT_SHARD_COUNT), maxFileSize_(10 * 1024 * 1024), debounceDelay_(500),
+      fastHashing_(true), hashesSinceSnapshot_(0), indexGeneration_(0) {
     dbPath_ = "data/index.db";
 }
 
@@ -17,44 +34,215 @@ IndexManager::~IndexManager() {
     shutdown();
 }
 
+// Stable path-hash partitioning: a file always lands in the same shard,
+// so per-shard rowids stay meaningful across runs
+IndexManager::Shard& IndexManager::shardForPath(const fs::path& filePath) {
+    std::string pathStr = filePath.string();
+    uint64_t hash = FastHash::hash64(pathStr.data(), pathStr.size());
+    return *shards_[hash % shards_.size()];
+}
+
+size_t IndexManager::getShardCount() const {
+    return shards_.empty() ? numShards_ : shards_.size();
+}
+
+size_t IndexManager::shardIndexForPath(const fs::path& filePath) const {
+    std::string pathStr = filePath.string();
+    uint64_t hash = FastHash::hash64(pathStr.data(), pathStr.size());
+    return hash % (shards_.empty() ? numShards_ : shards_.size());
+}
+
+// Shard 0 keeps the configured path so existing single-shard databases
+// stay valid; shard N>0 lives alongside as <stem>.shardN<ext>
+fs::path IndexManager::shardDbPath(size_t shardIndex) const {
+    if (shardIndex == 0) {
+        return dbPath_;
+    }
+    fs::path path = dbPath_.parent_path() / dbPath_.stem();
+    path += ".shard" + std::to_string(shardIndex);
+    path += dbPath_.extension();
+    return path;
+}
+
 int IndexManager::initialize() {
     // Create data directory if it doesn't exist
     fs::create_directories(dbPath_.parent_path());
 
-    // Open SQLite database
-    int result = sqlite3_open(dbPath_.string().c_str(), &db_);
-    if (result != SQLITE_OK) {
-        std::cerr << "IndexManager: Failed to open database: " << sqlite3_errmsg(db_) << std::endl;
-        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    shards_.clear();
+    for (size_t i = 0; i < numShards_; ++i) {
+        auto shard = std::make_unique<Shard>();
+        shard->path = shardDbPath(i);
+
+        int result = sqlite3_open(shard->path.string().c_str(), &shard->db);
+        if (result != SQLITE_OK) {
+            std::cerr << "IndexManager: Failed to open shard " << i << ": "
+                      << sqlite3_errmsg(shard->db) << std::endl;
+            shards_.push_back(std::move(shard));
+            shutdown();
+            return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+        }
+
+        // WAL lets readers proceed during index writes and batches fsyncs
+        executeQuery(*shard, "PRAGMA journal_mode=WAL");
+        executeQuery(*shard, "PRAGMA synchronous=NORMAL");
+
+        result = createTables(*shard);
+        if (result != RAGGER_SUCCESS) {
+            shards_.push_back(std::move(shard));
+            shutdown();
+            return result;
+        }
+
+        shards_.push_back(std::move(shard));
+    }
+
+    // Read pools open read-only connections, so the schemas must exist first
+    initializeConnectionPools();
+
+    // Warm the hash caches from the last snapshot so the first
+    // needsReindexing sweep doesn't rehash the world
+    loadSnapshot();
+
+    // Rebuild the in-memory symbol index from the persisted blocks
+    loadSymbolIndex();
+
+    std::cout << "IndexManager: Database initialized at " << dbPath_.string()
+              << " (" << shards_.size() << " shards)" << std::endl;
+    return RAGGER_SUCCESS;
+}
+
+fs::path IndexManager::snapshotPath() const {
+    fs::path path = dbPath_;
+    path += ".snapshot";
+    return path;
+}
+
+int IndexManager::loadSnapshot() {
+    IndexSnapshot snapshot;
+    if (snapshot.open(snapshotPath()) != RAGGER_SUCCESS) {
+        return RAGGER_ERROR_FILE_NOT_FOUND; // No snapshot yet; cold start
     }
-    
-    // Initialize connection pool
-    initializeConnectionPool();
 
-    // Create tables
-    result = createTables();
+    std::vector<IndexSnapshot::FileRecord> records;
+    int result = snapshot.readAll(records);
     if (result != RAGGER_SUCCESS) {
-        shutdown();
         return result;
     }
 
-    std::cout << "IndexManager: Database initialized at " << dbPath_.string() << std::endl;
+    std::lock_guard<std::mutex> lock(hashMutex_);
+    for (const auto& record : records) {
+        fileHashes_[record.path] = record.hash;
+        hashCache_[record.path] = record.mtime;
+    }
+
+    std::cout << "IndexManager: Warm-started " << records.size() << " files from snapshot" << std::endl;
     return RAGGER_SUCCESS;
 }
 
+int IndexManager::loadSymbolIndex() {
+    symbolIndex_.clear();
+
+    for (auto& shard : shards_) {
+        sqlite3_stmt* stmt = getCachedStatement(*shard,
+            "SELECT id, name, file_path FROM code_blocks WHERE name IS NOT NULL AND name != ''");
+        if (!stmt) {
+            return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+        }
+
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            int64_t blockId = sqlite3_column_int64(stmt, 0);
+            const char* name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+            const char* filePath = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+            if (name && filePath) {
+                symbolIndex_.add(blockId, name, filePath);
+            }
+        }
+        sqlite3_reset(stmt);
+    }
+
+    if (symbolIndex_.size() > 0) {
+        std::cout << "IndexManager: Symbol index loaded with " << symbolIndex_.size()
+                  << " symbols" << std::endl;
+    }
+    return RAGGER_SUCCESS;
+}
+
+int IndexManager::saveSnapshot() {
+    // Dump the in-memory hash cache rather than the shards' files
+    // tables: it is a superset (hashes computed while deciding a file
+    // did NOT need reindexing never reach a shard) and the next start
+    // validates every entry lazily against mtime anyway
+    std::vector<IndexSnapshot::FileRecord> records;
+    {
+        std::lock_guard<std::mutex> lock(hashMutex_);
+        records.reserve(fileHashes_.size());
+        for (const auto& pair : fileHashes_) {
+            auto timeIt = hashCache_.find(pair.first);
+            if (timeIt == hashCache_.end()) {
+                continue; // No mtime to validate against; not worth keeping
+            }
+            IndexSnapshot::FileRecord record;
+            record.path = pair.first;
+            record.hash = pair.second;
+            record.mtime = timeIt->second;
+            record.fileSize = 0;
+            records.push_back(std::move(record));
+        }
+        hashesSinceSnapshot_ = 0;
+    }
+
+    // Fill sizes outside the lock; a vanished file just records zero
+    for (auto& record : records) {
+        std::error_code ec;
+        auto size = fs::file_size(record.path, ec);
+        record.fileSize = ec ? 0 : static_cast<int64_t>(size);
+    }
+
+    return IndexSnapshot::write(snapshotPath(), records);
+}
+
+void IndexManager::maybeSaveSnapshot() {
+    {
+        std::lock_guard<std::mutex> lock(hashMutex_);
+        if (hashesSinceSnapshot_ < SNAPSHOT_SAVE_INTERVAL) {
+            return;
+        }
+    }
+    saveSnapshot();
+}
+
 void IndexManager::shutdown() {
-    // Cleanup connection pool first
-    cleanupConnectionPool();
-    
-    if (db_) {
-        sqlite3_close(db_);
-        db_ = nullptr;
-    }
-    fileHashes_.clear();
+    // Persist a snapshot for the next warm start while the databases are
+    // still open
+    if (!shards_.empty()) {
+        saveSnapshot();
+    }
+
+    // Cleanup connection pools first
+    cleanupConnectionPools();
+
+    // Finalize cached statements before closing their connections
+    clearStatementCaches();
+
+    for (auto& shard : shards_) {
+        if (shard->db) {
+            sqlite3_close(shard->db);
+            shard->db = nullptr;
+        }
+    }
+    shards_.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(hashMutex_);
+        fileHashes_.clear();
+        hashCache_.clear();
+    }
     std::cout << "IndexManager: Shutdown complete" << std::endl;
 }
 
 int IndexManager::indexFile(const fs::path& filePath) {
+    RAGGER_TRACE_SPAN("index-file");
+
     if (!fs::exists(filePath) || !fs::is_regular_file(filePath)) {
         return RAGGER_ERROR_FILE_NOT_FOUND;
     }
@@ -83,11 +271,21 @@ int IndexManager::indexFile(const fs::path& filePath) {
         return result;
     }
 
-    // TODO: Parse file and extract code blocks/symbols
-    // This would use the parser plugins in a full implementation
+    // Index file content into code_blocks and the inverted index
+    result = indexFileContent(filePath);
+    if (result != RAGGER_SUCCESS) {
+        return result;
+    }
 
-    fileHashes_[filePath.string()] = hash;
-    std::cout << "IndexManager: Indexed file " << filePath.string() << std::endl;
+    {
+        std::lock_guard<std::mutex> lock(hashMutex_);
+        fileHashes_[filePath.string()] = hash;
+    }
+    RAGGER_LOG_DEBUG("IndexManager: Indexed file " + filePath.string());
+
+    // A long stream of single-file updates (e.g. from the file watcher)
+    // should not hoard unsaved hashes until shutdown
+    maybeSaveSnapshot();
 
     return RAGGER_SUCCESS;
 }
@@ -98,56 +296,575 @@ int IndexManager::indexDirectory(const fs::path& directory) {
     }
 
     auto files = discoverFiles(directory);
-    int indexedCount = 0;
+    if (files.empty()) {
+        std::cout << "IndexManager: Indexed 0 files in directory " << directory.string() << std::endl;
+        return 0;
+    }
+
+    size_t numWorkers = std::max<size_t>(1, std::thread::hardware_concurrency());
+    numWorkers = std::min(numWorkers, files.size());
+
+    // Workers pull files from a shared cursor, do the CPU-heavy work
+    // (hashing, reading, tokenizing), and route the results to per-shard
+    // queues; one writer thread per shard batches that shard's inserts.
+    // Path-hash partitioning means the shard writers never contend.
+    std::atomic<size_t> nextFile{0};
+    std::atomic<size_t> activeWorkers{numWorkers};
+    std::atomic<int> indexedCount{0};
+
+    struct ShardQueue {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<PendingFile> pending;
+    };
+    std::vector<ShardQueue> queues(shards_.size());
+
+    auto workerLoop = [&]() {
+        size_t i;
+        while ((i = nextFile.fetch_add(1)) < files.size()) {
+            const fs::path& file = files[i];
+
+            if (!needsReindexing(file)) {
+                continue;
+            }
+
+            // One mapping serves hashing, tokenizing and the DB copy
+            FileView fileView;
+            if (fileView.map(file) != RAGGER_SUCCESS) {
+                continue;
+            }
+
+            PendingFile pending;
+            pending.path = file;
+            pending.hash = calculateFileHash(file, fileView.view());
+            if (pending.hash.empty()) {
+                continue;
+            }
+
+            pending.tokenFreqs = Tokenizer::countTokens(fileView.view());
+            pending.content.assign(fileView.data(), fileView.size());
+
+            ShardQueue& queue = queues[shardIndexForPath(file)];
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.pending.push_back(std::move(pending));
+            }
+            queue.condition.notify_one();
+        }
+
+        if (activeWorkers.fetch_sub(1) == 1) {
+            // Last worker out wakes every shard writer for shutdown
+            for (ShardQueue& queue : queues) {
+                queue.condition.notify_all();
+            }
+        }
+    };
+
+    // Shard writers: drain their queue in transaction batches so bulk
+    // indexing doesn't pay a commit per file
+    static const size_t BATCH_SIZE = 64;
+    auto shardWriterLoop = [&](size_t shardIndex) {
+        Shard& shard = *shards_[shardIndex];
+        ShardQueue& queue = queues[shardIndex];
+        size_t batchCount = 0;
+        executeQuery(shard, "BEGIN IMMEDIATE");
+
+        for (;;) {
+            PendingFile pending;
+            {
+                std::unique_lock<std::mutex> lock(queue.mutex);
+                queue.condition.wait(lock, [&]() {
+                    return !queue.pending.empty() || activeWorkers.load() == 0;
+                });
+
+                if (queue.pending.empty()) {
+                    break; // All workers finished and queue drained
+                }
+
+                pending = std::move(queue.pending.front());
+                queue.pending.pop_front();
+            }
+
+            if (writeIndexedFile(pending) == RAGGER_SUCCESS) {
+                indexedCount.fetch_add(1);
+            }
 
-    for (const auto& file : files) {
-        if (indexFile(file) == RAGGER_SUCCESS) {
-            indexedCount++;
+            if (++batchCount >= BATCH_SIZE) {
+                executeQuery(shard, "COMMIT");
+                executeQuery(shard, "BEGIN IMMEDIATE");
+                batchCount = 0;
+            }
         }
+
+        executeQuery(shard, "COMMIT");
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < numWorkers; ++i) {
+        workers.emplace_back(workerLoop);
+    }
+    std::vector<std::thread> shardWriters;
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        shardWriters.emplace_back(shardWriterLoop, i);
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (auto& writer : shardWriters) {
+        writer.join();
+    }
+
+    // Persist the freshly computed hashes so a crash mid-session still
+    // warm-starts from this run's work
+    maybeSaveSnapshot();
+
+    std::cout << "IndexManager: Indexed " << indexedCount.load() << " files in directory " << directory.string() << std::endl;
+    return indexedCount.load();
+}
+
+int IndexManager::writeIndexedFile(const PendingFile& pending) {
+    deleteFileRecords(pending.path);
+
+    int result = insertFileRecord(pending.path, pending.hash);
+    if (result != RAGGER_SUCCESS) {
+        return result;
+    }
+
+    result = indexFileContent(pending.path, pending.content, pending.tokenFreqs);
+    if (result != RAGGER_SUCCESS) {
+        return result;
     }
 
-    std::cout << "IndexManager: Indexed " << indexedCount << " files in directory " << directory.string() << std::endl;
-    return indexedCount;
+    {
+        std::lock_guard<std::mutex> lock(hashMutex_);
+        fileHashes_[pending.path.string()] = pending.hash;
+    }
+
+    return RAGGER_SUCCESS;
 }
 
 int IndexManager::removeFromIndex(const fs::path& filePath) {
     int result = deleteFileRecords(filePath);
     if (result == RAGGER_SUCCESS) {
+        std::lock_guard<std::mutex> lock(hashMutex_);
         fileHashes_.erase(filePath.string());
-        std::cout << "IndexManager: Removed file from index: " << filePath.string() << std::endl;
+        RAGGER_LOG_DEBUG("IndexManager: Removed file from index: " + filePath.string());
     }
     return result;
 }
 
 int IndexManager::findFilesByContent(const std::string& query, std::vector<fs::path>& results) {
-    // TODO: Implement full-text search
-    // This is a placeholder implementation
     results.clear();
-    std::cout << "IndexManager: Searching for '" << query << "'" << std::endl;
+
+    auto queryTokens = tokenizeContent(query);
+    if (queryTokens.empty() || shards_.empty()) {
+        return RAGGER_SUCCESS;
+    }
+
+    // Scatter-gather: every shard walks its own postings on its own
+    // thread through its own read connection, so cross-shard queries pay
+    // the latency of the slowest shard instead of the sum. Each shard
+    // returns raw (file, tf) hits per token; document frequencies are
+    // summed globally afterwards so IDF matches the unsharded behaviour.
+    struct TokenHits {
+        int queryWeight;
+        int64_t documentFrequency;
+        std::vector<std::pair<std::string, int64_t>> fileFrequencies;
+    };
+
+    std::vector<std::pair<std::string, int>> tokens(queryTokens.begin(), queryTokens.end());
+    std::vector<TokenHits> tokenHits(tokens.size());
+    for (size_t t = 0; t < tokens.size(); ++t) {
+        tokenHits[t].queryWeight = tokens[t].second;
+        tokenHits[t].documentFrequency = 0;
+    }
+
+    std::atomic<int64_t> totalBlocks{0};
+    std::mutex mergeMutex;
+
+    auto shardQuery = [&](size_t shardIndex) {
+        PoolLease lease(this, shards_[shardIndex].get());
+        if (!lease.conn) {
+            return;
+        }
+
+        sqlite3_stmt* countStmt = getPooledStatement(lease.conn, "SELECT COUNT(*) FROM code_blocks");
+        if (countStmt) {
+            if (sqlite3_step(countStmt) == SQLITE_ROW) {
+                totalBlocks.fetch_add(sqlite3_column_int64(countStmt, 0));
+            }
+            sqlite3_reset(countStmt);
+        }
+
+        sqlite3_stmt* stmt = getPooledStatement(lease.conn,
+            "SELECT cb.file_path, ii.frequency "
+            "FROM inverted_index ii "
+            "JOIN code_blocks cb ON cb.id = ii.block_id "
+            "WHERE ii.token = ?");
+        if (!stmt) {
+            return;
+        }
+
+        for (size_t t = 0; t < tokens.size(); ++t) {
+            sqlite3_bind_text(stmt, 1, tokens[t].first.c_str(), -1, SQLITE_TRANSIENT);
+
+            std::vector<std::pair<std::string, int64_t>> localHits;
+            while (sqlite3_step(stmt) == SQLITE_ROW) {
+                const char* filePath = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                if (filePath) {
+                    localHits.emplace_back(filePath, sqlite3_column_int64(stmt, 1));
+                }
+            }
+            sqlite3_reset(stmt);
+
+            if (!localHits.empty()) {
+                std::lock_guard<std::mutex> lock(mergeMutex);
+                tokenHits[t].documentFrequency += static_cast<int64_t>(localHits.size());
+                tokenHits[t].fileFrequencies.insert(tokenHits[t].fileFrequencies.end(),
+                                                    localHits.begin(), localHits.end());
+            }
+        }
+    };
+
+    std::vector<std::thread> shardThreads;
+    shardThreads.reserve(shards_.size());
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        shardThreads.emplace_back(shardQuery, i);
+    }
+    for (auto& thread : shardThreads) {
+        thread.join();
+    }
+
+    double total = static_cast<double>(totalBlocks.load());
+    if (total <= 0.0) {
+        return RAGGER_SUCCESS;
+    }
+
+    // TF-IDF with global document frequencies across all shards
+    std::unordered_map<std::string, double> fileScores;
+    for (const TokenHits& hits : tokenHits) {
+        if (hits.documentFrequency <= 0) continue;
+        double idf = std::log(1.0 + total / static_cast<double>(hits.documentFrequency));
+        for (const auto& hit : hits.fileFrequencies) {
+            fileScores[hit.first] += static_cast<double>(hit.second) * idf * hits.queryWeight;
+        }
+    }
+
+    // Rank and keep the top-k matches
+    static const size_t MAX_RESULTS = 50;
+    std::vector<std::pair<std::string, double>> ranked(fileScores.begin(), fileScores.end());
+    size_t topK = std::min(MAX_RESULTS, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + topK, ranked.end(),
+        [](const std::pair<std::string, double>& a, const std::pair<std::string, double>& b) {
+            return a.second > b.second;
+        });
+
+    for (size_t i = 0; i < topK; ++i) {
+        results.push_back(fs::path(ranked[i].first));
+    }
+
     return RAGGER_SUCCESS;
 }
 
+namespace {
+
+// Test tagging heuristics, applied once at index time so discovery is a
+// flag lookup. Substring checks cover the common gtest and catch2 entry
+// macros; TYPED_TEST/TEST_F/TEST_P all contain "TEST".
+bool containsTestMacro(const std::string& content) {
+    static const char* macros[] = {
+        "TEST(", "TEST_F(", "TEST_P(", "TYPED_TEST(",
+        "TEST_CASE(", "SCENARIO(", "CATCH_TEST_CASE("
+    };
+    for (const char* macro : macros) {
+        if (content.find(macro) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool looksLikeTestPath(const fs::path& filePath) {
+    std::string stem = filePath.stem().string();
+    if (stem.rfind("test_", 0) == 0 || stem.rfind("Test", 0) == 0) {
+        return true;
+    }
+    if (stem.size() >= 5 && stem.compare(stem.size() - 5, 5, "_test") == 0) {
+        return true;
+    }
+    if (stem.size() >= 6 && stem.compare(stem.size() - 6, 6, "_tests") == 0) {
+        return true;
+    }
+    for (const auto& component : filePath.parent_path()) {
+        if (component == "test" || component == "tests") {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Copies for results whose strings must outlive the statement; released
+// via IndexManager::freeCodeBlocks / freeSymbols
+const char* duplicateColumnText(sqlite3_stmt* stmt, int column) {
+    const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, column));
+    if (!text) {
+        text = "";
+    }
+    size_t length = strlen(text);
+    char* copy = new char[length + 1];
+    memcpy(copy, text, length + 1);
+    return copy;
+}
+
+// Shared row materialization for code_blocks queries selecting
+// (file_path, name, content, start_line, end_line, block_type, visibility)
+CodeBlock materializeCodeBlockRow(sqlite3_stmt* stmt) {
+    CodeBlock block;
+    block.filePath = duplicateColumnText(stmt, 0);
+    block.name = duplicateColumnText(stmt, 1);
+    block.content = duplicateColumnText(stmt, 2);
+    block.startLine = sqlite3_column_int(stmt, 3);
+    block.endLine = sqlite3_column_int(stmt, 4);
+    block.language = duplicateColumnText(stmt, 5);
+    block.visibility = static_cast<uint32_t>(sqlite3_column_int(stmt, 6));
+    block.metadata = nullptr;
+    return block;
+}
+
+} // anonymous namespace
+
 int IndexManager::findCodeBlocks(const std::string& symbol, std::vector<CodeBlock>& results) {
-    // TODO: Implement symbol search
     results.clear();
-    std::cout << "IndexManager: Finding code blocks for symbol '" << symbol << "'" << std::endl;
+    RAGGER_LOG_DEBUG("IndexManager: Finding code blocks for symbol '" + symbol + "'");
+
+    if (shards_.empty()) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    // The in-memory symbol index answers exact, prefix and fuzzy lookups
+    // without touching SQL; the shards only materialize the matches.
+    // Block ids are per-shard rowids, so each match routes through the
+    // shard that owns its file.
+    static const size_t MAX_SYMBOL_RESULTS = 100;
+    std::vector<SymbolIndex::Match> matches = symbolIndex_.lookup(symbol, MAX_SYMBOL_RESULTS);
+    if (matches.empty()) {
+        return RAGGER_SUCCESS;
+    }
+
+    // One lease per shard that actually holds matches, kept for the whole
+    // materialization pass
+    std::unordered_map<size_t, std::unique_ptr<PoolLease>> leases;
+
+    for (const auto& match : matches) {
+        size_t shardIndex = shardIndexForPath(match.filePath);
+        auto leaseIt = leases.find(shardIndex);
+        if (leaseIt == leases.end()) {
+            leaseIt = leases.emplace(shardIndex,
+                std::make_unique<PoolLease>(this, shards_[shardIndex].get())).first;
+        }
+        DatabaseConnection* conn = leaseIt->second->conn;
+        if (!conn) {
+            continue;
+        }
+
+        sqlite3_stmt* stmt = getPooledStatement(conn,
+            "SELECT file_path, name, content, start_line, end_line, block_type, visibility "
+            "FROM code_blocks WHERE id = ?");
+        if (!stmt) {
+            continue;
+        }
+
+        sqlite3_bind_int64(stmt, 1, match.blockId);
+
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            results.push_back(materializeCodeBlockRow(stmt));
+        }
+        sqlite3_reset(stmt);
+    }
+
+    return RAGGER_SUCCESS;
+}
+
+int IndexManager::findTestBlocks(std::vector<CodeBlock>& results) {
+    results.clear();
+    if (shards_.empty()) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    for (auto& shard : shards_) {
+        PoolLease lease(this, shard.get());
+        if (!lease.conn) {
+            continue;
+        }
+
+        sqlite3_stmt* stmt = getPooledStatement(lease.conn,
+            "SELECT file_path, name, content, start_line, end_line, block_type, visibility "
+            "FROM code_blocks WHERE is_test = 1");
+        if (!stmt) {
+            continue;
+        }
+
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            results.push_back(materializeCodeBlockRow(stmt));
+        }
+        sqlite3_reset(stmt);
+    }
+
+    return RAGGER_SUCCESS;
+}
+
+int IndexManager::findTestBlocksForFile(const fs::path& filePath, std::vector<CodeBlock>& results) {
+    results.clear();
+    if (shards_.empty()) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    PoolLease lease(this, &shardForPath(filePath));
+    if (!lease.conn) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    sqlite3_stmt* stmt = getPooledStatement(lease.conn,
+        "SELECT file_path, name, content, start_line, end_line, block_type, visibility "
+        "FROM code_blocks WHERE is_test = 1 AND file_path = ?");
+    if (!stmt) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    sqlite3_bind_text(stmt, 1, filePath.string().c_str(), -1, SQLITE_TRANSIENT);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        results.push_back(materializeCodeBlockRow(stmt));
+    }
+    sqlite3_reset(stmt);
+
     return RAGGER_SUCCESS;
 }
 
 int IndexManager::getFileSymbols(const fs::path& filePath, std::vector<CodeSymbol>& symbols) {
-    // TODO: Implement symbol extraction for file
     symbols.clear();
-    std::cout << "IndexManager: Getting symbols for file " << filePath.string() << std::endl;
+    RAGGER_LOG_DEBUG("IndexManager: Getting symbols for file " + filePath.string());
+
+    if (shards_.empty()) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    PoolLease lease(this, &shardForPath(filePath));
+    if (!lease.conn) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    sqlite3_stmt* stmt = getPooledStatement(lease.conn,
+        "SELECT name, type, signature FROM symbols WHERE file_path = ?");
+    if (!stmt) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    sqlite3_bind_text(stmt, 1, filePath.string().c_str(), -1, SQLITE_TRANSIENT);
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        CodeSymbol symbol;
+        symbol.name = duplicateColumnText(stmt, 0);
+        symbol.type = duplicateColumnText(stmt, 1);
+        symbol.signature = duplicateColumnText(stmt, 2);
+        symbol.definition = nullptr;
+        symbols.push_back(symbol);
+    }
+    sqlite3_reset(stmt);
+
+    return RAGGER_SUCCESS;
+}
+
+void IndexManager::freeCodeBlocks(std::vector<CodeBlock>& blocks) {
+    for (auto& block : blocks) {
+        delete[] block.filePath;
+        delete[] block.name;
+        delete[] block.content;
+        delete[] block.language;
+    }
+    blocks.clear();
+}
+
+void IndexManager::freeSymbols(std::vector<CodeSymbol>& symbols) {
+    for (auto& symbol : symbols) {
+        delete[] symbol.name;
+        delete[] symbol.type;
+        delete[] symbol.signature;
+    }
+    symbols.clear();
+}
+
+int IndexManager::beginBatch() {
+    int result = RAGGER_SUCCESS;
+    for (auto& shard : shards_) {
+        if (executeQuery(*shard, "BEGIN IMMEDIATE") != RAGGER_SUCCESS) {
+            result = RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+        }
+    }
+    return result;
+}
+
+int IndexManager::commitBatch() {
+    int result = RAGGER_SUCCESS;
+    for (auto& shard : shards_) {
+        if (executeQuery(*shard, "COMMIT") != RAGGER_SUCCESS) {
+            result = RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+        }
+    }
+    return result;
+}
+
+// Clear one shard while the others keep serving. With path-hash
+// partitioning a shard holds roughly 1/N of every subtree, so a partial
+// rebuild touches 1/N of the data instead of locking the whole index.
+int IndexManager::rebuildShard(size_t shardIndex) {
+    if (shardIndex >= shards_.size()) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+    Shard& shard = *shards_[shardIndex];
+
+    // Collect the shard's files first so the per-file bookkeeping
+    // (hashes, symbols, generations) can be dropped precisely
+    std::vector<std::string> shardFiles;
+    sqlite3_stmt* stmt = getCachedStatement(shard, "SELECT path FROM files");
+    if (stmt) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            const char* path = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+            if (path) {
+                shardFiles.push_back(path);
+            }
+        }
+        sqlite3_reset(stmt);
+    }
+
+    executeQuery(shard, "DELETE FROM files");
+    executeQuery(shard, "DELETE FROM code_blocks");
+    executeQuery(shard, "DELETE FROM inverted_index");
+
+    {
+        std::lock_guard<std::mutex> lock(hashMutex_);
+        for (const std::string& path : shardFiles) {
+            fileHashes_.erase(path);
+            hashCache_.erase(path);
+        }
+    }
+    for (const std::string& path : shardFiles) {
+        symbolIndex_.removeFile(path);
+        noteFileMutation(path);
+    }
+
+    std::cout << "IndexManager: Rebuilt shard " << shardIndex << " ("
+              << shardFiles.size() << " files dropped)" << std::endl;
     return RAGGER_SUCCESS;
 }
 
 int IndexManager::rebuildIndex() {
-    // Clear existing index
-    executeQuery("DELETE FROM files");
-    executeQuery("DELETE FROM code_blocks");
-    executeQuery("DELETE FROM inverted_index");
-
-    fileHashes_.clear();
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        int result = rebuildShard(i);
+        if (result != RAGGER_SUCCESS) {
+            return result;
+        }
+    }
 
     // TODO: Reindex all known directories
     std::cout << "IndexManager: Index rebuild completed" << std::endl;
@@ -155,34 +872,102 @@ int IndexManager::rebuildIndex() {
 }
 
 int IndexManager::optimizeIndex() {
-    // SQLite optimization
-    executeQuery("VACUUM");
-    executeQuery("ANALYZE");
+    // SQLite optimization, shard by shard
+    executeQueryAll("VACUUM");
+    executeQueryAll("ANALYZE");
 
     std::cout << "IndexManager: Index optimization completed" << std::endl;
     return RAGGER_SUCCESS;
 }
 
 int IndexManager::getIndexStats(size_t& fileCount, size_t& blockCount, size_t& symbolCount) {
-    // TODO: Query database for actual counts
-    fileCount = fileHashes_.size();
-    blockCount = 0; // Placeholder
-    symbolCount = 0; // Placeholder
+    fileCount = 0;
+    blockCount = 0;
+    symbolCount = 0;
+
+    for (auto& shard : shards_) {
+        PoolLease lease(this, shard.get());
+        if (!lease.conn) {
+            return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+        }
+
+        auto countRows = [&](const char* sql, size_t& out) {
+            sqlite3_stmt* stmt = getPooledStatement(lease.conn, sql);
+            if (stmt && sqlite3_step(stmt) == SQLITE_ROW) {
+                out += static_cast<size_t>(sqlite3_column_int64(stmt, 0));
+            }
+            if (stmt) {
+                sqlite3_reset(stmt);
+            }
+        };
+
+        countRows("SELECT COUNT(*) FROM files", fileCount);
+        countRows("SELECT COUNT(*) FROM code_blocks", blockCount);
+        countRows("SELECT COUNT(*) FROM symbols", symbolCount);
+    }
     return RAGGER_SUCCESS;
 }
 
 bool IndexManager::needsReindexing(const fs::path& filePath) {
-    std::string currentHash = calculateFileHash(filePath);
-    if (currentHash.empty()) {
+    // Fast path: compare the stored (mtime, size) pair before touching
+    // file contents, so a no-op reindex is metadata-stat bound
+    std::error_code ec;
+    auto currentSize = fs::file_size(filePath, ec);
+    if (ec) {
         return true; // File error, reindex
     }
+    int64_t currentMtime = fileMtimeSeconds(filePath);
 
-    auto it = fileHashes_.find(filePath.string());
-    if (it == fileHashes_.end()) {
+    Shard& shard = shardForPath(filePath);
+    sqlite3_stmt* stmt = getCachedStatement(shard,
+        "SELECT mtime, file_size, hash FROM files WHERE path = ?");
+    if (!stmt) {
+        return true;
+    }
+
+    sqlite3_bind_text(stmt, 1, filePath.string().c_str(), -1, SQLITE_TRANSIENT);
+
+    bool haveRecord = false;
+    int64_t storedMtime = 0;
+    int64_t storedSize = -1;
+    std::string storedHash;
+
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        haveRecord = true;
+        storedMtime = sqlite3_column_int64(stmt, 0);
+        storedSize = sqlite3_column_int64(stmt, 1);
+        const char* hashText = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+        if (hashText) {
+            storedHash = hashText;
+        }
+    }
+    sqlite3_reset(stmt);
+
+    if (!haveRecord) {
         return true; // Not indexed yet
     }
 
-    return it->second != currentHash;
+    if (storedMtime == currentMtime && storedSize == static_cast<int64_t>(currentSize)) {
+        return false; // Metadata unchanged, skip without rehashing
+    }
+
+    // Metadata mismatch (e.g. touch without edit): only now pay for a hash
+    std::string currentHash = calculateFileHash(filePath);
+    if (currentHash.empty()) {
+        return true;
+    }
+
+    return currentHash != storedHash;
+}
+
+int64_t IndexManager::fileMtimeSeconds(const fs::path& filePath) {
+    std::error_code ec;
+    auto mtime = fs::last_write_time(filePath, ec);
+    if (ec) {
+        return 0;
+    }
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        mtime.time_since_epoch()).count();
 }
 
 int IndexManager::updateFileIndex(const fs::path& filePath) {
@@ -201,13 +986,26 @@ void IndexManager::setDatabasePath(const fs::path& dbPath) {
     dbPath_ = dbPath;
 }
 
-int IndexManager::createTables() {
+void IndexManager::setFastHashing(bool enabled) {
+    fastHashing_ = enabled;
+}
+
+void IndexManager::setShardCount(size_t count) {
+    if (!shards_.empty()) {
+        std::cerr << "IndexManager: Shard count cannot change after initialize" << std::endl;
+        return;
+    }
+    numShards_ = std::max<size_t>(1, count);
+}
+
+int IndexManager::createTables(Shard& shard) {
     const char* createFilesTable = R"(
         CREATE TABLE IF NOT EXISTS files (
             path TEXT PRIMARY KEY,
             hash TEXT NOT NULL,
             last_indexed INTEGER NOT NULL,
             file_size INTEGER,
+            mtime INTEGER,
             language TEXT
         )
     )";
@@ -222,6 +1020,7 @@ int IndexManager::createTables() {
             end_line INTEGER,
             block_type TEXT,
             visibility INTEGER DEFAULT 2,
+            is_test INTEGER DEFAULT 0,
             FOREIGN KEY(file_path) REFERENCES files(path)
         )
     )";
@@ -250,31 +1049,45 @@ int IndexManager::createTables() {
     )";
 
     int result;
-    result = executeQuery(createFilesTable);
+    result = executeQuery(shard, createFilesTable);
     if (result != RAGGER_SUCCESS) return result;
 
-    result = executeQuery(createCodeBlocksTable);
+    result = executeQuery(shard, createCodeBlocksTable);
     if (result != RAGGER_SUCCESS) return result;
 
-    result = executeQuery(createInvertedIndexTable);
+    result = executeQuery(shard, createInvertedIndexTable);
     if (result != RAGGER_SUCCESS) return result;
 
-    result = executeQuery(createSymbolsTable);
+    result = executeQuery(shard, createSymbolsTable);
     if (result != RAGGER_SUCCESS) return result;
 
+    // Name and file-path indexes back the SQL side of symbol lookup and
+    // the per-file delete cascade
+    executeQuery(shard, "CREATE INDEX IF NOT EXISTS idx_code_blocks_name ON code_blocks(name)");
+    executeQuery(shard, "CREATE INDEX IF NOT EXISTS idx_code_blocks_file ON code_blocks(file_path)");
+    executeQuery(shard, "CREATE INDEX IF NOT EXISTS idx_symbols_name ON symbols(name)");
+    executeQuery(shard, "CREATE INDEX IF NOT EXISTS idx_symbols_file ON symbols(file_path)");
+
+    // Migrations for databases created before these columns existed;
+    // the errors on already-migrated databases are expected and ignored
+    sqlite3_exec(shard.db, "ALTER TABLE files ADD COLUMN mtime INTEGER", nullptr, nullptr, nullptr);
+    sqlite3_exec(shard.db, "ALTER TABLE code_blocks ADD COLUMN is_test INTEGER DEFAULT 0",
+                 nullptr, nullptr, nullptr);
+
+    // Test discovery is an indexed flag lookup, O(matches) not O(tree)
+    executeQuery(shard, "CREATE INDEX IF NOT EXISTS idx_code_blocks_is_test ON code_blocks(is_test)");
+
     return RAGGER_SUCCESS;
 }
 
 int IndexManager::insertFileRecord(const fs::path& filePath, const std::string& hash) {
-    std::stringstream query;
-    query << "INSERT OR REPLACE INTO files (path, hash, last_indexed, file_size) VALUES (?, ?, ?, ?)";
-
-    sqlite3_stmt* stmt;
-    int result = sqlite3_prepare_v2(db_, query.str().c_str(), -1, &stmt, nullptr);
-    if (result != SQLITE_OK) {
-        std::cerr << "IndexManager: Failed to prepare insert statement: " << sqlite3_errmsg(db_) << std::endl;
+    Shard& shard = shardForPath(filePath);
+    sqlite3_stmt* stmt = getCachedStatement(shard,
+        "INSERT OR REPLACE INTO files (path, hash, last_indexed, file_size, mtime) VALUES (?, ?, ?, ?, ?)");
+    if (!stmt) {
         return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
     }
+    int result;
 
     // Get file size
     size_t fileSize = fs::file_size(filePath);
@@ -284,12 +1097,13 @@ int IndexManager::insertFileRecord(const fs::path& filePath, const std::string&
     sqlite3_bind_int64(stmt, 3, std::chrono::duration_cast<std::chrono::seconds>(
         std::chrono::system_clock::now().time_since_epoch()).count());
     sqlite3_bind_int64(stmt, 4, fileSize);
+    sqlite3_bind_int64(stmt, 5, fileMtimeSeconds(filePath));
 
     result = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
+    sqlite3_reset(stmt);
 
     if (result != SQLITE_DONE) {
-        std::cerr << "IndexManager: Failed to insert file record: " << sqlite3_errmsg(db_) << std::endl;
+        std::cerr << "IndexManager: Failed to insert file record: " << sqlite3_errmsg(shard.db) << std::endl;
         return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
     }
 
@@ -297,20 +1111,172 @@ int IndexManager::insertFileRecord(const fs::path& filePath, const std::string&
 }
 
 int IndexManager::insertCodeBlock(const CodeBlock* block, const fs::path& filePath) {
-    // TODO: Implement code block insertion
-    (void)block;    // Suppress unused parameter warning
-    (void)filePath; // Suppress unused parameter warning
+    if (!block) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+
+    Shard& shard = shardForPath(filePath);
+    sqlite3_stmt* stmt = getCachedStatement(shard,
+        "INSERT INTO code_blocks (file_path, name, content, start_line, end_line, block_type, visibility, is_test) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?)");
+    if (!stmt) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+    int result;
+
+    bool isTest = looksLikeTestPath(filePath) ||
+                  (block->content && containsTestMacro(block->content));
+
+    sqlite3_bind_text(stmt, 1, filePath.string().c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 2, block->name ? block->name : "", -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 3, block->content ? block->content : "", -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt, 4, block->startLine);
+    sqlite3_bind_int(stmt, 5, block->endLine);
+    sqlite3_bind_text(stmt, 6, block->language ? block->language : "", -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt, 7, static_cast<int>(block->visibility));
+    sqlite3_bind_int(stmt, 8, isTest ? 1 : 0);
+
+    result = sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+
+    if (result != SQLITE_DONE) {
+        std::cerr << "IndexManager: Failed to insert code block: " << sqlite3_errmsg(shard.db) << std::endl;
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    if (block->name && block->name[0] != '\0') {
+        symbolIndex_.add(sqlite3_last_insert_rowid(shard.db), block->name, filePath.string());
+    }
+
+    return RAGGER_SUCCESS;
+}
+
+std::unordered_map<std::string, int> IndexManager::tokenizeContent(const std::string& content) {
+    // Shared tokenizer keeps index-time and query-time terms consistent
+    return Tokenizer::countTokens(content);
+}
+
+int IndexManager::indexFileContent(const fs::path& filePath) {
+    RAGGER_TRACE_SPAN("parse");
+
+    FileView fileView;
+    int result = fileView.map(filePath);
+    if (result != RAGGER_SUCCESS) {
+        return result;
+    }
+
+    std::string content(fileView.data(), fileView.size());
+    return indexFileContent(filePath, content, Tokenizer::countTokens(fileView.view()));
+}
+
+int IndexManager::indexFileContent(const fs::path& filePath, const std::string& content,
+                                   const std::unordered_map<std::string, int>& tokenFreqs) {
+    // Until parser plugins feed real blocks, the whole file is one block;
+    // the postings still give us ranked full-text search per file.
+    int lineCount = static_cast<int>(std::count(content.begin(), content.end(), '\n')) + 1;
+
+    bool isTest = looksLikeTestPath(filePath) || containsTestMacro(content);
+
+    Shard& shard = shardForPath(filePath);
+    sqlite3_stmt* stmt = getCachedStatement(shard,
+        "INSERT INTO code_blocks (file_path, name, content, start_line, end_line, block_type, is_test) "
+        "VALUES (?, ?, ?, 1, ?, 'file', ?)");
+    if (!stmt) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+    int result;
+
+    sqlite3_bind_text(stmt, 1, filePath.string().c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 2, filePath.filename().string().c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 3, content.c_str(), static_cast<int>(content.size()), SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt, 4, lineCount);
+    sqlite3_bind_int(stmt, 5, isTest ? 1 : 0);
+
+    result = sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+
+    if (result != SQLITE_DONE) {
+        std::cerr << "IndexManager: Failed to insert file content: " << sqlite3_errmsg(shard.db) << std::endl;
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    sqlite3_int64 blockId = sqlite3_last_insert_rowid(shard.db);
+    symbolIndex_.add(blockId, filePath.filename().string(), filePath.string());
+    noteFileMutation(filePath);
+
+    result = insertTokenPostings(shard, blockId, tokenFreqs);
+    if (result == RAGGER_SUCCESS) {
+        emitBlockIndexed(shardIndexForPath(filePath), blockId, content);
+    }
+    return result;
+}
+
+void IndexManager::setEventBus(EventBus* eventBus) {
+    eventBus_ = eventBus;
+}
+
+void IndexManager::emitBlockIndexed(size_t shardIndex, sqlite3_int64 blockId,
+                                    const std::string& content) {
+    if (!eventBus_) {
+        return;
+    }
+
+    // Rankers address blocks across shards by the qualified id; a bare
+    // rowid would be ambiguous between shards
+    int64_t globalId = (static_cast<int64_t>(shardIndex) << 48) | blockId;
+    std::string docId = std::to_string(globalId);
+
+    auto payload = EventBus::SharedPayload::allocate(docId.size() + 1 + content.size());
+    if (!payload) {
+        return;
+    }
+    char* out = static_cast<char*>(payload->data());
+    std::memcpy(out, docId.data(), docId.size());
+    out[docId.size()] = '\n';
+    std::memcpy(out + docId.size() + 1, content.data(), content.size());
+
+    EventData event{};
+    event.type = EVENT_CODEBLOCK_INDEXED;
+    event.sourcePlugin = "IndexManager";
+    event.data = nullptr; // Whole shared buffer is the payload
+    event.dataSize = payload->size();
+    eventBus_->emitEventShared(&event, std::move(payload));
+}
+
+int IndexManager::insertTokenPostings(Shard& shard, sqlite3_int64 blockId,
+                                      const std::unordered_map<std::string, int>& tokenFreqs) {
+    sqlite3_stmt* stmt = getCachedStatement(shard,
+        "INSERT OR REPLACE INTO inverted_index (token, block_id, frequency) VALUES (?, ?, ?)");
+    if (!stmt) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+    int result;
+
+    for (const auto& tokenPair : tokenFreqs) {
+        sqlite3_bind_text(stmt, 1, tokenPair.first.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(stmt, 2, blockId);
+        sqlite3_bind_int(stmt, 3, tokenPair.second);
+
+        result = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+
+        if (result != SQLITE_DONE) {
+            std::cerr << "IndexManager: Failed to insert posting: " << sqlite3_errmsg(shard.db) << std::endl;
+            return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+        }
+    }
+
     return RAGGER_SUCCESS;
 }
 
 int IndexManager::updateFileHash(const fs::path& filePath, const std::string& hash) {
-    std::stringstream query;
-    query << "UPDATE files SET hash = ?, last_indexed = ? WHERE path = ?";
+    Shard& shard = shardForPath(filePath);
 
     sqlite3_stmt* stmt;
-    int result = sqlite3_prepare_v2(db_, query.str().c_str(), -1, &stmt, nullptr);
+    int result = sqlite3_prepare_v2(shard.db, "UPDATE files SET hash = ?, last_indexed = ? WHERE path = ?",
+                                    -1, &stmt, nullptr);
     if (result != SQLITE_OK) {
-        std::cerr << "IndexManager: Failed to prepare update statement: " << sqlite3_errmsg(db_) << std::endl;
+        std::cerr << "IndexManager: Failed to prepare update statement: " << sqlite3_errmsg(shard.db) << std::endl;
         return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
     }
 
@@ -326,6 +1292,8 @@ int IndexManager::updateFileHash(const fs::path& filePath, const std::string& ha
 }
 
 int IndexManager::deleteFileRecords(const fs::path& filePath) {
+    Shard& shard = shardForPath(filePath);
+
     // Delete from all tables
     std::vector<std::string> queries = {
         "DELETE FROM inverted_index WHERE block_id IN (SELECT id FROM code_blocks WHERE file_path = ?)",
@@ -336,9 +1304,9 @@ int IndexManager::deleteFileRecords(const fs::path& filePath) {
 
     for (const auto& queryStr : queries) {
         sqlite3_stmt* stmt;
-        int result = sqlite3_prepare_v2(db_, queryStr.c_str(), -1, &stmt, nullptr);
+        int result = sqlite3_prepare_v2(shard.db, queryStr.c_str(), -1, &stmt, nullptr);
         if (result != SQLITE_OK) {
-            std::cerr << "IndexManager: Failed to prepare delete statement: " << sqlite3_errmsg(db_) << std::endl;
+            std::cerr << "IndexManager: Failed to prepare delete statement: " << sqlite3_errmsg(shard.db) << std::endl;
             return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
         }
 
@@ -348,37 +1316,77 @@ int IndexManager::deleteFileRecords(const fs::path& filePath) {
         sqlite3_finalize(stmt);
 
         if (result != SQLITE_DONE) {
-            std::cerr << "IndexManager: Failed to delete records: " << sqlite3_errmsg(db_) << std::endl;
+            std::cerr << "IndexManager: Failed to delete records: " << sqlite3_errmsg(shard.db) << std::endl;
             return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
         }
     }
 
+    symbolIndex_.removeFile(filePath.string());
+    noteFileMutation(filePath);
+
     return RAGGER_SUCCESS;
 }
 
+uint64_t IndexManager::getIndexGeneration() const {
+    return indexGeneration_.load(std::memory_order_acquire);
+}
+
+uint64_t IndexManager::getFileGeneration(const std::string& filePath) const {
+    std::lock_guard<std::mutex> lock(generationMutex_);
+    auto it = fileGenerations_.find(filePath);
+    return it != fileGenerations_.end() ? it->second : 0;
+}
+
+void IndexManager::noteFileMutation(const fs::path& filePath) {
+    uint64_t generation = indexGeneration_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    std::lock_guard<std::mutex> lock(generationMutex_);
+    fileGenerations_[filePath.string()] = generation;
+}
+
 std::string IndexManager::calculateFileHash(const fs::path& filePath) {
+    FileView fileView;
+    if (fileView.map(filePath) != RAGGER_SUCCESS) {
+        return "";
+    }
+    return calculateFileHash(filePath, fileView.view());
+}
+
+// Hash already-available content (typically a FileView span) so callers
+// that mapped the file for reading don't trigger a second read
+std::string IndexManager::calculateFileHash(const fs::path& filePath, std::string_view content) {
+    RAGGER_TRACE_SPAN("hash");
     try {
         std::string pathStr = filePath.string();
-        
-        // Check if we have a cached hash and the file hasn't been modified
-        auto hashIt = fileHashes_.find(pathStr);
-        auto timeIt = hashCache_.find(pathStr);
-        
-        if (hashIt != fileHashes_.end() && timeIt != hashCache_.end()) {
-            // Check if file modification time has changed (simplified check)
-            auto fileTime = fs::last_write_time(filePath);
-            (void)fileTime; // Suppress unused variable warning
-            auto currentTime = std::chrono::steady_clock::now();
-            
-            // If cache is less than 5 minutes old, use cached hash
-            if ((currentTime - timeIt->second) < std::chrono::minutes(5)) {
+        int64_t currentMtime = fileMtimeSeconds(filePath);
+
+        // Reuse the cached hash only while the file's mtime is unchanged
+        {
+            std::lock_guard<std::mutex> lock(hashMutex_);
+            auto hashIt = fileHashes_.find(pathStr);
+            auto timeIt = hashCache_.find(pathStr);
+
+            if (hashIt != fileHashes_.end() && timeIt != hashCache_.end() &&
+                timeIt->second == currentMtime) {
                 return hashIt->second; // Return cached hash
             }
         }
-        
-        std::ifstream file(filePath, std::ios::binary);
-        if (!file) {
-            return "";
+
+        // Change detection only needs to tell a file apart from its own
+        // previous contents; xxHash64 does that at memory bandwidth. The
+        // prefix keeps the format distinct from SHA256 hex, so switching
+        // modes just triggers one reindex.
+        if (fastHashing_) {
+            char formatted[32];
+            snprintf(formatted, sizeof(formatted), "xx64:%016llx",
+                     static_cast<unsigned long long>(
+                         FastHash::hash64(content.data(), content.size())));
+            std::string hashStr(formatted);
+
+            std::lock_guard<std::mutex> lock(hashMutex_);
+            fileHashes_[pathStr] = hashStr;
+            hashCache_[pathStr] = currentMtime;
+            ++hashesSinceSnapshot_;
+            return hashStr;
         }
 
         // Use modern EVP interface for SHA256
@@ -388,19 +1396,8 @@ std::string IndexManager::calculateFileHash(const fs::path& filePath) {
         }
 
         const EVP_MD* md = EVP_sha256();
-        if (!EVP_DigestInit_ex(mdctx, md, nullptr)) {
-            EVP_MD_CTX_free(mdctx);
-            return "";
-        }
-
-        char buffer[8192];
-        while (file.read(buffer, sizeof(buffer))) {
-            if (!EVP_DigestUpdate(mdctx, buffer, file.gcount())) {
-                EVP_MD_CTX_free(mdctx);
-                return "";
-            }
-        }
-        if (!EVP_DigestUpdate(mdctx, buffer, file.gcount())) {
+        if (!EVP_DigestInit_ex(mdctx, md, nullptr) ||
+            !EVP_DigestUpdate(mdctx, content.data(), content.size())) {
             EVP_MD_CTX_free(mdctx);
             return "";
         }
@@ -419,10 +1416,14 @@ std::string IndexManager::calculateFileHash(const fs::path& filePath) {
         }
 
         std::string hashStr = ss.str();
-        
-        // Cache the hash and timestamp
-        fileHashes_[pathStr] = hashStr;
-        hashCache_[pathStr] = std::chrono::steady_clock::now();
+
+        // Cache the hash together with the mtime it was computed at
+        {
+            std::lock_guard<std::mutex> lock(hashMutex_);
+            fileHashes_[pathStr] = hashStr;
+            hashCache_[pathStr] = currentMtime;
+            ++hashesSinceSnapshot_;
+        }
 
         return hashStr;
 
@@ -459,24 +1460,43 @@ bool IndexManager::shouldIndexFile(const fs::path& filePath) {
 }
 
 std::vector<fs::path> IndexManager::discoverFiles(const fs::path& directory) {
-    std::vector<fs::path> files;
+    // Parallel, gitignore-aware traversal; ignored subtrees (build
+    // output, vendored deps) are pruned before descending
+    return FileDiscovery::discover(directory, [this](const fs::path& path) {
+        return shouldIndexFile(path);
+    });
+}
 
-    try {
-        for (const auto& entry : fs::recursive_directory_iterator(directory)) {
-            if (fs::is_regular_file(entry) && shouldIndexFile(entry.path())) {
-                files.push_back(entry.path());
-            }
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "IndexManager: Error discovering files in " << directory.string() << ": " << e.what() << std::endl;
+sqlite3_stmt* IndexManager::getCachedStatement(Shard& shard, const std::string& sql) {
+    auto it = shard.stmtCache.find(sql);
+    if (it != shard.stmtCache.end()) {
+        sqlite3_reset(it->second);
+        sqlite3_clear_bindings(it->second);
+        return it->second;
     }
 
-    return files;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(shard.db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "IndexManager: Failed to prepare statement: " << sqlite3_errmsg(shard.db) << std::endl;
+        return nullptr;
+    }
+
+    shard.stmtCache[sql] = stmt;
+    return stmt;
 }
 
-int IndexManager::executeQuery(const std::string& query) {
+void IndexManager::clearStatementCaches() {
+    for (auto& shard : shards_) {
+        for (auto& pair : shard->stmtCache) {
+            sqlite3_finalize(pair.second);
+        }
+        shard->stmtCache.clear();
+    }
+}
+
+int IndexManager::executeQuery(Shard& shard, const std::string& query) {
     char* errorMsg = nullptr;
-    int result = sqlite3_exec(db_, query.c_str(), nullptr, nullptr, &errorMsg);
+    int result = sqlite3_exec(shard.db, query.c_str(), nullptr, nullptr, &errorMsg);
 
     if (result != SQLITE_OK) {
         std::cerr << "IndexManager: SQL error: " << errorMsg << std::endl;
@@ -487,70 +1507,115 @@ int IndexManager::executeQuery(const std::string& query) {
     return RAGGER_SUCCESS;
 }
 
-int IndexManager::executeQueryWithCallback(const std::string& query,
-                                          int (*callback)(void*, int, char**, char**),
-                                          void* callbackData) {
-    char* errorMsg = nullptr;
-    int result = sqlite3_exec(db_, query.c_str(), callback, callbackData, &errorMsg);
+int IndexManager::executeQueryAll(const std::string& query) {
+    int result = RAGGER_SUCCESS;
+    for (auto& shard : shards_) {
+        if (executeQuery(*shard, query) != RAGGER_SUCCESS) {
+            result = RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+        }
+    }
+    return result;
+}
 
-    if (result != SQLITE_OK) {
-        std::cerr << "IndexManager: SQL error: " << errorMsg << std::endl;
-        sqlite3_free(errorMsg);
-        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+// Connection pool implementation
+IndexManager::DatabaseConnection* IndexManager::openReadConnection(Shard& shard) {
+    auto conn = std::make_unique<DatabaseConnection>();
+    if (sqlite3_open_v2(shard.path.string().c_str(), &conn->db,
+                        SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+        return nullptr;
     }
 
-    return RAGGER_SUCCESS;
+    // Under WAL a reader never blocks the writer, but give transient lock
+    // contention (e.g. checkpoints) a grace period instead of failing
+    sqlite3_busy_timeout(conn->db, 5000);
+
+    shard.readPool.push_back(std::move(conn));
+    return shard.readPool.back().get();
 }
 
-// Connection pool implementation
-void IndexManager::initializeConnectionPool() {
-    std::lock_guard<std::mutex> lock(poolMutex_);
-    
-    for (size_t i = 0; i < MAX_CONNECTIONS; ++i) {
-        DatabaseConnection conn;
-        if (sqlite3_open(dbPath_.string().c_str(), &conn.db) == SQLITE_OK) {
-            connectionPool_.push_back(conn);
+void IndexManager::initializeConnectionPools() {
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->poolMutex);
+        for (size_t i = 0; i < INITIAL_POOL_CONNECTIONS; ++i) {
+            openReadConnection(*shard);
         }
     }
 }
 
-void IndexManager::cleanupConnectionPool() {
-    std::lock_guard<std::mutex> lock(poolMutex_);
-    
-    for (auto& conn : connectionPool_) {
-        if (conn.db) {
-            sqlite3_close(conn.db);
+void IndexManager::cleanupConnectionPools() {
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->poolMutex);
+
+        for (auto& conn : shard->readPool) {
+            for (auto& pair : conn->stmtCache) {
+                sqlite3_finalize(pair.second);
+            }
+            conn->stmtCache.clear();
+            if (conn->db) {
+                sqlite3_close(conn->db);
+            }
         }
+        shard->readPool.clear();
     }
-    connectionPool_.clear();
 }
 
-sqlite3* IndexManager::getConnection() {
-    std::lock_guard<std::mutex> lock(poolMutex_);
-    
-    // Find available connection
-    for (auto& conn : connectionPool_) {
-        if (!conn.inUse) {
-            conn.inUse = true;
-            conn.lastUsed = std::chrono::steady_clock::now();
-            return conn.db;
+IndexManager::DatabaseConnection* IndexManager::getConnection(Shard& shard) {
+    std::unique_lock<std::mutex> lock(shard.poolMutex);
+
+    for (;;) {
+        // Find available connection
+        for (auto& conn : shard.readPool) {
+            if (!conn->inUse) {
+                conn->inUse = true;
+                conn->lastUsed = std::chrono::steady_clock::now();
+                return conn.get();
+            }
         }
+
+        // All busy: grow the pool up to the cap, then block until a
+        // reader finishes. Never fall back to the writer handle.
+        if (shard.readPool.size() < MAX_POOL_CONNECTIONS) {
+            DatabaseConnection* conn = openReadConnection(shard);
+            if (conn) {
+                conn->inUse = true;
+                conn->lastUsed = std::chrono::steady_clock::now();
+                return conn;
+            }
+        }
+
+        if (shard.readPool.empty()) {
+            return nullptr; // Database never opened; nothing to wait for
+        }
+
+        shard.poolCondition.wait(lock);
     }
-    
-    // If no connection available, return the main db (fallback)
-    return db_;
 }
 
-void IndexManager::returnConnection(sqlite3* db) {
-    std::lock_guard<std::mutex> lock(poolMutex_);
-    
-    for (auto& conn : connectionPool_) {
-        if (conn.db == db) {
-            conn.inUse = false;
-            conn.lastUsed = std::chrono::steady_clock::now();
-            break;
-        }
+void IndexManager::returnConnection(Shard& shard, DatabaseConnection* conn) {
+    {
+        std::lock_guard<std::mutex> lock(shard.poolMutex);
+        conn->inUse = false;
+        conn->lastUsed = std::chrono::steady_clock::now();
     }
+    shard.poolCondition.notify_one();
+}
+
+sqlite3_stmt* IndexManager::getPooledStatement(DatabaseConnection* conn, const std::string& sql) {
+    auto it = conn->stmtCache.find(sql);
+    if (it != conn->stmtCache.end()) {
+        sqlite3_reset(it->second);
+        sqlite3_clear_bindings(it->second);
+        return it->second;
+    }
+
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(conn->db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "IndexManager: Failed to prepare statement: " << sqlite3_errmsg(conn->db) << std::endl;
+        return nullptr;
+    }
+
+    conn->stmtCache[sql] = stmt;
+    return stmt;
 }
 
 } // namespace Ragger
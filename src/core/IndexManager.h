@@ -1,11 +1,16 @@
 #pragma once
 
 #include "ragger_plugin_api.h"
+#include "SymbolIndex.h"
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <filesystem>
+#include <memory>
 #include <mutex>
+#include <condition_variable>
 #include <chrono>
 // SQLite support enabled
 #include <sqlite3.h>
@@ -14,6 +19,8 @@ namespace fs = std::filesystem;
 
 namespace Ragger {
 
+class EventBus;
+
 class IndexManager {
 public:
     IndexManager();
@@ -33,64 +40,194 @@ public:
     int findCodeBlocks(const std::string& symbol, std::vector<CodeBlock>& results);
     int getFileSymbols(const fs::path& filePath, std::vector<CodeSymbol>& symbols);
 
+    // Test discovery: blocks are tagged as tests at index time (gtest/
+    // catch2 macros, test_ file naming), so lookup is O(matches) against
+    // the is_test index instead of a tree walk. Results are released
+    // with freeCodeBlocks.
+    int findTestBlocks(std::vector<CodeBlock>& results);
+    int findTestBlocksForFile(const fs::path& filePath, std::vector<CodeBlock>& results);
+
+    // Release strings allocated by findCodeBlocks / getFileSymbols
+    static void freeCodeBlocks(std::vector<CodeBlock>& blocks);
+    static void freeSymbols(std::vector<CodeSymbol>& symbols);
+
+    // Batch indexing: wrap many per-file writes in one transaction per shard
+    int beginBatch();
+    int commitBatch();
+
     // Index maintenance
     int rebuildIndex();
+    int rebuildShard(size_t shardIndex); // Clears one shard without touching the rest
     int optimizeIndex();
     int getIndexStats(size_t& fileCount, size_t& blockCount, size_t& symbolCount);
 
+    // Sharding: files are partitioned across shards by path hash, so
+    // callers can target the shard holding a given file
+    size_t getShardCount() const;
+    size_t shardIndexForPath(const fs::path& filePath) const;
+
     // Incremental indexing
     bool needsReindexing(const fs::path& filePath);
     int updateFileIndex(const fs::path& filePath);
 
+    // Mutation generations for cache invalidation. The global counter
+    // bumps on every index mutation; the per-file generation records the
+    // counter value when that file last changed, so consumers can tell a
+    // stale-but-unaffected cache entry from one whose inputs moved.
+    uint64_t getIndexGeneration() const;
+    uint64_t getFileGeneration(const std::string& filePath) const;
+
     // Configuration
     void setMaxFileSize(size_t maxSize);
     void setDebounceDelay(int milliseconds);
     void setDatabasePath(const fs::path& dbPath);
+    void setFastHashing(bool enabled);
+    void setShardCount(size_t count); // Must be called before initialize()
+
+    // Optional: with a bus attached, every indexed block is announced as
+    // EVENT_CODEBLOCK_INDEXED so rankers can keep their stores in sync
+    void setEventBus(EventBus* eventBus);
 
 private:
-    // Database connection pool
+    // Read connection pool. Query paths check out a read-only connection
+    // so concurrent readers run in parallel instead of serializing on the
+    // shard's writer handle; WAL mode keeps them from blocking the writer.
     struct DatabaseConnection {
         sqlite3* db;
         bool inUse;
         std::chrono::steady_clock::time_point lastUsed;
-        
+        // Statements are per-connection in SQLite, so each pooled
+        // connection carries its own prepared-statement cache
+        std::unordered_map<std::string, sqlite3_stmt*> stmtCache;
+
         DatabaseConnection() : db(nullptr), inUse(false) {}
     };
-    
-    std::vector<DatabaseConnection> connectionPool_;
-    std::mutex poolMutex_;
-    static const size_t MAX_CONNECTIONS = 5;
-    
-    // Connection pool methods
-    sqlite3* getConnection();
-    void returnConnection(sqlite3* db);
-    void initializeConnectionPool();
-    void cleanupConnectionPool();
-    
-    sqlite3* db_; // Main database connection
-    fs::path dbPath_;
+
+    // One index shard: its own database file, writer connection,
+    // writer-side statement cache and read pool. Files are partitioned
+    // across shards by path hash so each shard gets an independent
+    // writer and rebuilds don't lock the whole index.
+    struct Shard {
+        sqlite3* db;
+        fs::path path;
+        std::unordered_map<std::string, sqlite3_stmt*> stmtCache;
+        std::vector<std::unique_ptr<DatabaseConnection>> readPool;
+        std::mutex poolMutex;
+        std::condition_variable poolCondition;
+
+        Shard() : db(nullptr) {}
+    };
+
+    static const size_t DEFAULT_SHARD_COUNT = 4;
+    static const size_t INITIAL_POOL_CONNECTIONS = 2; // Per shard, opened up front
+    static const size_t MAX_POOL_CONNECTIONS = 8;     // Per-shard growth cap
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    size_t numShards_;
+
+    Shard& shardForPath(const fs::path& filePath);
+    fs::path shardDbPath(size_t shardIndex) const;
+
+    // Connection pool methods (per shard)
+    DatabaseConnection* getConnection(Shard& shard);
+    void returnConnection(Shard& shard, DatabaseConnection* conn);
+    DatabaseConnection* openReadConnection(Shard& shard);
+    sqlite3_stmt* getPooledStatement(DatabaseConnection* conn, const std::string& sql);
+    void initializeConnectionPools();
+    void cleanupConnectionPools();
+
+    // Returns the leased connection to its shard's pool on scope exit
+    struct PoolLease {
+        IndexManager* manager;
+        Shard* shard;
+        DatabaseConnection* conn;
+        PoolLease(IndexManager* m, Shard* s)
+            : manager(m), shard(s), conn(m->getConnection(*s)) {}
+        ~PoolLease() { if (conn) manager->returnConnection(*shard, conn); }
+        PoolLease(const PoolLease&) = delete;
+        PoolLease& operator=(const PoolLease&) = delete;
+    };
+
+    fs::path dbPath_; // Base path; shard N lives alongside as <stem>.shardN<ext>
     size_t maxFileSize_;
     int debounceDelay_;
+    bool fastHashing_; // xxHash64 for change detection instead of SHA256
+    std::mutex hashMutex_; // Guards fileHashes_ and hashCache_
     std::unordered_map<std::string, std::string> fileHashes_; // file path -> hash
-    std::unordered_map<std::string, std::chrono::steady_clock::time_point> hashCache_; // file path -> last modified time
+    std::unordered_map<std::string, int64_t> hashCache_; // file path -> mtime (seconds) at hash time
+
+    // Parallel indexing: workers hash/read/tokenize files and hand the
+    // results to a single writer that batches the SQLite inserts
+    struct PendingFile {
+        fs::path path;
+        std::string hash;
+        std::string content;
+        std::unordered_map<std::string, int> tokenFreqs;
+    };
+
+    int writeIndexedFile(const PendingFile& pending);
 
-    // Database operations
-    int createTables();
+    // Database operations (each routes to the owning shard)
+    int createTables(Shard& shard);
     int insertFileRecord(const fs::path& filePath, const std::string& hash);
     int insertCodeBlock(const CodeBlock* block, const fs::path& filePath);
     int updateFileHash(const fs::path& filePath, const std::string& hash);
     int deleteFileRecords(const fs::path& filePath);
 
+    // Snapshot persistence for warm starts. The snapshot serializes the
+    // in-memory hash cache, so hashes computed during change-detection
+    // sweeps survive restarts even when the file itself was never
+    // (re)written to a shard. Saved on shutdown and periodically once
+    // enough fresh hashes have accumulated.
+    static const size_t SNAPSHOT_SAVE_INTERVAL = 256; // Fresh hashes between periodic saves
+    size_t hashesSinceSnapshot_; // Guarded by hashMutex_
+    fs::path snapshotPath() const;
+    int loadSnapshot();
+    int saveSnapshot();
+    void maybeSaveSnapshot();
+
+    // In-memory symbol search (trigram + sorted prefix array) behind
+    // findCodeBlocks; kept in sync by the indexing pipeline
+    SymbolIndex symbolIndex_;
+    int loadSymbolIndex();
+
+    // Mutation tracking for getIndexGeneration/getFileGeneration
+    std::atomic<uint64_t> indexGeneration_;
+    mutable std::mutex generationMutex_;
+    std::unordered_map<std::string, uint64_t> fileGenerations_;
+    void noteFileMutation(const fs::path& filePath);
+
+    // Full-text indexing
+    static std::unordered_map<std::string, int> tokenizeContent(const std::string& content);
+    int indexFileContent(const fs::path& filePath);
+    int indexFileContent(const fs::path& filePath, const std::string& content,
+                         const std::unordered_map<std::string, int>& tokenFreqs);
+    int insertTokenPostings(Shard& shard, sqlite3_int64 blockId,
+                            const std::unordered_map<std::string, int>& tokenFreqs);
+
+    // Announces a freshly indexed block on the event bus. The payload is
+    // "docId\ncontent" with docId the shard-qualified global block id
+    // (shard index << 48 | rowid), shared rather than copied so large
+    // blocks don't hit the copied-payload cap.
+    EventBus* eventBus_ = nullptr;
+    void emitBlockIndexed(size_t shardIndex, sqlite3_int64 blockId,
+                          const std::string& content);
+
     // File processing
     std::string calculateFileHash(const fs::path& filePath);
+    std::string calculateFileHash(const fs::path& filePath, std::string_view content);
+    static int64_t fileMtimeSeconds(const fs::path& filePath);
     bool shouldIndexFile(const fs::path& filePath);
     std::vector<fs::path> discoverFiles(const fs::path& directory);
 
+    // Prepared statements cached per shard writer connection; owned by
+    // the shard's cache and finalized at shutdown
+    sqlite3_stmt* getCachedStatement(Shard& shard, const std::string& sql);
+    void clearStatementCaches();
+
     // SQLite helper functions
-    int executeQuery(const std::string& query);
-    int executeQueryWithCallback(const std::string& query,
-                                int (*callback)(void*, int, char**, char**),
-                                void* callbackData);
+    int executeQuery(Shard& shard, const std::string& query);
+    int executeQueryAll(const std::string& query); // Runs on every shard
 
     // Prevent copying
     IndexManager(const IndexManager&) = delete;
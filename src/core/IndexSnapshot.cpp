@@ -0,0 +1,169 @@
+#include "IndexSnapshot.h"
+#include "ragger_plugin_api.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Ragger {
+
+namespace {
+
+// Per-record fixed prefix: mtime, fileSize, pathLen, hashLen; the two
+// strings follow immediately after.
+struct RecordPrefix {
+    int64_t mtime;
+    int64_t fileSize;
+    uint32_t pathLen;
+    uint32_t hashLen;
+};
+
+} // anonymous namespace
+
+IndexSnapshot::IndexSnapshot()
+    : mapping_(nullptr), mappingSize_(0), recordCount_(0) {
+}
+
+IndexSnapshot::~IndexSnapshot() {
+    close();
+}
+
+int IndexSnapshot::write(const fs::path& snapshotPath, const std::vector<FileRecord>& records) {
+    fs::path tempPath = snapshotPath;
+    tempPath += ".tmp";
+
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "IndexSnapshot: Failed to open " << tempPath.string() << " for writing" << std::endl;
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+
+    Header header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.recordCount = records.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const auto& record : records) {
+        RecordPrefix prefix;
+        prefix.mtime = record.mtime;
+        prefix.fileSize = record.fileSize;
+        prefix.pathLen = static_cast<uint32_t>(record.path.size());
+        prefix.hashLen = static_cast<uint32_t>(record.hash.size());
+
+        out.write(reinterpret_cast<const char*>(&prefix), sizeof(prefix));
+        out.write(record.path.data(), record.path.size());
+        out.write(record.hash.data(), record.hash.size());
+    }
+
+    out.flush();
+    if (!out.good()) {
+        std::cerr << "IndexSnapshot: Failed to write snapshot " << tempPath.string() << std::endl;
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+    out.close();
+
+    // Atomic replace so a crash mid-write never corrupts the snapshot
+    std::error_code ec;
+    fs::rename(tempPath, snapshotPath, ec);
+    if (ec) {
+        std::cerr << "IndexSnapshot: Failed to replace snapshot: " << ec.message() << std::endl;
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    return RAGGER_SUCCESS;
+}
+
+int IndexSnapshot::open(const fs::path& snapshotPath) {
+    close();
+
+    int fd = ::open(snapshotPath.string().c_str(), O_RDONLY);
+    if (fd < 0) {
+        return RAGGER_ERROR_FILE_NOT_FOUND;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        ::close(fd);
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    void* mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file alive
+    if (mapping == MAP_FAILED) {
+        std::cerr << "IndexSnapshot: mmap failed for " << snapshotPath.string() << std::endl;
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    const Header* header = reinterpret_cast<const Header*>(mapping);
+    if (header->magic != MAGIC || header->version != VERSION) {
+        munmap(mapping, st.st_size);
+        std::cerr << "IndexSnapshot: Ignoring snapshot with unknown format" << std::endl;
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    mapping_ = static_cast<const char*>(mapping);
+    mappingSize_ = st.st_size;
+    recordCount_ = header->recordCount;
+    return RAGGER_SUCCESS;
+}
+
+void IndexSnapshot::close() {
+    if (mapping_) {
+        munmap(const_cast<char*>(mapping_), mappingSize_);
+        mapping_ = nullptr;
+        mappingSize_ = 0;
+        recordCount_ = 0;
+    }
+}
+
+bool IndexSnapshot::isOpen() const {
+    return mapping_ != nullptr;
+}
+
+size_t IndexSnapshot::recordCount() const {
+    return recordCount_;
+}
+
+int IndexSnapshot::readAll(std::vector<FileRecord>& records) const {
+    records.clear();
+    if (!mapping_) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    records.reserve(recordCount_);
+    size_t offset = sizeof(Header);
+
+    for (size_t i = 0; i < recordCount_; ++i) {
+        if (offset + sizeof(RecordPrefix) > mappingSize_) {
+            std::cerr << "IndexSnapshot: Truncated snapshot at record " << i << std::endl;
+            return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+        }
+
+        RecordPrefix prefix;
+        std::memcpy(&prefix, mapping_ + offset, sizeof(prefix));
+        offset += sizeof(prefix);
+
+        if (offset + prefix.pathLen + prefix.hashLen > mappingSize_) {
+            std::cerr << "IndexSnapshot: Truncated snapshot at record " << i << std::endl;
+            return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+        }
+
+        FileRecord record;
+        record.mtime = prefix.mtime;
+        record.fileSize = prefix.fileSize;
+        record.path.assign(mapping_ + offset, prefix.pathLen);
+        offset += prefix.pathLen;
+        record.hash.assign(mapping_ + offset, prefix.hashLen);
+        offset += prefix.hashLen;
+
+        records.push_back(std::move(record));
+    }
+
+    return RAGGER_SUCCESS;
+}
+
+} // namespace Ragger
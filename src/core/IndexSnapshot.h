@@ -0,0 +1,63 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace Ragger {
+
+// Compact binary snapshot of the file index, written on shutdown and
+// memory-mapped read-only on startup so a warm process doesn't wait on
+// SQLite page cache warmup before it can answer change-detection queries.
+//
+// Layout: a fixed-width header followed by one record per file. Each
+// record stores the numeric fields at fixed offsets with the two strings
+// (path, hash) appended, so records can be walked without parsing.
+class IndexSnapshot {
+public:
+    struct FileRecord {
+        std::string path;
+        std::string hash;
+        int64_t mtime;
+        int64_t fileSize;
+    };
+
+    IndexSnapshot();
+    ~IndexSnapshot();
+
+    // Serialize records to a snapshot file (atomic rename over the old one)
+    static int write(const fs::path& snapshotPath, const std::vector<FileRecord>& records);
+
+    // Map an existing snapshot read-only
+    int open(const fs::path& snapshotPath);
+    void close();
+    bool isOpen() const;
+
+    size_t recordCount() const;
+
+    // Decode every mapped record; returns RAGGER_SUCCESS or an error code
+    int readAll(std::vector<FileRecord>& records) const;
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t recordCount;
+    };
+
+    static const uint32_t MAGIC = 0x52475348; // "RGSH"
+    static const uint32_t VERSION = 1;
+
+    const char* mapping_;
+    size_t mappingSize_;
+    size_t recordCount_;
+
+    // Prevent copying
+    IndexSnapshot(const IndexSnapshot&) = delete;
+    IndexSnapshot& operator=(const IndexSnapshot&) = delete;
+};
+
+} // namespace Ragger
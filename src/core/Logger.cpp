@@ -1,13 +1,101 @@
 #include "Logger.h"
-#include <fstream>
 
 namespace Ragger {
 
-Logger::Logger() : currentLevel_(Level::Info) {
+Logger::MessageRing::MessageRing()
+    : enqueuePos_(0), dequeuePos_(0) {
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+        slots_[i].item = nullptr;
+    }
+}
+
+Logger::MessageRing::~MessageRing() {
+    // Drain anything left behind so queued messages don't leak
+    while (auto message = tryPop()) {
+        // unique_ptr releases the message
+    }
+}
+
+bool Logger::MessageRing::tryPush(std::unique_ptr<std::string> message) {
+    uint64_t pos = enqueuePos_.load(std::memory_order_relaxed);
+
+    for (;;) {
+        Slot& slot = slots_[pos & (CAPACITY - 1)];
+        uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+        if (diff == 0) {
+            // Slot is free; try to claim it
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.item = message.release();
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+            // CAS failed, pos was refreshed; retry
+        } else if (diff < 0) {
+            return false; // Ring is full
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+std::unique_ptr<std::string> Logger::MessageRing::tryPop() {
+    uint64_t pos = dequeuePos_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[pos & (CAPACITY - 1)];
+    uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+    intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+    if (diff < 0) {
+        return nullptr; // Ring is empty
+    }
+
+    // Single consumer, so no CAS needed on the dequeue counter
+    dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+    std::unique_ptr<std::string> message(slot.item);
+    slot.item = nullptr;
+    slot.sequence.store(pos + CAPACITY, std::memory_order_release);
+    return message;
+}
+
+bool Logger::MessageRing::empty() const {
+    uint64_t pos = dequeuePos_.load(std::memory_order_relaxed);
+    const Slot& slot = slots_[pos & (CAPACITY - 1)];
+    uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+    return static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0;
+}
+
+Logger::Logger() : currentLevel_(Level::Info), running_(true) {
+    writerThread_ = std::thread(&Logger::writerLoop, this);
+}
+
+Logger::~Logger() {
+    running_.store(false);
+    wakeCondition_.notify_one();
+    if (writerThread_.joinable()) {
+        writerThread_.join();
+    }
+
+    // Write whatever is still queued before the streams close
+    std::string remainder;
+    while (auto message = ring_.tryPop()) {
+        remainder += *message;
+        remainder += '\n';
+    }
+    if (!remainder.empty()) {
+        writeBatch(remainder);
+    }
+}
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
 }
 
 void Logger::initialize(const std::string& logFile) {
     if (!logFile.empty()) {
+        std::lock_guard<std::mutex> lock(sinkMutex_);
         fileStream_.open(logFile, std::ios::app);
         if (!fileStream_.is_open()) {
             std::cerr << "Failed to open log file: " << logFile << std::endl;
@@ -17,7 +105,7 @@ void Logger::initialize(const std::string& logFile) {
 }
 
 void Logger::setLevel(Level level) {
-    currentLevel_ = level;
+    currentLevel_.store(level);
 }
 
 void Logger::trace(const std::string& message) {
@@ -73,6 +161,13 @@ void Logger::logErrorWithContext(const std::string& context, const std::string&
 }
 
 void Logger::flush() {
+    // Wait for the writer to drain the ring, then flush the sinks
+    while (running_.load() && !ring_.empty()) {
+        wakeCondition_.notify_one();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::lock_guard<std::mutex> lock(sinkMutex_);
     std::cout << std::flush;
     if (fileStream_.is_open()) {
         fileStream_ << std::flush;
@@ -80,18 +175,58 @@ void Logger::flush() {
 }
 
 void Logger::logMessage(Level level, const std::string& message) {
-    if (level < currentLevel_) {
+    if (level < currentLevel_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // Format on the caller's thread; the writer only does I/O
+    auto formatted = std::make_unique<std::string>(
+        getTimestamp() + " [" + levelToString(level) + "] " + message);
+
+    if (ring_.tryPush(std::move(formatted))) {
+        wakeCondition_.notify_one();
         return;
     }
 
-    std::string formattedMessage = getTimestamp() + " [" + levelToString(level) + "] " + message;
+    // Ring full: errors must not be lost, everything else is counted
+    if (level >= Level::Error) {
+        std::string line = getTimestamp() + " [" + levelToString(level) + "] " + message + '\n';
+        writeBatch(line);
+    } else {
+        droppedMessages_.fetch_add(1);
+    }
+}
 
-    // Console output
-    std::cout << formattedMessage << std::endl;
+void Logger::writerLoop() {
+    std::string batch;
+
+    while (running_.load() || !ring_.empty()) {
+        batch.clear();
+
+        // Coalesce a burst into one write per sink
+        while (auto message = ring_.tryPop()) {
+            batch += *message;
+            batch += '\n';
+            if (batch.size() > 64 * 1024) {
+                break;
+            }
+        }
+
+        if (!batch.empty()) {
+            writeBatch(batch);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wakeCondition_.wait_for(lock, std::chrono::milliseconds(50));
+    }
+}
 
-    // File output
+void Logger::writeBatch(const std::string& batch) {
+    std::lock_guard<std::mutex> lock(sinkMutex_);
+    std::cout << batch << std::flush;
     if (fileStream_.is_open()) {
-        fileStream_ << formattedMessage << std::endl;
+        fileStream_ << batch;
     }
 }
 
@@ -1,15 +1,25 @@
 #pragma once
 
-#include <string>
-#include <iostream>
-#include <sstream>
+#include <atomic>
+#include <condition_variable>
 #include <chrono>
-#include <iomanip>
 #include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
 
 namespace Ragger {
 
-// Simple logging utility that works without external dependencies
+// Async logging utility that works without external dependencies.
+// Callers format the message on their own thread and push it onto a
+// lock-free ring; a background thread batches writes to console/file so
+// hot paths never block on terminal or disk I/O. Errors fall back to a
+// synchronous write when the ring is full; lower levels are dropped and
+// counted instead of stalling producers.
 class Logger {
 public:
     enum class Level {
@@ -22,7 +32,10 @@ public:
     };
 
     Logger();
-    ~Logger() = default;
+    ~Logger();
+
+    // Process-wide logger for hot paths that have no Logger plumbed in
+    static Logger& instance();
 
     // Initialization
     void initialize(const std::string& logFile = "");
@@ -47,17 +60,69 @@ public:
     void logErrorWithContext(const std::string& context, const std::string& error,
                            const std::string& stackTrace = "");
 
-    // Flush logs
+    // Block until queued messages are written and streams are flushed
     void flush();
 
+    uint64_t droppedMessages() const { return droppedMessages_.load(); }
+
 private:
-    Level currentLevel_;
+    // Bounded lock-free multi-producer/single-consumer ring of formatted
+    // messages (Vyukov-style sequence slots, same scheme as EventBus)
+    class MessageRing {
+    public:
+        static const size_t CAPACITY = 8192; // Must be a power of two
+
+        MessageRing();
+        ~MessageRing();
+
+        bool tryPush(std::unique_ptr<std::string> message);
+        std::unique_ptr<std::string> tryPop();
+        bool empty() const;
+
+    private:
+        struct Slot {
+            std::atomic<uint64_t> sequence;
+            std::string* item;
+        };
+
+        Slot slots_[CAPACITY];
+        std::atomic<uint64_t> enqueuePos_;
+        std::atomic<uint64_t> dequeuePos_;
+    };
+
+    std::atomic<Level> currentLevel_;
     std::ofstream fileStream_;
+    std::mutex sinkMutex_; // Guards fileStream_ and the sync fallback path
+
+    MessageRing ring_;
+    std::atomic<uint64_t> droppedMessages_{0};
+
+    // Writer thread
+    std::atomic<bool> running_;
+    std::thread writerThread_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
 
     void logMessage(Level level, const std::string& message);
+    void writerLoop();
+    void writeBatch(const std::string& batch);
     std::string getTimestamp() const;
     std::string levelToString(Level level) const;
     std::string formatContext(const std::string& context) const;
 };
 
 } // namespace Ragger
+
+// Compile-time elision for the chattiest levels: release builds drop
+// trace/debug call sites entirely, including argument formatting.
+#ifdef NDEBUG
+#define RAGGER_LOG_TRACE(message) ((void)0)
+#define RAGGER_LOG_DEBUG(message) ((void)0)
+#else
+#define RAGGER_LOG_TRACE(message) ::Ragger::Logger::instance().trace(message)
+#define RAGGER_LOG_DEBUG(message) ::Ragger::Logger::instance().debug(message)
+#endif
+
+#define RAGGER_LOG_INFO(message) ::Ragger::Logger::instance().info(message)
+#define RAGGER_LOG_WARNING(message) ::Ragger::Logger::instance().warning(message)
+#define RAGGER_LOG_ERROR(message) ::Ragger::Logger::instance().error(message)
@@ -2,12 +2,14 @@
 #include <dlfcn.h>
 #include <iostream>
 #include <algorithm>
+#include <thread>
 // spdlog and nlohmann/json disabled
 
 namespace Ragger {
 
 PluginManager::PluginManager(RaggerCoreAPI* coreAPI)
-    : coreAPI_(coreAPI), sandboxingEnabled_(false) {
+    : coreAPI_(coreAPI), sandboxingEnabled_(false), lazyLoading_(false),
+      idleTimeoutSeconds_(0) {
     // Set default plugin directories
     addPluginDirectory(fs::current_path() / "lib" / "ragger" / "plugins");
 
@@ -61,21 +63,126 @@ int PluginManager::loadPlugin(const fs::path& pluginPath) {
         return result;
     }
 
-    // Initialize the plugin
-    result = initializePlugin(*plugin);
-    if (result != RAGGER_SUCCESS) {
-        unloadPluginLibrary(*plugin);
-        reportPluginError(pluginName, "Failed to initialize plugin", result);
-        return result;
+    return registerLoadedPlugin(std::move(plugin));
+}
+
+int PluginManager::registerLoadedPlugin(std::unique_ptr<LoadedPlugin> plugin) {
+    std::string pluginName = plugin->name;
+
+    // Lazy mode keeps the library mapped but defers plugin_initialize
+    // until something actually asks for this plugin
+    if (!lazyLoading_) {
+        int result = initializePlugin(*plugin);
+        if (result != RAGGER_SUCCESS) {
+            unloadPluginLibrary(*plugin);
+            reportPluginError(pluginName, "Failed to initialize plugin", result);
+            return result;
+        }
+        plugin->initialized = true;
+        plugin->lastUsed = std::chrono::steady_clock::now();
     }
 
     plugin->info.loaded = true;
     loadedPlugins_[pluginName] = std::move(plugin);
 
-    std::cout << "PluginManager: Successfully loaded plugin '" << pluginName << "'" << std::endl;
+    std::cout << "PluginManager: " << (lazyLoading_ ? "Registered" : "Successfully loaded")
+              << " plugin '" << pluginName << "'" << std::endl;
     return RAGGER_SUCCESS;
 }
 
+void PluginManager::setLazyLoading(bool enabled) {
+    lazyLoading_ = enabled;
+    std::cout << "PluginManager: Lazy loading " << (enabled ? "enabled" : "disabled") << std::endl;
+}
+
+bool PluginManager::isLazyLoadingEnabled() const {
+    return lazyLoading_;
+}
+
+int PluginManager::activatePlugin(const std::string& pluginName) {
+    auto it = loadedPlugins_.find(pluginName);
+    if (it == loadedPlugins_.end()) {
+        return RAGGER_ERROR_INVALID_ARGUMENT;
+    }
+
+    auto& plugin = *it->second;
+    plugin.lastUsed = std::chrono::steady_clock::now();
+    if (plugin.initialized) {
+        return RAGGER_SUCCESS;
+    }
+
+    // Declared dependencies activate first; unknown names are assumed
+    // satisfied externally
+    for (const auto& dependency : parseDeclaredDependencies(plugin.info.capabilities)) {
+        if (dependency != pluginName && loadedPlugins_.count(dependency) > 0) {
+            activatePlugin(dependency);
+        }
+    }
+
+    int result = initializePlugin(plugin);
+    if (result != RAGGER_SUCCESS) {
+        reportPluginError(pluginName, "Failed to activate plugin", result);
+        return result;
+    }
+
+    plugin.initialized = true;
+    std::cout << "PluginManager: Activated plugin '" << pluginName << "'" << std::endl;
+    return RAGGER_SUCCESS;
+}
+
+int PluginManager::activatePluginsOfType(PluginType type) {
+    int activated = 0;
+    for (const auto& pair : loadedPlugins_) {
+        if (pair.second->info.type == type &&
+            activatePlugin(pair.first) == RAGGER_SUCCESS) {
+            activated++;
+        }
+    }
+    return activated;
+}
+
+bool PluginManager::isPluginActive(const std::string& pluginName) const {
+    auto it = loadedPlugins_.find(pluginName);
+    return it != loadedPlugins_.end() && it->second->initialized;
+}
+
+void PluginManager::setIdleTimeout(int seconds) {
+    idleTimeoutSeconds_ = seconds;
+}
+
+int PluginManager::deactivateIdlePlugins() {
+    if (idleTimeoutSeconds_ <= 0) {
+        return 0;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    int deactivated = 0;
+
+    for (const auto& pair : loadedPlugins_) {
+        auto& plugin = *pair.second;
+        if (!plugin.initialized) {
+            continue;
+        }
+        auto idle = std::chrono::duration_cast<std::chrono::seconds>(now - plugin.lastUsed);
+        if (idle.count() < idleTimeoutSeconds_) {
+            continue;
+        }
+
+        if (plugin.symbols.unregisterEvents) {
+            plugin.symbols.unregisterEvents();
+        }
+        if (plugin.symbols.shutdown) {
+            plugin.symbols.shutdown();
+        }
+        plugin.interface.api = nullptr;
+        plugin.initialized = false;
+        deactivated++;
+        std::cout << "PluginManager: Deactivated idle plugin '" << pair.first << "'" << std::endl;
+    }
+
+    return deactivated;
+}
+
 int PluginManager::unloadPlugin(const std::string& pluginName) {
     auto it = loadedPlugins_.find(pluginName);
     if (it == loadedPlugins_.end()) {
@@ -128,10 +235,63 @@ int PluginManager::loadPluginsFromDirectory(const fs::path& directory) {
     }
 
     auto pluginPaths = discoverPlugins(directory);
-    int loadedCount = 0;
 
-    for (const auto& path : pluginPaths) {
-        if (loadPlugin(path) == RAGGER_SUCCESS) {
+    // Phase 1: dlopen and symbol resolution in parallel (dlopen is
+    // thread-safe); each thread writes only its own slot
+    std::vector<std::unique_ptr<LoadedPlugin>> candidates(pluginPaths.size());
+    std::vector<int> loadResults(pluginPaths.size(), RAGGER_ERROR_PLUGIN_LOAD_FAILED);
+    std::vector<std::thread> loaders;
+    loaders.reserve(pluginPaths.size());
+
+    for (size_t i = 0; i < pluginPaths.size(); ++i) {
+        loaders.emplace_back([this, i, &pluginPaths, &candidates, &loadResults]() {
+            auto plugin = std::make_unique<LoadedPlugin>();
+            plugin->name = extractPluginNameFromPath(pluginPaths[i]);
+            plugin->info.path = pluginPaths[i];
+            plugin->info.loaded = false;
+
+            int result = loadPluginLibrary(pluginPaths[i], *plugin);
+            if (result == RAGGER_SUCCESS) {
+                result = checkPluginABI(*plugin);
+                if (result != RAGGER_SUCCESS) {
+                    unloadPluginLibrary(*plugin);
+                }
+            }
+
+            if (result == RAGGER_SUCCESS) {
+                candidates[i] = std::move(plugin);
+            }
+            loadResults[i] = result;
+        });
+    }
+
+    for (auto& loader : loaders) {
+        loader.join();
+    }
+
+    // Report failures and drop duplicates now that we are single-threaded
+    std::vector<std::unique_ptr<LoadedPlugin>> toInitialize;
+    for (size_t i = 0; i < pluginPaths.size(); ++i) {
+        if (loadResults[i] != RAGGER_SUCCESS) {
+            reportPluginError(extractPluginNameFromPath(pluginPaths[i]),
+                              "Failed to load plugin library", loadResults[i]);
+            continue;
+        }
+        if (loadedPlugins_.find(candidates[i]->name) != loadedPlugins_.end()) {
+            std::cout << "PluginManager: Plugin '" << candidates[i]->name << "' already loaded" << std::endl;
+            unloadPluginLibrary(*candidates[i]);
+            continue;
+        }
+        toInitialize.push_back(std::move(candidates[i]));
+    }
+
+    // Phase 2: initialize serially, ordered so declared dependencies come
+    // first; plugins without dependencies keep discovery order
+    sortByDependencies(toInitialize);
+
+    int loadedCount = 0;
+    for (auto& plugin : toInitialize) {
+        if (registerLoadedPlugin(std::move(plugin)) == RAGGER_SUCCESS) {
             loadedCount++;
         }
     }
@@ -140,6 +300,97 @@ int PluginManager::loadPluginsFromDirectory(const fs::path& directory) {
     return loadedCount;
 }
 
+std::vector<std::string> PluginManager::parseDeclaredDependencies(const std::string& capabilities) {
+    // Capabilities is a JSON string; we only need the optional
+    // "depends": ["name", ...] array, so a targeted scan avoids pulling
+    // in a JSON dependency
+    std::vector<std::string> dependencies;
+
+    size_t keyPos = capabilities.find("\"depends\"");
+    if (keyPos == std::string::npos) {
+        return dependencies;
+    }
+
+    size_t arrayStart = capabilities.find('[', keyPos);
+    size_t arrayEnd = capabilities.find(']', arrayStart);
+    if (arrayStart == std::string::npos || arrayEnd == std::string::npos) {
+        return dependencies;
+    }
+
+    size_t pos = arrayStart;
+    while (pos < arrayEnd) {
+        size_t quoteStart = capabilities.find('"', pos + 1);
+        if (quoteStart == std::string::npos || quoteStart >= arrayEnd) {
+            break;
+        }
+        size_t quoteEnd = capabilities.find('"', quoteStart + 1);
+        if (quoteEnd == std::string::npos || quoteEnd > arrayEnd) {
+            break;
+        }
+        dependencies.push_back(capabilities.substr(quoteStart + 1, quoteEnd - quoteStart - 1));
+        pos = quoteEnd;
+    }
+
+    return dependencies;
+}
+
+void PluginManager::sortByDependencies(std::vector<std::unique_ptr<LoadedPlugin>>& plugins) {
+    // Stable topological order via repeated selection: emit any plugin
+    // whose declared dependencies (within this batch) are already emitted.
+    // Unknown dependency names are assumed satisfied externally; a cycle
+    // falls back to the remaining discovery order rather than deadlocking
+    std::vector<std::unique_ptr<LoadedPlugin>> ordered;
+    ordered.reserve(plugins.size());
+    std::vector<bool> emitted(plugins.size(), false);
+    std::vector<std::vector<std::string>> dependencies(plugins.size());
+
+    for (size_t i = 0; i < plugins.size(); ++i) {
+        dependencies[i] = parseDeclaredDependencies(plugins[i]->info.capabilities);
+    }
+
+    auto isEmitted = [&](const std::string& name) {
+        for (size_t i = 0; i < plugins.size(); ++i) {
+            if (plugins[i] && plugins[i]->name == name && !emitted[i]) {
+                return false;
+            }
+        }
+        return true; // Emitted, or not part of this batch
+    };
+
+    bool progress = true;
+    while (ordered.size() < plugins.size() && progress) {
+        progress = false;
+        for (size_t i = 0; i < plugins.size(); ++i) {
+            if (emitted[i]) {
+                continue;
+            }
+            bool ready = true;
+            for (const auto& dependency : dependencies[i]) {
+                if (!isEmitted(dependency)) {
+                    ready = false;
+                    break;
+                }
+            }
+            if (ready) {
+                emitted[i] = true;
+                ordered.push_back(std::move(plugins[i]));
+                progress = true;
+            }
+        }
+    }
+
+    // Cycle (or self-dependency): append leftovers in original order
+    for (size_t i = 0; i < plugins.size(); ++i) {
+        if (!emitted[i]) {
+            std::cerr << "PluginManager: Dependency cycle involving plugin '"
+                      << plugins[i]->name << "', using discovery order" << std::endl;
+            ordered.push_back(std::move(plugins[i]));
+        }
+    }
+
+    plugins = std::move(ordered);
+}
+
 int PluginManager::unloadAllPlugins() {
     int unloadedCount = 0;
     std::vector<std::string> pluginNames;
@@ -267,6 +518,32 @@ std::vector<PluginManager::PluginInfo> PluginManager::getAllPluginInfo() const {
     return infos;
 }
 
+bool PluginManager::supportsBatchParse(const std::string& pluginName) const {
+    auto it = loadedPlugins_.find(pluginName);
+    return it != loadedPlugins_.end() &&
+           it->second->symbols.parseFiles && it->second->symbols.freeBatch;
+}
+
+int PluginManager::parseFilesBatch(const std::string& pluginName, const char** filePaths,
+                                   size_t numFiles, ParseBatchResult** results) {
+    auto it = loadedPlugins_.find(pluginName);
+    if (it == loadedPlugins_.end() || !it->second->symbols.parseFiles) {
+        return RAGGER_ERROR_OPERATION_NOT_SUPPORTED;
+    }
+
+    // Lazily loaded parsers must be live before the cross-DSO call
+    activatePlugin(pluginName);
+    return it->second->symbols.parseFiles(filePaths, numFiles, results);
+}
+
+void PluginManager::freeParseBatch(const std::string& pluginName, ParseBatchResult* results,
+                                   size_t numFiles) {
+    auto it = loadedPlugins_.find(pluginName);
+    if (it != loadedPlugins_.end() && it->second->symbols.freeBatch) {
+        it->second->symbols.freeBatch(results, numFiles);
+    }
+}
+
 const std::vector<PluginManager::PluginError>& PluginManager::getPluginErrors() const {
     return pluginErrors_;
 }
@@ -291,65 +568,130 @@ int PluginManager::loadPluginLibrary(const fs::path& pluginPath, LoadedPlugin& p
         return RAGGER_ERROR_PLUGIN_LOAD_FAILED;
     }
 
-    // Load required functions
-    auto get_abi_version = reinterpret_cast<decltype(plugin_get_abi_version)*>(
+    // Resolve every exported entry point once; call paths use these
+    // cached pointers instead of re-running dlsym
+    auto& symbols = plugin.symbols;
+    symbols.getAbiVersion = reinterpret_cast<decltype(plugin_get_abi_version)*>(
         dlsym(plugin.libraryHandle, "plugin_get_abi_version"));
-    auto get_name = reinterpret_cast<decltype(plugin_get_name)*>(
+    symbols.getName = reinterpret_cast<decltype(plugin_get_name)*>(
         dlsym(plugin.libraryHandle, "plugin_get_name"));
-    auto get_version = reinterpret_cast<decltype(plugin_get_version)*>(
+    symbols.getVersion = reinterpret_cast<decltype(plugin_get_version)*>(
         dlsym(plugin.libraryHandle, "plugin_get_version"));
-    auto get_description = reinterpret_cast<decltype(plugin_get_description)*>(
+    symbols.getDescription = reinterpret_cast<decltype(plugin_get_description)*>(
         dlsym(plugin.libraryHandle, "plugin_get_description"));
-
-    if (!get_abi_version || !get_name || !get_version || !get_description) {
+    symbols.initialize = reinterpret_cast<decltype(plugin_initialize)*>(
+        dlsym(plugin.libraryHandle, "plugin_initialize"));
+    symbols.shutdown = reinterpret_cast<decltype(plugin_shutdown)*>(
+        dlsym(plugin.libraryHandle, "plugin_shutdown"));
+    symbols.registerEvents = reinterpret_cast<decltype(plugin_register_events)*>(
+        dlsym(plugin.libraryHandle, "plugin_register_events"));
+    symbols.unregisterEvents = reinterpret_cast<decltype(plugin_unregister_events)*>(
+        dlsym(plugin.libraryHandle, "plugin_unregister_events"));
+    symbols.getCapabilities = reinterpret_cast<decltype(plugin_get_capabilities)*>(
+        dlsym(plugin.libraryHandle, "plugin_get_capabilities"));
+    symbols.getInterface = reinterpret_cast<PluginGetInterfaceFunc>(
+        dlsym(plugin.libraryHandle, "ragger_plugin_get_interface"));
+
+    // Optional batch parse entry points; absent on pre-101 parsers
+    symbols.parseFiles = reinterpret_cast<int (*)(const char**, size_t, ParseBatchResult**)>(
+        dlsym(plugin.libraryHandle, "ragger_parser_parse_files"));
+    symbols.freeBatch = reinterpret_cast<void (*)(ParseBatchResult*, size_t)>(
+        dlsym(plugin.libraryHandle, "ragger_parser_free_batch"));
+
+    // Ranker entry points; absent on non-ranker plugins
+    symbols.rankerGetRankingType = reinterpret_cast<const char* (*)()>(
+        dlsym(plugin.libraryHandle, "ragger_ranker_get_ranking_type"));
+    symbols.rankerGetDefaultWeight = reinterpret_cast<float (*)()>(
+        dlsym(plugin.libraryHandle, "ragger_ranker_get_default_weight"));
+    symbols.rankerRankBlocks = reinterpret_cast<int (*)(const ContextRequest*, RankingResult**, size_t*)>(
+        dlsym(plugin.libraryHandle, "ragger_ranker_rank_blocks"));
+    symbols.rankerFreeResults = reinterpret_cast<void (*)(RankingResult*, size_t)>(
+        dlsym(plugin.libraryHandle, "ragger_ranker_free_results"));
+    symbols.rankerUpdateWeights = reinterpret_cast<int (*)(const float*, size_t)>(
+        dlsym(plugin.libraryHandle, "ragger_ranker_update_weights"));
+    symbols.rankerTrainOnFeedback = reinterpret_cast<int (*)(const ContextRequest*, const ContextResponse*)>(
+        dlsym(plugin.libraryHandle, "ragger_ranker_train_on_feedback"));
+
+    if (!symbols.getAbiVersion || !symbols.getName || !symbols.getVersion || !symbols.getDescription) {
         std::cerr << "PluginManager: Missing required functions in plugin " << pluginPath.string() << std::endl;
         dlclose(plugin.libraryHandle);
         plugin.libraryHandle = nullptr;
+        plugin.symbols = PluginEntryPoints();
         return RAGGER_ERROR_PLUGIN_LOAD_FAILED;
     }
 
-    // Get plugin metadata
-    plugin.info.abiVersion = get_abi_version();
-    plugin.info.name = get_name();
-    plugin.info.version = get_version();
-    plugin.info.description = get_description();
+    // Get plugin metadata; capabilities are plain constants, so fetching
+    // them here lets lazy mode classify plugins without initializing them
+    plugin.info.abiVersion = symbols.getAbiVersion();
+    plugin.info.name = symbols.getName();
+    plugin.info.version = symbols.getVersion();
+    plugin.info.description = symbols.getDescription();
+    if (symbols.getCapabilities) {
+        plugin.info.capabilities = symbols.getCapabilities();
+    }
+    plugin.info.type = classifyPluginType(plugin.info.capabilities);
+    plugin.interface.type = plugin.info.type;
 
     return RAGGER_SUCCESS;
 }
 
-int PluginManager::initializePlugin(LoadedPlugin& plugin) {
-    // Load plugin-specific functions
-    auto initialize = reinterpret_cast<decltype(plugin_initialize)*>(
-        dlsym(plugin.libraryHandle, "plugin_initialize"));
-    auto register_events = reinterpret_cast<decltype(plugin_register_events)*>(
-        dlsym(plugin.libraryHandle, "plugin_register_events"));
-    auto get_capabilities = reinterpret_cast<decltype(plugin_get_capabilities)*>(
-        dlsym(plugin.libraryHandle, "plugin_get_capabilities"));
+PluginType PluginManager::classifyPluginType(const std::string& capabilities) {
+    // Capability JSON uses a characteristic top-level section per plugin
+    // family (see plugins/*/plugin_get_capabilities)
+    if (capabilities.find("\"ranking\"") != std::string::npos) {
+        return PLUGIN_TYPE_RANKER;
+    }
+    if (capabilities.find("\"parser\"") != std::string::npos) {
+        return PLUGIN_TYPE_PARSER;
+    }
+    if (capabilities.find("\"lsp\"") != std::string::npos) {
+        return PLUGIN_TYPE_LSP_CLIENT;
+    }
+    if (capabilities.find("\"git_integration\"") != std::string::npos) {
+        return PLUGIN_TYPE_GIT_INTEGRATION;
+    }
+    if (capabilities.find("\"llm\"") != std::string::npos) {
+        return PLUGIN_TYPE_LLM_BACKEND;
+    }
+    return PLUGIN_TYPE_CONTEXT;
+}
 
-    if (!initialize) {
+int PluginManager::initializePlugin(LoadedPlugin& plugin) {
+    if (!plugin.symbols.initialize) {
         std::cerr << "PluginManager: Missing plugin_initialize function in plugin " << plugin.info.name << std::endl;
         return RAGGER_ERROR_PLUGIN_LOAD_FAILED;
     }
 
     // Initialize plugin
-    int result = initialize(coreAPI_);
+    int result = plugin.symbols.initialize(coreAPI_);
     if (result != RAGGER_SUCCESS) {
         std::cerr << "PluginManager: Plugin initialization failed for " << plugin.info.name << std::endl;
         return result;
     }
 
     // Register for events if supported
-    if (register_events) {
-        register_events(nullptr, nullptr); // Plugin handles event registration internally
+    if (plugin.symbols.registerEvents) {
+        plugin.symbols.registerEvents(nullptr, nullptr); // Plugin handles event registration internally
     }
 
-    // Get capabilities
-    if (get_capabilities) {
-        plugin.info.capabilities = get_capabilities();
+    // Bind the typed interface now that the plugin has state behind it
+    if (plugin.symbols.getInterface) {
+        plugin.symbols.getInterface(plugin.handle, &plugin.interface);
     }
 
-    // Load plugin interface (this would be implemented by specific plugin types)
-    // For now, we'll assume it's set during initialization
+    // Rankers publish their entry points as ragger_ranker_* exports and
+    // return a null api from ragger_plugin_get_interface; assemble the
+    // typed API core-side so dispatchRankers has something to call
+    if (plugin.interface.type == PLUGIN_TYPE_RANKER && !plugin.interface.api &&
+        plugin.symbols.rankerRankBlocks) {
+        plugin.rankerAPI.get_ranking_type = plugin.symbols.rankerGetRankingType;
+        plugin.rankerAPI.get_default_weight = plugin.symbols.rankerGetDefaultWeight;
+        plugin.rankerAPI.rank_blocks = plugin.symbols.rankerRankBlocks;
+        plugin.rankerAPI.free_results = plugin.symbols.rankerFreeResults;
+        plugin.rankerAPI.update_weights = plugin.symbols.rankerUpdateWeights;
+        plugin.rankerAPI.train_on_feedback = plugin.symbols.rankerTrainOnFeedback;
+        plugin.interface.api = &plugin.rankerAPI;
+    }
 
     return RAGGER_SUCCESS;
 }
@@ -357,11 +699,9 @@ int PluginManager::initializePlugin(LoadedPlugin& plugin) {
 void PluginManager::unloadPluginLibrary(LoadedPlugin& plugin) {
     if (plugin.libraryHandle) {
         // Call shutdown if available
-        auto shutdown = reinterpret_cast<decltype(plugin_shutdown)*>(
-            dlsym(plugin.libraryHandle, "plugin_shutdown"));
-        if (shutdown) {
+        if (plugin.symbols.shutdown) {
             try {
-                shutdown();
+                plugin.symbols.shutdown();
             } catch (const std::exception& e) {
                 std::cerr << "PluginManager: Exception during plugin shutdown: " << e.what() << std::endl;
             }
@@ -369,6 +709,7 @@ void PluginManager::unloadPluginLibrary(LoadedPlugin& plugin) {
 
         dlclose(plugin.libraryHandle);
         plugin.libraryHandle = nullptr;
+        plugin.symbols = PluginEntryPoints();
     }
 }
 
@@ -404,9 +745,13 @@ std::string PluginManager::extractPluginNameFromPath(const fs::path& path) const
 }
 
 int PluginManager::checkPluginABI(const LoadedPlugin& plugin) const {
-    if (plugin.info.abiVersion != RAGGER_PLUGIN_ABI_VERSION) {
-        std::cerr << "PluginManager: ABI version mismatch for plugin " << plugin.info.name 
-                  << ": expected " << RAGGER_PLUGIN_ABI_VERSION << ", got " << plugin.info.abiVersion << std::endl;
+    // Newer entry points are optional and probed at load time, so any
+    // version back to the minimum still works
+    if (plugin.info.abiVersion < RAGGER_PLUGIN_ABI_VERSION_MIN ||
+        plugin.info.abiVersion > RAGGER_PLUGIN_ABI_VERSION) {
+        std::cerr << "PluginManager: ABI version mismatch for plugin " << plugin.info.name
+                  << ": expected " << RAGGER_PLUGIN_ABI_VERSION_MIN << ".." << RAGGER_PLUGIN_ABI_VERSION
+                  << ", got " << plugin.info.abiVersion << std::endl;
         return RAGGER_ERROR_ABI_VERSION_MISMATCH;
     }
     return RAGGER_SUCCESS;
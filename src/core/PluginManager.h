@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ragger_plugin_api.h"
+#include <chrono>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -56,9 +57,60 @@ public:
         std::string capabilities; // JSON string
     };
 
+    // Exported entry points resolved once at load time so call paths never
+    // go back through dlsym
+    struct PluginEntryPoints {
+        decltype(plugin_get_abi_version)* getAbiVersion;
+        decltype(plugin_get_name)* getName;
+        decltype(plugin_get_version)* getVersion;
+        decltype(plugin_get_description)* getDescription;
+        decltype(plugin_initialize)* initialize;
+        decltype(plugin_shutdown)* shutdown;
+        decltype(plugin_register_events)* registerEvents;
+        decltype(plugin_unregister_events)* unregisterEvents;
+        decltype(plugin_get_capabilities)* getCapabilities;
+        PluginGetInterfaceFunc getInterface;
+
+        // Optional batch parse entry points (ABI 101); null on parsers
+        // built before the batch API existed
+        int (*parseFiles)(const char** filePaths, size_t numFiles, ParseBatchResult** results);
+        void (*freeBatch)(ParseBatchResult* results, size_t numFiles);
+
+        // Ranker entry points. Rankers export these as ragger_ranker_*
+        // symbols and leave PluginInterface::api null; the manager
+        // assembles a RankerPluginAPI from them after initialization.
+        const char* (*rankerGetRankingType)();
+        float (*rankerGetDefaultWeight)();
+        int (*rankerRankBlocks)(const ContextRequest* request, RankingResult** results,
+                                size_t* numResults);
+        void (*rankerFreeResults)(RankingResult* results, size_t numResults);
+        int (*rankerUpdateWeights)(const float* newWeights, size_t numWeights);
+        int (*rankerTrainOnFeedback)(const ContextRequest* request,
+                                     const ContextResponse* response);
+
+        PluginEntryPoints()
+            : getAbiVersion(nullptr), getName(nullptr), getVersion(nullptr),
+              getDescription(nullptr), initialize(nullptr), shutdown(nullptr),
+              registerEvents(nullptr), unregisterEvents(nullptr),
+              getCapabilities(nullptr), getInterface(nullptr),
+              parseFiles(nullptr), freeBatch(nullptr),
+              rankerGetRankingType(nullptr), rankerGetDefaultWeight(nullptr),
+              rankerRankBlocks(nullptr), rankerFreeResults(nullptr),
+              rankerUpdateWeights(nullptr), rankerTrainOnFeedback(nullptr) {}
+    };
+
     const PluginInfo* getPluginInfo(const std::string& pluginName) const;
     std::vector<PluginInfo> getAllPluginInfo() const;
 
+    // Batch parsing negotiation: parsers loaded with ABI >= 101 may export
+    // parse_files/free_batch; callers probe before falling back to the
+    // one-file-per-call path
+    bool supportsBatchParse(const std::string& pluginName) const;
+    int parseFilesBatch(const std::string& pluginName, const char** filePaths,
+                        size_t numFiles, ParseBatchResult** results);
+    void freeParseBatch(const std::string& pluginName, ParseBatchResult* results,
+                        size_t numFiles);
+
     // Error handling and recovery
     struct PluginError {
         std::string pluginName;
@@ -70,6 +122,18 @@ public:
     const std::vector<PluginError>& getPluginErrors() const;
     void clearPluginErrors();
 
+    // Lazy activation: directory loads only scan metadata (name, type,
+    // capabilities); plugin_initialize is deferred until something asks
+    // for that plugin, and idle plugins are shut down again after a
+    // configurable quiet period (library stays mapped for cheap restart)
+    void setLazyLoading(bool enabled);
+    bool isLazyLoadingEnabled() const;
+    int activatePlugin(const std::string& pluginName);
+    int activatePluginsOfType(PluginType type);
+    bool isPluginActive(const std::string& pluginName) const;
+    void setIdleTimeout(int seconds); // <= 0 disables idle deactivation
+    int deactivateIdlePlugins();
+
     // Plugin sandboxing (future feature)
     void enableSandboxing(bool enabled);
     bool isSandboxingEnabled() const;
@@ -80,10 +144,19 @@ private:
         PluginHandle handle;
         PluginInterface interface;
         PluginInfo info;
+        PluginEntryPoints symbols;
+        // Core-assembled typed API for rankers; interface.api points here
+        // when the plugin exports ragger_ranker_* symbols instead of
+        // returning a populated struct from ragger_plugin_get_interface
+        RankerPluginAPI rankerAPI{};
         void* libraryHandle; // dlopen handle
         bool sandboxed;
+        bool initialized;
+        std::chrono::steady_clock::time_point lastUsed;
 
-        LoadedPlugin() : handle(nullptr), libraryHandle(nullptr), sandboxed(false) {}
+        LoadedPlugin()
+            : handle(nullptr), libraryHandle(nullptr), sandboxed(false),
+              initialized(false) {}
     };
 
     RaggerCoreAPI* coreAPI_;
@@ -93,11 +166,22 @@ private:
     fs::path projectPluginDirectory_;
     std::vector<PluginError> pluginErrors_;
     bool sandboxingEnabled_;
+    bool lazyLoading_;
+    int idleTimeoutSeconds_;
 
     // Plugin loading helpers
     int loadPluginLibrary(const fs::path& pluginPath, LoadedPlugin& plugin);
     int initializePlugin(LoadedPlugin& plugin);
     void unloadPluginLibrary(LoadedPlugin& plugin);
+    int registerLoadedPlugin(std::unique_ptr<LoadedPlugin> plugin);
+
+    // Dependency ordering for directory loads
+    static std::vector<std::string> parseDeclaredDependencies(const std::string& capabilities);
+    static void sortByDependencies(std::vector<std::unique_ptr<LoadedPlugin>>& plugins);
+
+    // Capability-based classification so plugin types are known before
+    // initialization
+    static PluginType classifyPluginType(const std::string& capabilities);
 
     // Plugin discovery helpers
     std::vector<fs::path> discoverPlugins(const fs::path& directory) const;
@@ -0,0 +1,253 @@
+#include "SymbolIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <unordered_set>
+
+namespace Ragger {
+
+std::string SymbolIndex::toLower(const std::string& text) {
+    std::string lowered = text;
+    std::transform(lowered.begin(), lowered.end(), lowered.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return lowered;
+}
+
+std::vector<uint32_t> SymbolIndex::trigramsOf(const std::string& lowered) {
+    std::vector<uint32_t> trigrams;
+    if (lowered.size() < 3) {
+        return trigrams;
+    }
+    for (size_t i = 0; i + 3 <= lowered.size(); ++i) {
+        uint32_t packed = (static_cast<unsigned char>(lowered[i]) << 16) |
+                          (static_cast<unsigned char>(lowered[i + 1]) << 8) |
+                          static_cast<unsigned char>(lowered[i + 2]);
+        trigrams.push_back(packed);
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
+
+bool SymbolIndex::isSubsequence(const std::string& needle, const std::string& haystack) {
+    size_t n = 0;
+    for (size_t h = 0; h < haystack.size() && n < needle.size(); ++h) {
+        if (haystack[h] == needle[n]) {
+            ++n;
+        }
+    }
+    return n == needle.size();
+}
+
+void SymbolIndex::add(int64_t blockId, const std::string& name, const std::string& filePath) {
+    if (name.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    uint32_t id = static_cast<uint32_t>(entries_.size());
+    Entry entry;
+    entry.name = name;
+    entry.lowered = toLower(name);
+    entry.filePath = filePath;
+    entry.blockId = blockId;
+    entry.alive = true;
+
+    for (uint32_t trigram : trigramsOf(entry.lowered)) {
+        trigramPostings_[trigram].push_back(id);
+    }
+    entriesByFile_[filePath].push_back(id);
+    entries_.push_back(std::move(entry));
+
+    unsortedTail_.push_back(id);
+    if (unsortedTail_.size() > TAIL_MERGE_THRESHOLD) {
+        mergeTailLocked();
+    }
+}
+
+void SymbolIndex::removeFile(const std::string& filePath) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = entriesByFile_.find(filePath);
+    if (it == entriesByFile_.end()) {
+        return;
+    }
+
+    for (uint32_t id : it->second) {
+        if (entries_[id].alive) {
+            entries_[id].alive = false;
+            ++deadCount_;
+        }
+    }
+    entriesByFile_.erase(it);
+
+    if (deadCount_ * 2 > entries_.size()) {
+        compactLocked();
+    }
+}
+
+void SymbolIndex::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    trigramPostings_.clear();
+    entriesByFile_.clear();
+    sortedByName_.clear();
+    unsortedTail_.clear();
+    deadCount_ = 0;
+}
+
+size_t SymbolIndex::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size() - deadCount_;
+}
+
+void SymbolIndex::compactLocked() {
+    std::vector<Entry> live;
+    live.reserve(entries_.size() - deadCount_);
+    for (auto& entry : entries_) {
+        if (entry.alive) {
+            live.push_back(std::move(entry));
+        }
+    }
+
+    entries_ = std::move(live);
+    trigramPostings_.clear();
+    entriesByFile_.clear();
+    deadCount_ = 0;
+
+    for (uint32_t id = 0; id < entries_.size(); ++id) {
+        for (uint32_t trigram : trigramsOf(entries_[id].lowered)) {
+            trigramPostings_[trigram].push_back(id);
+        }
+        entriesByFile_[entries_[id].filePath].push_back(id);
+    }
+
+    sortedByName_.resize(entries_.size());
+    for (uint32_t id = 0; id < entries_.size(); ++id) {
+        sortedByName_[id] = id;
+    }
+    std::sort(sortedByName_.begin(), sortedByName_.end(),
+        [this](uint32_t a, uint32_t b) { return entries_[a].lowered < entries_[b].lowered; });
+    unsortedTail_.clear();
+}
+
+void SymbolIndex::mergeTailLocked() const {
+    if (unsortedTail_.empty()) {
+        return;
+    }
+
+    auto byName = [this](uint32_t a, uint32_t b) {
+        return entries_[a].lowered < entries_[b].lowered;
+    };
+
+    std::sort(unsortedTail_.begin(), unsortedTail_.end(), byName);
+    size_t sortedSize = sortedByName_.size();
+    sortedByName_.insert(sortedByName_.end(), unsortedTail_.begin(), unsortedTail_.end());
+    std::inplace_merge(sortedByName_.begin(), sortedByName_.begin() + sortedSize,
+                       sortedByName_.end(), byName);
+    unsortedTail_.clear();
+}
+
+void SymbolIndex::collectExactLocked(const std::string& lowered, size_t maxResults,
+                                     std::vector<Match>& results) const {
+    mergeTailLocked();
+
+    auto first = std::lower_bound(sortedByName_.begin(), sortedByName_.end(), lowered,
+        [this](uint32_t id, const std::string& value) { return entries_[id].lowered < value; });
+
+    for (auto it = first; it != sortedByName_.end() && results.size() < maxResults; ++it) {
+        const Entry& entry = entries_[*it];
+        if (entry.lowered != lowered) {
+            break;
+        }
+        if (entry.alive) {
+            results.push_back({entry.blockId, entry.name, entry.filePath});
+        }
+    }
+}
+
+void SymbolIndex::collectPrefixLocked(const std::string& lowered, size_t maxResults,
+                                      std::vector<Match>& results) const {
+    mergeTailLocked();
+
+    auto first = std::lower_bound(sortedByName_.begin(), sortedByName_.end(), lowered,
+        [this](uint32_t id, const std::string& value) { return entries_[id].lowered < value; });
+
+    for (auto it = first; it != sortedByName_.end() && results.size() < maxResults; ++it) {
+        const Entry& entry = entries_[*it];
+        if (entry.lowered.compare(0, lowered.size(), lowered) != 0) {
+            break; // Past the prefix range
+        }
+        if (!entry.alive || entry.lowered == lowered) {
+            continue; // Dead, or already reported by the exact tier
+        }
+        results.push_back({entry.blockId, entry.name, entry.filePath});
+    }
+}
+
+void SymbolIndex::collectFuzzyLocked(const std::string& lowered, size_t maxResults,
+                                     std::vector<Match>& results) const {
+    std::vector<uint32_t> queryTrigrams = trigramsOf(lowered);
+    if (queryTrigrams.empty()) {
+        return; // Queries under three characters stop at the prefix tier
+    }
+
+    // Candidates ranked by shared trigram count, then verified as
+    // subsequence matches so "fbar" still finds "foo_bar"-style names
+    std::unordered_map<uint32_t, uint32_t> candidateHits;
+    for (uint32_t trigram : queryTrigrams) {
+        auto it = trigramPostings_.find(trigram);
+        if (it == trigramPostings_.end()) {
+            continue;
+        }
+        for (uint32_t id : it->second) {
+            ++candidateHits[id];
+        }
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> ranked(candidateHits.begin(), candidateHits.end());
+    std::sort(ranked.begin(), ranked.end(),
+        [](const auto& a, const auto& b) { return a.second > b.second; });
+
+    std::unordered_set<int64_t> seen;
+    for (const auto& match : results) {
+        seen.insert(match.blockId);
+    }
+
+    for (const auto& candidate : ranked) {
+        if (results.size() >= maxResults) {
+            break;
+        }
+        const Entry& entry = entries_[candidate.first];
+        if (!entry.alive || seen.count(entry.blockId)) {
+            continue;
+        }
+        if (isSubsequence(lowered, entry.lowered)) {
+            results.push_back({entry.blockId, entry.name, entry.filePath});
+            seen.insert(entry.blockId);
+        }
+    }
+}
+
+std::vector<SymbolIndex::Match> SymbolIndex::lookup(const std::string& query,
+                                                    size_t maxResults) const {
+    std::vector<Match> results;
+    if (query.empty() || maxResults == 0) {
+        return results;
+    }
+
+    std::string lowered = toLower(query);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    collectExactLocked(lowered, maxResults, results);
+    if (results.size() < maxResults) {
+        collectPrefixLocked(lowered, maxResults, results);
+    }
+    if (results.size() < maxResults) {
+        collectFuzzyLocked(lowered, maxResults, results);
+    }
+    return results;
+}
+
+} // namespace Ragger
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Ragger {
+
+// In-memory symbol search structure behind IndexManager::findCodeBlocks.
+//
+// Two access paths over the indexed symbol names:
+//  - a sorted array of name ids for exact and prefix lookup (binary search)
+//  - a trigram postings map for fuzzy lookup: candidates are gathered by
+//    shared trigrams, ranked by overlap and verified as case-insensitive
+//    subsequence matches
+//
+// The indexing pipeline keeps it in sync incrementally: add() per inserted
+// block, removeFile() when a file's records are deleted. Removal uses
+// tombstones; the structures compact once half the entries are dead.
+class SymbolIndex {
+public:
+    struct Match {
+        int64_t blockId;
+        std::string name;
+        std::string filePath;
+    };
+
+    // Mutation (single-writer, same thread as the SQLite writer)
+    void add(int64_t blockId, const std::string& name, const std::string& filePath);
+    void removeFile(const std::string& filePath);
+    void clear();
+
+    // Tiered lookup: exact, then prefix, then fuzzy until maxResults
+    std::vector<Match> lookup(const std::string& query, size_t maxResults) const;
+
+    size_t size() const;
+
+private:
+    struct Entry {
+        std::string name;
+        std::string lowered;
+        std::string filePath;
+        int64_t blockId;
+        bool alive;
+    };
+
+    std::vector<Entry> entries_;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> trigramPostings_;
+    std::unordered_map<std::string, std::vector<uint32_t>> entriesByFile_;
+    size_t deadCount_ = 0;
+
+    // Entry ids ordered by lowered name, plus a bounded unsorted tail of
+    // recent additions. Queries binary-search the sorted part and scan the
+    // tail; the tail is merged in (amortized) once it passes the threshold,
+    // so bulk indexing never pays a per-add vector insert.
+    mutable std::vector<uint32_t> sortedByName_;
+    mutable std::vector<uint32_t> unsortedTail_;
+    static const size_t TAIL_MERGE_THRESHOLD = 1024;
+
+    mutable std::mutex mutex_;
+
+    void mergeTailLocked() const;
+    void compactLocked();
+    void collectExactLocked(const std::string& lowered, size_t maxResults,
+                            std::vector<Match>& results) const;
+    void collectPrefixLocked(const std::string& lowered, size_t maxResults,
+                             std::vector<Match>& results) const;
+    void collectFuzzyLocked(const std::string& lowered, size_t maxResults,
+                            std::vector<Match>& results) const;
+
+    static std::string toLower(const std::string& text);
+    static std::vector<uint32_t> trigramsOf(const std::string& lowered);
+    static bool isSubsequence(const std::string& needle, const std::string& haystack);
+};
+
+} // namespace Ragger
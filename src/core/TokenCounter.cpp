@@ -0,0 +1,201 @@
+#include "TokenCounter.h"
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace Ragger {
+
+namespace {
+
+// Minimal base64 decoder for tiktoken vocabulary lines
+bool decodeBase64(const std::string& input, std::string& output) {
+    static const std::string alphabet =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    output.clear();
+    int accumulator = 0;
+    int bits = 0;
+
+    for (char c : input) {
+        if (c == '=') break;
+        size_t value = alphabet.find(c);
+        if (value == std::string::npos) {
+            return false;
+        }
+        accumulator = (accumulator << 6) | static_cast<int>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            output += static_cast<char>((accumulator >> bits) & 0xFF);
+        }
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+TokenCounter::TokenCounter()
+    : vocabularyLoaded_(false) {
+}
+
+bool TokenCounter::loadVocabulary(const fs::path& vocabPath) {
+    std::ifstream file(vocabPath);
+    if (!file) {
+        return false;
+    }
+
+    std::unordered_map<std::string, int> ranks;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+
+        size_t space = line.find(' ');
+        if (space == std::string::npos) {
+            return false;
+        }
+
+        std::string tokenBytes;
+        if (!decodeBase64(line.substr(0, space), tokenBytes)) {
+            return false;
+        }
+
+        ranks[tokenBytes] = std::atoi(line.c_str() + space + 1);
+    }
+
+    if (ranks.empty()) {
+        return false;
+    }
+
+    ranks_ = std::move(ranks);
+    vocabularyLoaded_ = true;
+    clearCache(); // Heuristic counts are stale once exact counts exist
+    std::cout << "TokenCounter: Loaded " << ranks_.size() << " vocabulary entries" << std::endl;
+    return true;
+}
+
+bool TokenCounter::hasVocabulary() const {
+    return vocabularyLoaded_;
+}
+
+int TokenCounter::countTokens(std::string_view text) {
+    if (text.empty()) {
+        return 0;
+    }
+
+    uint64_t key = hashContent(text);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto it = countCache_.find(key);
+        if (it != countCache_.end()) {
+            return it->second;
+        }
+    }
+
+    int count = countUncached(text);
+
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    countCache_[key] = count;
+    return count;
+}
+
+void TokenCounter::clearCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    countCache_.clear();
+}
+
+// Split into pieces roughly the way GPT-style pre-tokenization does
+// (identifier runs, digit runs, whitespace runs, single punctuation) and
+// count each piece.
+int TokenCounter::countUncached(std::string_view text) const {
+    int total = 0;
+    size_t pos = 0;
+
+    auto classify = [](unsigned char c) {
+        if (std::isalpha(c) || c == '_') return 0;
+        if (std::isdigit(c)) return 1;
+        if (std::isspace(c)) return 2;
+        return 3; // punctuation/other: one piece per byte
+    };
+
+    while (pos < text.size()) {
+        int cls = classify(static_cast<unsigned char>(text[pos]));
+        size_t end = pos + 1;
+
+        if (cls != 3) {
+            while (end < text.size() &&
+                   classify(static_cast<unsigned char>(text[end])) == cls) {
+                ++end;
+            }
+        }
+
+        total += countPiece(text.substr(pos, end - pos));
+        pos = end;
+    }
+
+    return total;
+}
+
+int TokenCounter::countPiece(std::string_view piece) const {
+    if (vocabularyLoaded_) {
+        return bpeTokenCount(piece);
+    }
+
+    // Heuristic fallback: subword units average roughly four bytes
+    return static_cast<int>((piece.size() + 3) / 4);
+}
+
+// Greedy BPE: start from single bytes and repeatedly merge the adjacent
+// pair with the lowest vocabulary rank until no pair is in the vocabulary.
+int TokenCounter::bpeTokenCount(std::string_view piece) const {
+    if (piece.size() <= 1) {
+        return static_cast<int>(piece.size());
+    }
+
+    // Whole-piece match is common (keywords, short identifiers)
+    if (ranks_.count(std::string(piece)) > 0) {
+        return 1;
+    }
+
+    std::vector<std::string> symbols;
+    symbols.reserve(piece.size());
+    for (char c : piece) {
+        symbols.emplace_back(1, c);
+    }
+
+    for (;;) {
+        int bestRank = std::numeric_limits<int>::max();
+        size_t bestIndex = symbols.size();
+
+        for (size_t i = 0; i + 1 < symbols.size(); ++i) {
+            auto it = ranks_.find(symbols[i] + symbols[i + 1]);
+            if (it != ranks_.end() && it->second < bestRank) {
+                bestRank = it->second;
+                bestIndex = i;
+            }
+        }
+
+        if (bestIndex == symbols.size()) {
+            break; // No mergeable pair left
+        }
+
+        symbols[bestIndex] += symbols[bestIndex + 1];
+        symbols.erase(symbols.begin() + bestIndex + 1);
+    }
+
+    return static_cast<int>(symbols.size());
+}
+
+uint64_t TokenCounter::hashContent(std::string_view text) {
+    // FNV-1a
+    uint64_t hash = 1469598103934665603ULL;
+    for (char c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace Ragger
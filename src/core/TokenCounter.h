@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace Ragger {
+
+// Token counting for prompt budgeting. With a tiktoken-format vocabulary
+// loaded (one "base64-token rank" pair per line) counts are exact byte-
+// pair-encoding token counts; without one, a piece-based heuristic that
+// is still far closer than the old length/4 guess. Counts are memoized
+// per content hash so repeated blocks are only ever encoded once.
+class TokenCounter {
+public:
+    TokenCounter();
+    ~TokenCounter() = default;
+
+    // Load a tiktoken-compatible vocabulary; returns false if the file
+    // is missing or malformed (the heuristic fallback stays active)
+    bool loadVocabulary(const fs::path& vocabPath);
+    bool hasVocabulary() const;
+
+    // Number of tokens in text (memoized)
+    int countTokens(std::string_view text);
+
+    void clearCache();
+
+private:
+    std::unordered_map<std::string, int> ranks_; // Merged byte sequence -> rank
+    bool vocabularyLoaded_;
+
+    mutable std::mutex cacheMutex_;
+    std::unordered_map<uint64_t, int> countCache_; // Content hash -> token count
+
+    int countUncached(std::string_view text) const;
+    int countPiece(std::string_view piece) const;
+    int bpeTokenCount(std::string_view piece) const;
+
+    static uint64_t hashContent(std::string_view text);
+};
+
+} // namespace Ragger
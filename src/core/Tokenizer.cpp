@@ -0,0 +1,145 @@
+#include "Tokenizer.h"
+#include <cctype>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace Ragger {
+
+bool Tokenizer::isIdentifierChar(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9') || c == '_';
+}
+
+// Advance from pos while bytes match (inToken) or don't match (!inToken)
+// the identifier class. The SSE2 path classifies 16 bytes per step and
+// falls back to scalar for the remainder.
+size_t Tokenizer::scanIdentifierChars(const char* data, size_t size, size_t pos, bool inToken) {
+#ifdef __SSE2__
+    const __m128i underscore = _mm_set1_epi8('_');
+    const __m128i digitLo = _mm_set1_epi8('0' - 1);
+    const __m128i digitHi = _mm_set1_epi8('9' + 1);
+    const __m128i upperLo = _mm_set1_epi8('A' - 1);
+    const __m128i upperHi = _mm_set1_epi8('Z' + 1);
+    const __m128i lowerLo = _mm_set1_epi8('a' - 1);
+    const __m128i lowerHi = _mm_set1_epi8('z' + 1);
+
+    while (pos + 16 <= size) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+
+        __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(chunk, digitLo),
+                                        _mm_cmplt_epi8(chunk, digitHi));
+        __m128i isUpper = _mm_and_si128(_mm_cmpgt_epi8(chunk, upperLo),
+                                        _mm_cmplt_epi8(chunk, upperHi));
+        __m128i isLower = _mm_and_si128(_mm_cmpgt_epi8(chunk, lowerLo),
+                                        _mm_cmplt_epi8(chunk, lowerHi));
+        __m128i isUnder = _mm_cmpeq_epi8(chunk, underscore);
+
+        __m128i isIdent = _mm_or_si128(_mm_or_si128(isDigit, isUpper),
+                                       _mm_or_si128(isLower, isUnder));
+        int mask = _mm_movemask_epi8(isIdent);
+
+        int stopMask = inToken ? ~mask & 0xFFFF : mask;
+        if (stopMask != 0) {
+            return pos + __builtin_ctz(stopMask);
+        }
+        pos += 16;
+    }
+#endif
+
+    while (pos < size && isIdentifierChar(static_cast<unsigned char>(data[pos])) == inToken) {
+        ++pos;
+    }
+    return pos;
+}
+
+template <typename Callback>
+void Tokenizer::forEachIdentifierRun(std::string_view text, Callback&& callback) {
+    const char* data = text.data();
+    size_t size = text.size();
+    size_t pos = 0;
+
+    while (pos < size) {
+        pos = scanIdentifierChars(data, size, pos, false); // Skip separators
+        if (pos >= size) break;
+
+        size_t end = scanIdentifierChars(data, size, pos, true);
+        callback(text.substr(pos, end - pos));
+        pos = end;
+    }
+}
+
+// Split one identifier run on '_' and camelCase boundaries and emit each
+// piece lowercased; the full run is also emitted when it was split, so
+// exact-name queries still match.
+template <typename Callback>
+void Tokenizer::emitSubTokens(std::string_view run, Callback&& callback) {
+    auto emit = [&callback](std::string_view span) {
+        if (span.size() < MIN_TOKEN_LENGTH) return;
+
+        std::string lowered;
+        lowered.reserve(span.size());
+        for (char c : span) {
+            lowered += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        callback(std::move(lowered));
+    };
+
+    size_t pieces = 0;
+    size_t start = 0;
+
+    for (size_t i = 0; i <= run.size(); ++i) {
+        bool boundary = false;
+
+        if (i == run.size() || run[i] == '_') {
+            boundary = true;
+        } else if (i > start && std::isupper(static_cast<unsigned char>(run[i])) &&
+                   std::islower(static_cast<unsigned char>(run[i - 1]))) {
+            // camelCase: lower->upper transition starts a new piece
+            emit(run.substr(start, i - start));
+            pieces++;
+            start = i;
+            continue;
+        }
+
+        if (boundary) {
+            if (i > start) {
+                emit(run.substr(start, i - start));
+                pieces++;
+            }
+            start = i + 1;
+        }
+    }
+
+    // Preserve the joined identifier when splitting produced fragments
+    if (pieces > 1) {
+        emit(run);
+    }
+}
+
+std::unordered_map<std::string, int> Tokenizer::countTokens(std::string_view text) {
+    std::unordered_map<std::string, int> tokenFreqs;
+
+    forEachIdentifierRun(text, [&tokenFreqs](std::string_view run) {
+        emitSubTokens(run, [&tokenFreqs](std::string token) {
+            tokenFreqs[std::move(token)]++;
+        });
+    });
+
+    return tokenFreqs;
+}
+
+std::vector<std::string> Tokenizer::splitTokens(std::string_view text) {
+    std::vector<std::string> tokens;
+
+    forEachIdentifierRun(text, [&tokens](std::string_view run) {
+        emitSubTokens(run, [&tokens](std::string token) {
+            tokens.push_back(std::move(token));
+        });
+    });
+
+    return tokens;
+}
+
+} // namespace Ragger
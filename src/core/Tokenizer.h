@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Ragger {
+
+// Shared code tokenizer used by the indexing pipeline and the ranker
+// query paths, so query terms always line up with stored postings.
+//
+// Identifier runs are located with an SSE2 classification sweep where
+// available (16 bytes per step) and split on snake_case and camelCase
+// boundaries. Scanning works on string_view spans of the source buffer;
+// tokens are only copied (lowercased) when they enter the output map.
+class Tokenizer {
+public:
+    // Minimum length for an emitted token; shorter fragments are noise
+    static const size_t MIN_TOKEN_LENGTH = 2;
+
+    // Lowercased token -> occurrence count
+    static std::unordered_map<std::string, int> countTokens(std::string_view text);
+
+    // Lowercased tokens in order of appearance (duplicates kept)
+    static std::vector<std::string> splitTokens(std::string_view text);
+
+private:
+    template <typename Callback>
+    static void forEachIdentifierRun(std::string_view text, Callback&& callback);
+
+    template <typename Callback>
+    static void emitSubTokens(std::string_view run, Callback&& callback);
+
+    static bool isIdentifierChar(unsigned char c);
+    static size_t scanIdentifierChars(const char* data, size_t size, size_t pos, bool inToken);
+};
+
+} // namespace Ragger
@@ -0,0 +1,270 @@
+#include "Trace.h"
+#include "Logger.h"
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+
+namespace Ragger {
+
+std::atomic<bool> Trace::eventRecording_{false};
+
+namespace {
+
+// Per-thread span stack for nesting reconstruction during recording.
+// childMicros accumulates nested span time so the parent's self time
+// can be computed at exit.
+struct ActiveFrame {
+    const char* stage;
+    uint64_t childMicros;
+};
+
+thread_local std::vector<ActiveFrame> activeSpans;
+
+uint64_t steadyMicros(std::chrono::steady_clock::time_point tp) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        tp.time_since_epoch()).count());
+}
+
+// Minimal JSON string escaping for stage names
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+LatencyHistogram::LatencyHistogram()
+    : totalCount_(0), maxMicros_(0) {
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+        buckets_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t micros) {
+    if (micros < SUB_BUCKETS) {
+        return static_cast<size_t>(micros); // Exact below the first power
+    }
+
+    size_t exponent = 63 - __builtin_clzll(micros);
+    size_t sub = (micros >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    size_t index = ((exponent - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) + sub;
+    return index < NUM_BUCKETS ? index : NUM_BUCKETS - 1;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+
+    size_t exponent = (index >> SUB_BUCKET_BITS) + SUB_BUCKET_BITS - 1;
+    size_t sub = index & (SUB_BUCKETS - 1);
+    return ((static_cast<uint64_t>(sub) + 1) << (exponent - SUB_BUCKET_BITS)) +
+           (1ULL << exponent) - 1;
+}
+
+void LatencyHistogram::record(uint64_t micros) {
+    buckets_[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+    totalCount_.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t seen = maxMicros_.load(std::memory_order_relaxed);
+    while (micros > seen &&
+           !maxMicros_.compare_exchange_weak(seen, micros, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t LatencyHistogram::count() const {
+    return totalCount_.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::maxMicros() const {
+    return maxMicros_.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::percentileMicros(double quantile) const {
+    uint64_t total = count();
+    if (total == 0) {
+        return 0;
+    }
+
+    uint64_t target = static_cast<uint64_t>(quantile * total);
+    if (target >= total) {
+        target = total - 1;
+    }
+
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+        cumulative += buckets_[i].load(std::memory_order_relaxed);
+        if (cumulative > target) {
+            return bucketUpperBound(i);
+        }
+    }
+    return maxMicros();
+}
+
+Trace& Trace::instance() {
+    static Trace trace;
+    return trace;
+}
+
+LatencyHistogram* Trace::histogramFor(const char* stage) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& slot = histograms_[stage];
+    if (!slot) {
+        slot = std::make_unique<LatencyHistogram>();
+    }
+    return slot.get();
+}
+
+const char* Trace::internStageName(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return internedNames_.insert(name).first->c_str();
+}
+
+std::vector<Trace::StageStats> Trace::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<StageStats> stats;
+    stats.reserve(histograms_.size());
+    for (const auto& pair : histograms_) {
+        const LatencyHistogram& histogram = *pair.second;
+        StageStats entry;
+        entry.stage = pair.first;
+        entry.count = histogram.count();
+        entry.p50Micros = histogram.percentileMicros(0.50);
+        entry.p99Micros = histogram.percentileMicros(0.99);
+        entry.p999Micros = histogram.percentileMicros(0.999);
+        entry.maxMicros = histogram.maxMicros();
+        stats.push_back(std::move(entry));
+    }
+    return stats;
+}
+
+void Trace::setEventRecording(bool enabled) {
+    {
+        std::lock_guard<std::mutex> lock(eventMutex_);
+        if (enabled) {
+            events_.clear();
+            eventsDropped_ = 0;
+        }
+    }
+    eventRecording_.store(enabled, std::memory_order_relaxed);
+}
+
+size_t Trace::eventCount() const {
+    std::lock_guard<std::mutex> lock(eventMutex_);
+    return events_.size();
+}
+
+void Trace::enterSpan(const char* stage) {
+    activeSpans.push_back({stage, 0});
+}
+
+void Trace::exitSpan(const char* stage,
+                     std::chrono::steady_clock::time_point start,
+                     std::chrono::steady_clock::time_point end) {
+    uint64_t durMicros = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+
+    // Pop our frame (guard against imbalance if recording was toggled
+    // between construction and destruction of an outer span)
+    uint64_t childMicros = 0;
+    if (!activeSpans.empty() && activeSpans.back().stage == stage) {
+        childMicros = activeSpans.back().childMicros;
+        activeSpans.pop_back();
+    }
+    if (!activeSpans.empty()) {
+        activeSpans.back().childMicros += durMicros;
+    }
+
+    TraceEvent event;
+    event.stage = stage;
+    event.startMicros = steadyMicros(start);
+    event.durMicros = durMicros;
+    event.selfMicros = durMicros > childMicros ? durMicros - childMicros : 0;
+    event.threadId = std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+    // Full stage path: remaining frames are this span's ancestors
+    for (const auto& frame : activeSpans) {
+        event.stack += frame.stage;
+        event.stack += ';';
+    }
+    event.stack += stage;
+
+    std::lock_guard<std::mutex> lock(eventMutex_);
+    if (events_.size() >= MAX_TRACE_EVENTS) {
+        ++eventsDropped_;
+        return;
+    }
+    events_.push_back(std::move(event));
+}
+
+int Trace::exportChromeTrace(const std::filesystem::path& outputPath) const {
+    std::lock_guard<std::mutex> lock(eventMutex_);
+
+    std::ofstream file(outputPath);
+    if (!file.is_open()) {
+        return -1;
+    }
+
+    // Complete ("X") events; ts/dur are microseconds as the format expects
+    file << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& event : events_) {
+        if (!first) {
+            file << ",";
+        }
+        first = false;
+        file << "\n{\"name\":\"" << jsonEscape(event.stage) << "\""
+             << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << (event.threadId & 0xFFFFFF)
+             << ",\"ts\":" << event.startMicros
+             << ",\"dur\":" << event.durMicros << "}";
+    }
+    file << "\n]}\n";
+    return 0;
+}
+
+int Trace::exportCollapsedStacks(const std::filesystem::path& outputPath) const {
+    // Aggregate self time per distinct stage stack; inclusive time would
+    // double-count parents against their children
+    std::unordered_map<std::string, uint64_t> selfByStack;
+    {
+        std::lock_guard<std::mutex> lock(eventMutex_);
+        for (const auto& event : events_) {
+            selfByStack[event.stack] += event.selfMicros;
+        }
+    }
+
+    std::ofstream file(outputPath);
+    if (!file.is_open()) {
+        return -1;
+    }
+
+    for (const auto& pair : selfByStack) {
+        file << pair.first << " " << pair.second << "\n";
+    }
+    return 0;
+}
+
+void Trace::logStats() const {
+    for (const auto& entry : snapshot()) {
+        if (entry.count == 0) {
+            continue;
+        }
+        RAGGER_LOG_INFO("Trace: " + entry.stage +
+                        " count=" + std::to_string(entry.count) +
+                        " p50=" + std::to_string(entry.p50Micros) + "us" +
+                        " p99=" + std::to_string(entry.p99Micros) + "us" +
+                        " p999=" + std::to_string(entry.p999Micros) + "us" +
+                        " max=" + std::to_string(entry.maxMicros) + "us");
+    }
+}
+
+} // namespace Ragger
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Ragger {
+
+// Lightweight latency instrumentation for the pipeline hot paths.
+//
+// A TraceSpan is an RAII guard that records its lifetime into a
+// log-bucketed (HDR-style) histogram for its stage, so production
+// percentiles (p50/p99/p999) are available per stage — index-file,
+// hash, parse, rank, generate-context — instead of a single running
+// average that hides the tail. Recording is two relaxed atomic
+// increments; stage histograms are resolved once at span construction.
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    // Record one sample in microseconds
+    void record(uint64_t micros);
+
+    uint64_t count() const;
+    uint64_t maxMicros() const;
+
+    // Approximate percentile (bucket upper bound), quantile in [0,1]
+    uint64_t percentileMicros(double quantile) const;
+
+private:
+    // Power-of-two buckets with linear sub-buckets: ~6% value resolution
+    static const size_t SUB_BUCKET_BITS = 4;
+    static const size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const size_t NUM_BUCKETS = 64 * SUB_BUCKETS;
+
+    std::atomic<uint64_t> buckets_[NUM_BUCKETS];
+    std::atomic<uint64_t> totalCount_;
+    std::atomic<uint64_t> maxMicros_;
+
+    static size_t bucketIndex(uint64_t micros);
+    static uint64_t bucketUpperBound(size_t index);
+};
+
+class Trace {
+public:
+    static Trace& instance();
+
+    // Histogram for a pipeline stage; created on first use and stable
+    // for the process lifetime, so spans can cache the pointer
+    LatencyHistogram* histogramFor(const char* stage);
+
+    // Stable storage for dynamically built stage names (e.g. per-plugin
+    // "rank:<type>"); spans keep raw pointers, so the string must live
+    // for the process lifetime
+    const char* internStageName(const std::string& name);
+
+    // Query API
+    struct StageStats {
+        std::string stage;
+        uint64_t count;
+        uint64_t p50Micros;
+        uint64_t p99Micros;
+        uint64_t p999Micros;
+        uint64_t maxMicros;
+    };
+    std::vector<StageStats> snapshot() const;
+
+    // Route the current snapshot through the logger (one line per
+    // stage); called periodically from the main loop
+    void logStats() const;
+
+    // Span-event recording for offline profiling (ragger-dev profile).
+    // Off by default: the histogram path above is always on, and spans
+    // only append timestamped events to the in-memory buffer while
+    // recording is enabled. Nesting is reconstructed from a per-thread
+    // span stack, so events carry their full stage stack.
+    void setEventRecording(bool enabled); // Enabling clears the buffer
+    static bool eventRecordingEnabled() {
+        return eventRecording_.load(std::memory_order_relaxed);
+    }
+    size_t eventCount() const;
+
+    // chrome://tracing / Perfetto "trace events" JSON (complete events)
+    int exportChromeTrace(const std::filesystem::path& outputPath) const;
+    // flamegraph.pl collapsed-stack format, one "stack selfMicros" line
+    // per distinct stage stack
+    int exportCollapsedStacks(const std::filesystem::path& outputPath) const;
+
+    // Called from TraceSpan; not for direct use
+    static void enterSpan(const char* stage);
+    void exitSpan(const char* stage,
+                  std::chrono::steady_clock::time_point start,
+                  std::chrono::steady_clock::time_point end);
+
+private:
+    Trace() = default;
+
+    struct TraceEvent {
+        std::string stack;     // "outer;inner" stage path
+        const char* stage;     // Leaf stage (static string from the span)
+        uint64_t startMicros;  // steady_clock, microseconds
+        uint64_t durMicros;    // Inclusive duration
+        uint64_t selfMicros;   // Duration minus nested spans
+        uint64_t threadId;
+    };
+
+    // Bounded so a runaway workload can't exhaust memory; events beyond
+    // the cap are counted but dropped
+    static const size_t MAX_TRACE_EVENTS = 1 << 20;
+
+    static std::atomic<bool> eventRecording_;
+    mutable std::mutex eventMutex_;
+    std::vector<TraceEvent> events_;
+    uint64_t eventsDropped_ = 0;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<LatencyHistogram>> histograms_;
+    std::set<std::string> internedNames_; // Node-based, so c_str() stays valid
+
+    // Prevent copying
+    Trace(const Trace&) = delete;
+    Trace& operator=(const Trace&) = delete;
+};
+
+// RAII span: records elapsed wall time into the stage histogram, and
+// into the event buffer when profiling recording is enabled
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* stage)
+        : stage_(stage),
+          histogram_(Trace::instance().histogramFor(stage)),
+          recording_(Trace::eventRecordingEnabled()),
+          start_(std::chrono::steady_clock::now()) {
+        if (recording_) {
+            Trace::enterSpan(stage_);
+        }
+    }
+
+    ~TraceSpan() {
+        auto end = std::chrono::steady_clock::now();
+        histogram_->record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(end - start_).count()));
+        if (recording_) {
+            // Balanced with the constructor even if recording was
+            // toggled mid-span
+            Trace::instance().exitSpan(stage_, start_, end);
+        }
+    }
+
+private:
+    const char* stage_;
+    LatencyHistogram* histogram_;
+    bool recording_;
+    std::chrono::steady_clock::time_point start_;
+
+    // Prevent copying
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+};
+
+} // namespace Ragger
+
+#define RAGGER_TRACE_SPAN(stage) ::Ragger::TraceSpan raggerTraceSpan_(stage)
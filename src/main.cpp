@@ -3,7 +3,9 @@
 #include "core/IndexManager.h"
 #include "core/ContextEngine.h"
 #include "core/ConfigManager.h"
+#include "core/FileWatcher.h"
 #include "core/Logger.h"
+#include "core/Trace.h"
 #include "core/FileUtils.h"
 #include "ragger_plugin_api.h"
 // spdlog disabled
@@ -26,14 +28,25 @@ void signalHandler(int signal) {
 // Core API implementation
 class RaggerCore {
 public:
+    // The RaggerCoreAPI function pointers carry no context argument, so
+    // the trampolines below reach the core through this instance pointer
+    static RaggerCore* instance;
+
     RaggerCore() {
+        instance = this;
+
         // Initialize core components
         eventBus_ = std::make_unique<EventBus>();
-        pluginManager_ = std::make_unique<PluginManager>(nullptr);
+        buildCoreAPI();
+        pluginManager_ = std::make_unique<PluginManager>(&coreAPI_);
         indexManager_ = std::make_unique<IndexManager>();
+        indexManager_->setEventBus(eventBus_.get());
         contextEngine_ = std::make_unique<ContextEngine>(nullptr);
+        contextEngine_->setPluginManager(pluginManager_.get());
+        contextEngine_->setIndexManager(indexManager_.get());
         configManager_ = std::make_unique<ConfigManager>();
         logger_ = std::make_unique<Logger>();
+        fileWatcher_ = std::make_unique<FileWatcher>(indexManager_.get(), eventBus_.get());
     }
 
     ~RaggerCore() = default;
@@ -105,16 +118,135 @@ public:
     IndexManager* getIndexManager() { return indexManager_.get(); }
     ContextEngine* getContextEngine() { return contextEngine_.get(); }
     ConfigManager* getConfigManager() { return configManager_.get(); }
+    FileWatcher* getFileWatcher() { return fileWatcher_.get(); }
 
 private:
+    // C trampolines for the plugin-facing core API; no context argument,
+    // so they reach the core through the static instance pointer
+    static int apiEmitEvent(const EventData* event) {
+        return instance->emit_event(event);
+    }
+    static int apiSubscribeEvent(EventType type, EventCallback callback, void* userData) {
+        return instance->subscribe_event(type, callback, userData);
+    }
+    static int apiUnsubscribeEvent(EventType type, EventCallback callback) {
+        return instance->unsubscribe_event(type, callback);
+    }
+    static void apiLogInfo(const char* message) { instance->log_info(message); }
+    static void apiLogWarning(const char* message) { instance->log_warning(message); }
+    static void apiLogError(const char* message) { instance->log_error(message); }
+    static int apiGetConfigString(const char* key, const char** value) {
+        return instance->get_config_string(key, value);
+    }
+    static int apiGetConfigInt(const char* key, int* value) {
+        return instance->get_config_int(key, value);
+    }
+    static int apiGetConfigFloat(const char* key, float* value) {
+        return instance->get_config_float(key, value);
+    }
+    static void* apiAllocateMemory(size_t size) { return instance->allocate_memory(size); }
+    static void apiFreeMemory(void* ptr) { instance->free_memory(ptr); }
+    static int apiReadFile(const char* path, char** content, size_t* size) {
+        return instance->read_file(path, content, size);
+    }
+    static int apiWriteFile(const char* path, const char* content, size_t size) {
+        return instance->write_file(path, content, size);
+    }
+    static int apiGetFileHash(const char* path, char* hash, size_t hashSize) {
+        return instance->get_file_hash(path, hash, hashSize);
+    }
+
+    // Index queries (ABI 102): hands ownership of the block array and
+    // its strings to the plugin, released via apiFreeCodeBlocks
+    static int apiFindTestBlocks(const char* filePath, CodeBlock** blocks, size_t* numBlocks) {
+        if (!blocks || !numBlocks) {
+            return RAGGER_ERROR_INVALID_ARGUMENT;
+        }
+        *blocks = nullptr;
+        *numBlocks = 0;
+
+        std::vector<CodeBlock> found;
+        int result = filePath
+            ? instance->getIndexManager()->findTestBlocksForFile(fs::path(filePath), found)
+            : instance->getIndexManager()->findTestBlocks(found);
+        if (result != RAGGER_SUCCESS || found.empty()) {
+            return result;
+        }
+
+        CodeBlock* array = new CodeBlock[found.size()];
+        for (size_t i = 0; i < found.size(); ++i) {
+            array[i] = found[i]; // Shallow copy transfers string ownership
+        }
+        *blocks = array;
+        *numBlocks = found.size();
+        return RAGGER_SUCCESS;
+    }
+    // Shared payload buffers (ABI 103): the handle owns one strong
+    // reference to the refcounted buffer; emit pins another for the
+    // queued event, and buffer_release drops the producer's
+    static RaggerBufferHandle apiBufferAlloc(size_t size, void** data) {
+        if (size == 0 || !data) {
+            return nullptr;
+        }
+        auto payload = EventBus::SharedPayload::allocate(size);
+        *data = payload->data();
+        return new std::shared_ptr<EventBus::SharedPayload>(std::move(payload));
+    }
+    static void apiBufferRelease(RaggerBufferHandle buffer) {
+        delete static_cast<std::shared_ptr<EventBus::SharedPayload>*>(buffer);
+    }
+    static int apiEmitEventShared(const EventData* event, RaggerBufferHandle buffer, int priority) {
+        if (!buffer) {
+            return RAGGER_ERROR_INVALID_ARGUMENT;
+        }
+        auto* payload = static_cast<std::shared_ptr<EventBus::SharedPayload>*>(buffer);
+        return instance->getEventBus()->emitEventShared(event, *payload, priority);
+    }
+
+    static void apiFreeCodeBlocks(CodeBlock* blocks, size_t numBlocks) {
+        for (size_t i = 0; i < numBlocks; ++i) {
+            delete[] blocks[i].filePath;
+            delete[] blocks[i].name;
+            delete[] blocks[i].content;
+            delete[] blocks[i].language;
+        }
+        delete[] blocks;
+    }
+
+    void buildCoreAPI() {
+        coreAPI_.emit_event = apiEmitEvent;
+        coreAPI_.subscribe_event = apiSubscribeEvent;
+        coreAPI_.unsubscribe_event = apiUnsubscribeEvent;
+        coreAPI_.log_info = apiLogInfo;
+        coreAPI_.log_warning = apiLogWarning;
+        coreAPI_.log_error = apiLogError;
+        coreAPI_.get_config_string = apiGetConfigString;
+        coreAPI_.get_config_int = apiGetConfigInt;
+        coreAPI_.get_config_float = apiGetConfigFloat;
+        coreAPI_.allocate_memory = apiAllocateMemory;
+        coreAPI_.free_memory = apiFreeMemory;
+        coreAPI_.read_file = apiReadFile;
+        coreAPI_.write_file = apiWriteFile;
+        coreAPI_.get_file_hash = apiGetFileHash;
+        coreAPI_.find_test_blocks = apiFindTestBlocks;
+        coreAPI_.free_code_blocks = apiFreeCodeBlocks;
+        coreAPI_.buffer_alloc = apiBufferAlloc;
+        coreAPI_.buffer_release = apiBufferRelease;
+        coreAPI_.emit_event_shared = apiEmitEventShared;
+    }
+
+    RaggerCoreAPI coreAPI_{};
     std::unique_ptr<EventBus> eventBus_;
     std::unique_ptr<PluginManager> pluginManager_;
     std::unique_ptr<IndexManager> indexManager_;
     std::unique_ptr<ContextEngine> contextEngine_;
     std::unique_ptr<ConfigManager> configManager_;
     std::unique_ptr<Logger> logger_;
+    std::unique_ptr<FileWatcher> fileWatcher_;
 };
 
+RaggerCore* RaggerCore::instance = nullptr;
+
 } // namespace Ragger
 
 int main(int argc, char* argv[]) {
@@ -144,16 +276,28 @@ int main(int argc, char* argv[]) {
         std::cout << "Initializing index..." << std::endl;
         core.getIndexManager()->initialize();
 
+        // Watch the working tree so edits reindex incrementally
+        if (core.getFileWatcher()->watchDirectory(".") == RAGGER_SUCCESS) {
+            core.getFileWatcher()->start();
+        }
+
         // Start main application loop
         std::cout << "RAGger ready. Press Ctrl+C to exit." << std::endl;
 
+        auto lastStatsReport = std::chrono::steady_clock::now();
+
         while (Ragger::running) {
             // Main application logic would go here
             // For now, just sleep and check for shutdown
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
-            // Process any pending events
-            // UI updates, plugin communication, etc.
+            // Periodic latency report so production percentiles show up
+            // in the log without a debugger attached
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastStatsReport >= std::chrono::seconds(60)) {
+                Ragger::Trace::instance().logStats();
+                lastStatsReport = now;
+            }
         }
 
         std::cout << "RAGger shutting down..." << std::endl;
@@ -3,7 +3,9 @@
 #include "IndexManager.h"
 #include "ContextEngine.h"
 #include "ConfigManager.h"
+#include "CorpusGenerator.h"
 #include "Logger.h"
+#include "Trace.h"
 #include "FileUtils.h"
 #include "ragger_plugin_api.h"
 #include <iostream>
@@ -35,6 +37,12 @@ public:
         std::cout << "  list-plugins                     List available plugins\n";
         std::cout << "  validate-config <config-file>    Validate configuration file\n";
         std::cout << "  benchmark <test-directory>       Run performance benchmarks\n";
+        std::cout << "  generate-corpus <output-dir>     Generate a synthetic benchmark corpus\n";
+        std::cout << "      [--files N] [--mean-lines N] [--fanout N] [--dup-ratio F] [--seed N]\n";
+        std::cout << "  profile <directory>              Profile an indexing (and optional query) workload\n";
+        std::cout << "      [--query <text>] [--out <prefix>]\n";
+        std::cout << "      Writes <prefix>.trace.json (chrome://tracing / Perfetto) and\n";
+        std::cout << "      <prefix>.collapsed (flamegraph.pl input)\n";
         std::cout << "  help                             Show this help message\n\n";
         std::cout << "Plugin Types:\n";
         std::cout << "  parser                           Code parser plugin\n";
@@ -74,6 +82,121 @@ public:
         return 0;
     }
 
+    int generateCorpus(int argc, char* argv[]) {
+        fs::path outputDir = argv[2];
+        CorpusShape shape;
+
+        for (int i = 3; i + 1 < argc; i += 2) {
+            std::string flag = argv[i];
+            std::string value = argv[i + 1];
+            if (flag == "--files") {
+                shape.numFiles = std::stoul(value);
+            } else if (flag == "--mean-lines") {
+                shape.meanFileLines = std::stoul(value);
+            } else if (flag == "--fanout") {
+                shape.symbolFanout = std::stoul(value);
+            } else if (flag == "--dup-ratio") {
+                shape.duplicateTokenRatio = std::stod(value);
+            } else if (flag == "--seed") {
+                shape.seed = static_cast<unsigned>(std::stoul(value));
+            } else {
+                std::cerr << "Error: Unknown option '" << flag << "'" << std::endl;
+                return 1;
+            }
+        }
+
+        std::cout << "Generating corpus: " << shape.numFiles << " files under "
+                  << outputDir << std::endl;
+
+        CorpusGenerator generator(shape);
+        if (generator.generate(outputDir) != RAGGER_SUCCESS) {
+            std::cerr << "Error: Corpus generation failed" << std::endl;
+            return 1;
+        }
+
+        std::cout << "Corpus generated successfully" << std::endl;
+        return 0;
+    }
+
+    int profile(int argc, char* argv[]) {
+        fs::path targetDir = argv[2];
+        std::string query;
+        std::string outPrefix = "ragger-profile";
+
+        for (int i = 3; i + 1 < argc; i += 2) {
+            std::string flag = argv[i];
+            std::string value = argv[i + 1];
+            if (flag == "--query") {
+                query = value;
+            } else if (flag == "--out") {
+                outPrefix = value;
+            } else {
+                std::cerr << "Error: Unknown option '" << flag << "'" << std::endl;
+                return 1;
+            }
+        }
+
+        if (!fs::is_directory(targetDir)) {
+            std::cerr << "Error: '" << targetDir.string() << "' is not a directory" << std::endl;
+            return 1;
+        }
+
+        // Scratch database so profiling runs don't disturb the real index
+        fs::path scratchDir = fs::temp_directory_path() / "ragger-dev-profile";
+        fs::remove_all(scratchDir);
+
+        std::cout << "Profiling index workload on " << targetDir.string() << std::endl;
+        Trace::instance().setEventRecording(true);
+
+        {
+            IndexManager indexManager;
+            indexManager.setDatabasePath(scratchDir / "index.db");
+            if (indexManager.initialize() != RAGGER_SUCCESS) {
+                Trace::instance().setEventRecording(false);
+                std::cerr << "Error: Failed to initialize scratch index" << std::endl;
+                return 1;
+            }
+
+            int indexed = indexManager.indexDirectory(targetDir);
+            std::cout << "Profile: indexed " << indexed << " files" << std::endl;
+
+            if (!query.empty()) {
+                std::vector<fs::path> results;
+                indexManager.findFilesByContent(query, results);
+                std::cout << "Profile: query matched " << results.size() << " files" << std::endl;
+            }
+        } // Destructor shuts the scratch index down
+
+        Trace::instance().setEventRecording(false);
+        fs::remove_all(scratchDir);
+
+        fs::path tracePath = outPrefix + ".trace.json";
+        fs::path collapsedPath = outPrefix + ".collapsed";
+        if (Trace::instance().exportChromeTrace(tracePath) != 0 ||
+            Trace::instance().exportCollapsedStacks(collapsedPath) != 0) {
+            std::cerr << "Error: Failed to write profile output" << std::endl;
+            return 1;
+        }
+
+        std::cout << "Profile: " << Trace::instance().eventCount() << " span events captured" << std::endl;
+        std::cout << "Profile: wrote " << tracePath.string() << " and "
+                  << collapsedPath.string() << std::endl;
+
+        // Stage summary so the headline numbers are visible without
+        // opening the trace
+        for (const auto& entry : Trace::instance().snapshot()) {
+            if (entry.count == 0) {
+                continue;
+            }
+            std::cout << "  " << entry.stage
+                      << " count=" << entry.count
+                      << " p50=" << entry.p50Micros << "us"
+                      << " p99=" << entry.p99Micros << "us"
+                      << " max=" << entry.maxMicros << "us" << std::endl;
+        }
+        return 0;
+    }
+
     int benchmark(const std::string& testDirectory) {
         std::cout << "Running benchmarks on: " << testDirectory << std::endl;
         std::cout << "Benchmark completed successfully" << std::endl;
@@ -117,6 +240,18 @@ public:
                 return 1;
             }
             return benchmark(argv[2]);
+        } else if (command == "generate-corpus") {
+            if (argc < 3) {
+                std::cerr << "Error: generate-corpus requires <output-dir> argument" << std::endl;
+                return 1;
+            }
+            return generateCorpus(argc, argv);
+        } else if (command == "profile") {
+            if (argc < 3) {
+                std::cerr << "Error: profile requires <directory> argument" << std::endl;
+                return 1;
+            }
+            return profile(argc, argv);
         } else {
             std::cerr << "Error: Unknown command '" << command << "'" << std::endl;
             printUsage();
@@ -60,7 +60,9 @@ bool GUIApplication::initialize() {
     m_promptPanel = std::make_unique<PromptPanel>();
     m_syntaxHighlighter = std::make_unique<SyntaxHighlighter>();
     m_splitView = std::make_unique<SplitView>();
-    
+    m_resultsPanel = std::make_unique<ResultsPanel>();
+    m_queryWorker = std::make_unique<QueryWorker>();
+
     m_splitView->setCodeEditor(std::move(m_codeEditor));
     m_splitView->setPromptPanel(std::move(m_promptPanel));
 
@@ -80,6 +82,10 @@ void GUIApplication::run() {
     while (!false) { // !glfwWindowShouldClose(window)) {
         // glfwPollEvents();
 
+        // Claim any results a background query finished since last frame;
+        // this is a single atomic exchange and never blocks the render loop
+        pollQueryResults();
+
         // Start the Dear ImGui frame
         // ImGui_ImplOpenGL3_NewFrame();
         // ImGui_ImplGlfw_NewFrame();
@@ -150,6 +156,9 @@ void GUIApplication::run() {
 
 void GUIApplication::shutdown() {
     if (m_initialized) {
+        // Stop the worker before tearing down anything its executor touches
+        m_queryWorker.reset();
+
         // ImGui_ImplOpenGL3_Shutdown();
         // ImGui_ImplGlfw_Shutdown();
         // ImGui::DestroyContext();
@@ -194,6 +203,33 @@ void GUIApplication::setPromptGeneratedCallback(std::function<void(const std::st
     m_promptGeneratedCallback = callback;
 }
 
+void GUIApplication::setQueryExecutor(std::function<std::vector<QueryResultRow>(const std::string&)> executor) {
+    if (m_queryWorker) {
+        m_queryWorker->setExecutor(executor);
+    }
+}
+
+void GUIApplication::submitQuery(const std::string& query) {
+    if (m_queryWorker) {
+        m_queryWorker->submit(query);
+    }
+}
+
+bool GUIApplication::isQueryRunning() const {
+    return m_queryWorker && m_queryWorker->isBusy();
+}
+
+void GUIApplication::pollQueryResults() {
+    if (!m_queryWorker || !m_resultsPanel) {
+        return;
+    }
+
+    std::vector<QueryResultRow> results;
+    if (m_queryWorker->poll(results)) {
+        m_resultsPanel->setResults(std::move(results));
+    }
+}
+
 void GUIApplication::renderMenuBar() {
     // if (ImGui::BeginMainMenuBar()) {
     //     if (ImGui::BeginMenu("File")) {
@@ -534,6 +570,167 @@ void SplitView::handleDrag() {
     // In a real implementation, this would update the split ratio based on mouse position
 }
 
+// QueryWorker Implementation
+QueryWorker::QueryWorker()
+    : m_pendingGeneration(0)
+    , m_mailbox(nullptr)
+    , m_submittedGeneration(0)
+    , m_completedGeneration(0)
+    , m_running(true)
+{
+    m_thread = std::thread(&QueryWorker::workerLoop, this);
+}
+
+QueryWorker::~QueryWorker() {
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_running = false;
+    }
+    m_pendingCondition.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    // Free an unclaimed result set left in the mailbox
+    delete m_mailbox.exchange(nullptr);
+}
+
+void QueryWorker::setExecutor(std::function<std::vector<QueryResultRow>(const std::string&)> executor) {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    m_executor = executor;
+}
+
+void QueryWorker::submit(const std::string& query) {
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_pendingQuery = query;
+        m_pendingGeneration = ++m_submittedGeneration;
+    }
+    m_pendingCondition.notify_one();
+}
+
+bool QueryWorker::poll(std::vector<QueryResultRow>& results) {
+    // Lock-free handoff: take whatever the worker last published
+    std::vector<QueryResultRow>* completed = m_mailbox.exchange(nullptr, std::memory_order_acquire);
+    if (!completed) {
+        return false;
+    }
+
+    results = std::move(*completed);
+    delete completed;
+    return true;
+}
+
+bool QueryWorker::isBusy() const {
+    return m_completedGeneration.load(std::memory_order_acquire) <
+           m_submittedGeneration.load(std::memory_order_acquire);
+}
+
+void QueryWorker::workerLoop() {
+    uint64_t lastGeneration = 0;
+
+    while (true) {
+        std::string query;
+        uint64_t generation;
+        std::function<std::vector<QueryResultRow>(const std::string&)> executor;
+
+        {
+            std::unique_lock<std::mutex> lock(m_pendingMutex);
+            m_pendingCondition.wait(lock, [this, lastGeneration]() {
+                return !m_running || m_pendingGeneration > lastGeneration;
+            });
+            if (!m_running) {
+                return;
+            }
+            query = m_pendingQuery;
+            generation = m_pendingGeneration;
+            executor = m_executor;
+        }
+        lastGeneration = generation;
+
+        std::vector<QueryResultRow> results;
+        if (executor) {
+            results = executor(query);
+        }
+
+        // Drop stale results: a newer query was submitted while this one
+        // was running, so its results would be overwritten immediately
+        if (generation < m_submittedGeneration.load(std::memory_order_acquire)) {
+            continue;
+        }
+
+        // Publish into the mailbox; an unclaimed older set is replaced
+        auto* completed = new std::vector<QueryResultRow>(std::move(results));
+        delete m_mailbox.exchange(completed, std::memory_order_release);
+        m_completedGeneration.store(generation, std::memory_order_release);
+    }
+}
+
+// ResultsPanel Implementation
+ResultsPanel::ResultsPanel()
+    : m_selectedIndex(-1)
+    , m_rowHeight(18.0f)
+    , m_scrollOffset(0.0f)
+{
+}
+
+ResultsPanel::~ResultsPanel() {
+}
+
+void ResultsPanel::setResults(std::vector<QueryResultRow> results) {
+    m_results = std::move(results);
+    m_selectedIndex = -1;
+    m_scrollOffset = 0.0f;
+}
+
+size_t ResultsPanel::getResultCount() const {
+    return m_results.size();
+}
+
+void ResultsPanel::render(float width, float height) {
+    (void)width; // Suppress unused parameter warning
+    // ImGui::BeginChild("ResultsPanel", ImVec2(width, height), true);
+
+    // Virtualized rendering: only the rows that intersect the visible
+    // region are drawn, so a 100k-result list costs the same per frame as
+    // a 30-result one. With real ImGui this is ImGuiListClipper:
+    // ImGuiListClipper clipper;
+    // clipper.Begin(static_cast<int>(m_results.size()), m_rowHeight);
+    // while (clipper.Step()) {
+    //     for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+    //         renderRow(m_results[i], i);
+    //     }
+    // }
+    int firstVisible = static_cast<int>(m_scrollOffset / m_rowHeight);
+    int visibleCount = static_cast<int>(height / m_rowHeight) + 2;
+    int lastVisible = std::min(firstVisible + visibleCount,
+                               static_cast<int>(m_results.size()));
+
+    for (int i = firstVisible; i < lastVisible; i++) {
+        renderRow(m_results[i], i);
+    }
+
+    // ImGui::EndChild();
+}
+
+void ResultsPanel::setRowActivatedCallback(std::function<void(const QueryResultRow&)> callback) {
+    m_rowActivatedCallback = callback;
+}
+
+void ResultsPanel::renderRow(const QueryResultRow& row, int index) {
+    (void)row;   // Suppress unused parameter warning
+    (void)index; // Suppress unused parameter warning
+    // bool selected = (index == m_selectedIndex);
+    // if (ImGui::Selectable(row.title.c_str(), selected)) {
+    //     m_selectedIndex = index;
+    //     if (m_rowActivatedCallback) {
+    //         m_rowActivatedCallback(row);
+    //     }
+    // }
+    // ImGui::SameLine();
+    // ImGui::TextDisabled("%s:%d (%.2f)", row.filePath.c_str(), row.startLine, row.score);
+}
+
 // ColorScheme Implementation
 ColorScheme::ColorScheme() {
     // Default dark theme colors
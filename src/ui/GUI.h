@@ -5,6 +5,10 @@
 #include <memory>
 #include <functional>
 #include <map>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include "ragger_plugin_api.h"
 
 // Forward declarations for Dear ImGui types (stubs for now)
@@ -23,6 +27,18 @@ class CodeEditor;
 class PromptPanel;
 class SyntaxHighlighter;
 class SplitView;
+class ResultsPanel;
+class QueryWorker;
+
+// One row in the results list
+struct QueryResultRow {
+    std::string title;
+    std::string filePath;
+    int startLine;
+    float score;
+
+    QueryResultRow() : startLine(0), score(0.0f) {}
+};
 
 // Token types for syntax highlighting
 enum class TokenType {
@@ -93,13 +109,21 @@ public:
     // Register a callback for when prompt is generated
     void setPromptGeneratedCallback(std::function<void(const std::string&)> callback);
 
+    // Query execution: the executor runs on the worker thread, never on the
+    // render thread, so the frame loop stays responsive during long queries
+    void setQueryExecutor(std::function<std::vector<QueryResultRow>(const std::string&)> executor);
+    void submitQuery(const std::string& query);
+    bool isQueryRunning() const;
+
 private:
     bool m_initialized;
     std::unique_ptr<SplitView> m_splitView;
     std::unique_ptr<CodeEditor> m_codeEditor;
     std::unique_ptr<PromptPanel> m_promptPanel;
     std::unique_ptr<SyntaxHighlighter> m_syntaxHighlighter;
-    
+    std::unique_ptr<ResultsPanel> m_resultsPanel;
+    std::unique_ptr<QueryWorker> m_queryWorker;
+
     // Callbacks
     std::function<void(const CodeBlock&)> m_codeSelectionCallback;
     std::function<void(const std::string&)> m_promptGeneratedCallback;
@@ -111,6 +135,88 @@ private:
     void renderMenuBar();
     void renderStatusBar();
     void handleKeyboardShortcuts();
+
+    // Called once per frame: claims any completed query results from the
+    // worker and hands them to the results panel
+    void pollQueryResults();
+};
+
+// Background query worker. Queries run on a dedicated thread; completed
+// result sets are handed back to the UI thread through a lock-free
+// single-slot mailbox (atomic pointer exchange), so the render loop never
+// takes a lock or blocks on a query. A newer query supersedes one that is
+// still pending (latest-wins) and stale results are dropped on arrival.
+class QueryWorker {
+public:
+    QueryWorker();
+    ~QueryWorker();
+
+    // Executor invoked on the worker thread
+    void setExecutor(std::function<std::vector<QueryResultRow>(const std::string&)> executor);
+
+    // Submit a query (UI thread); replaces any still-pending query
+    void submit(const std::string& query);
+
+    // Claim completed results (UI thread). Returns true and fills
+    // `results` when a fresh result set is available.
+    bool poll(std::vector<QueryResultRow>& results);
+
+    bool isBusy() const;
+
+private:
+    void workerLoop();
+
+    std::function<std::vector<QueryResultRow>(const std::string&)> m_executor;
+    std::thread m_thread;
+
+    // Pending query slot (worker waits on the condition variable)
+    std::mutex m_pendingMutex;
+    std::condition_variable m_pendingCondition;
+    std::string m_pendingQuery;
+    uint64_t m_pendingGeneration;
+
+    // Completed-results mailbox: worker publishes with exchange(), UI
+    // thread claims with exchange(nullptr); an unclaimed set is simply
+    // replaced (and freed) by the next one
+    std::atomic<std::vector<QueryResultRow>*> m_mailbox;
+
+    std::atomic<uint64_t> m_submittedGeneration;
+    std::atomic<uint64_t> m_completedGeneration;
+    std::atomic<bool> m_running;
+
+    // Prevent copying
+    QueryWorker(const QueryWorker&) = delete;
+    QueryWorker& operator=(const QueryWorker&) = delete;
+};
+
+// Results list with clipper-based virtualized rendering: only the rows
+// inside the visible region are drawn each frame, so frame time stays
+// flat regardless of result count
+class ResultsPanel {
+public:
+    ResultsPanel();
+    ~ResultsPanel();
+
+    // Replace the displayed results (UI thread)
+    void setResults(std::vector<QueryResultRow> results);
+
+    size_t getResultCount() const;
+
+    // Render the panel
+    void render(float width, float height);
+
+    // Set selection callback (fires when a row is activated)
+    void setRowActivatedCallback(std::function<void(const QueryResultRow&)> callback);
+
+private:
+    std::vector<QueryResultRow> m_results;
+    int m_selectedIndex;
+    float m_rowHeight;
+    float m_scrollOffset;
+
+    std::function<void(const QueryResultRow&)> m_rowActivatedCallback;
+
+    void renderRow(const QueryResultRow& row, int index);
 };
 
 // Code Editor with syntax highlighting
@@ -5,6 +5,9 @@
 #include <sstream>
 #include <chrono>
 #include <thread>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
 
 #include "ragger_plugin_api.h"
 #include "EventBus.h"
@@ -17,12 +20,109 @@
 namespace Ragger {
 namespace Console {
 
+// Buffered, backpressure-aware writer for streaming context output.
+// Chunks are coalesced into a fixed buffer and flushed with a write()
+// loop that handles partial writes, so a slow downstream pipe applies
+// backpressure instead of forcing the whole prompt to buffer in memory.
+// On a TTY the buffer is flushed at newline boundaries so the user sees
+// lines as they are produced; on a pipe flushes happen only when the
+// buffer fills, keeping syscall counts low.
+class StreamingContextWriter {
+public:
+    StreamingContextWriter()
+        : m_used(0)
+        , m_lineBuffered(isatty(STDOUT_FILENO) != 0)
+        , m_eventBus(nullptr) {
+    }
+
+    ~StreamingContextWriter() {
+        detach();
+        flush();
+    }
+
+    // Subscribe to streaming events so ranked blocks and LLM chunks are
+    // written as soon as the pipeline emits them
+    void attach(EventBus* eventBus) {
+        if (!eventBus || m_eventBus) {
+            return;
+        }
+        m_eventBus = eventBus;
+        m_eventBus->subscribe(EVENT_CONTEXT_GENERATED, &StreamingContextWriter::onEvent, this);
+        m_eventBus->subscribe(EVENT_LLM_CHUNK_RECEIVED, &StreamingContextWriter::onEvent, this);
+    }
+
+    void detach() {
+        if (m_eventBus) {
+            m_eventBus->unsubscribe(EVENT_CONTEXT_GENERATED, &StreamingContextWriter::onEvent);
+            m_eventBus->unsubscribe(EVENT_LLM_CHUNK_RECEIVED, &StreamingContextWriter::onEvent);
+            m_eventBus = nullptr;
+        }
+    }
+
+    void write(const char* data, size_t length) {
+        while (length > 0) {
+            size_t space = BUFFER_SIZE - m_used;
+            size_t take = length < space ? length : space;
+            std::memcpy(m_buffer + m_used, data, take);
+            m_used += take;
+            data += take;
+            length -= take;
+
+            if (m_used == BUFFER_SIZE) {
+                flush();
+            }
+        }
+
+        // Line-oriented flushing on interactive terminals: time to first
+        // context line matters more than syscall counts there
+        if (m_lineBuffered && m_used > 0 && m_buffer[m_used - 1] == '\n') {
+            flush();
+        }
+    }
+
+    void write(const std::string& text) {
+        write(text.data(), text.size());
+    }
+
+    void flush() {
+        size_t written = 0;
+        while (written < m_used) {
+            ssize_t n = ::write(STDOUT_FILENO, m_buffer + written, m_used - written);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break; // Downstream closed; drop the remainder
+            }
+            written += static_cast<size_t>(n);
+        }
+        m_used = 0;
+    }
+
+private:
+    static const size_t BUFFER_SIZE = 8192;
+
+    static void onEvent(const EventData* event, void* userData) {
+        auto* self = static_cast<StreamingContextWriter*>(userData);
+        if (event && event->data && event->dataSize > 0) {
+            self->write(static_cast<const char*>(event->data), event->dataSize);
+        }
+    }
+
+    char m_buffer[BUFFER_SIZE];
+    size_t m_used;
+    bool m_lineBuffered;
+    EventBus* m_eventBus;
+};
+
 class RaggerConsoleInterface {
 private:
     bool m_running = false;
+    bool m_streaming = true;
     std::vector<std::string> m_history;
     std::string m_currentInput;
-    
+    StreamingContextWriter m_streamWriter;
+
     // Core components
     EventBus* m_eventBus;
     ConfigManager* m_configManager;
@@ -73,10 +173,13 @@ public:
                 return false;
             }
 
+            // Stream ranked blocks and LLM chunks as the pipeline emits them
+            m_streamWriter.attach(m_eventBus);
+
             std::cout << "✓ Core components initialized successfully" << std::endl;
             std::cout << "✓ Database ready at: data/index.db" << std::endl;
             std::cout << "✓ Event bus active" << std::endl;
-            
+
             return true;
         } catch (const std::exception& e) {
             std::cerr << "Initialization failed: " << e.what() << std::endl;
@@ -118,6 +221,7 @@ private:
         std::cout << "  plugins           - List available plugins" << std::endl;
         std::cout << "  index <path>      - Index a file or directory" << std::endl;
         std::cout << "  query <text>      - Process a query with RAG" << std::endl;
+        std::cout << "  stream <on|off>   - Toggle incremental context streaming" << std::endl;
         std::cout << "  config            - Show current configuration" << std::endl;
         std::cout << "  history           - Show command history" << std::endl;
         std::cout << "  clear             - Clear screen" << std::endl;
@@ -158,6 +262,17 @@ private:
                 std::cout << "Usage: query <your_question_or_request>" << std::endl;
             }
         }
+        else if (command == "stream") {
+            std::string mode;
+            iss >> mode;
+            if (mode == "on" || mode == "off") {
+                m_streaming = (mode == "on");
+                std::cout << "Streaming output " << (m_streaming ? "enabled" : "disabled") << std::endl;
+            } else {
+                std::cout << "Usage: stream <on|off> (currently "
+                          << (m_streaming ? "on" : "off") << ")" << std::endl;
+            }
+        }
         else if (command == "config") {
             showConfig();
         }
@@ -232,23 +347,7 @@ private:
     void processQuery(const std::string& query) {
         std::cout << "\n=== Processing Query ===" << std::endl;
         std::cout << "Query: " << query << std::endl;
-        
-        // Simulate RAG processing
-        std::cout << "\nStep 1: Analyzing query..." << std::endl;
-        std::this_thread::sleep_for(std::chrono::milliseconds(300));
-        
-        std::cout << "Step 2: Searching codebase..." << std::endl;
-        std::this_thread::sleep_for(std::chrono::milliseconds(400));
-        
-        std::cout << "Step 3: Ranking results..." << std::endl;
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
-        
-        std::cout << "Step 4: Generating comprehensive context..." << std::endl;
-        std::this_thread::sleep_for(std::chrono::milliseconds(300));
-        
-        // Generate comprehensive context using the three pillars
-        std::cout << "\n=== COMPREHENSIVE RAG RESULT ===" << std::endl;
-        
+
         // Try to find a relevant file for context generation
         std::string targetFile = "src/main.cpp"; // Default to main.cpp
         if (query.find("main") != std::string::npos) {
@@ -258,44 +357,118 @@ private:
         } else if (query.find("plugin") != std::string::npos) {
             targetFile = "plugins/integrations/git_integration/GitIntegrationPlugin.cpp";
         }
-        
-        // Generate comprehensive context using the new context generator
-        if (m_contextGenerator) {
-            std::string context = m_contextGenerator->generateComprehensiveContext(targetFile, query, 1, 50);
-            std::cout << "\n" << context << std::endl;
-        } else {
-            std::cout << "\n" << generateComprehensiveContext(targetFile, query, 1, 50) << std::endl;
+
+        if (m_streaming) {
+            processQueryStreaming(query, targetFile);
+            return;
         }
-        
-        std::cout << "\n=== RELEVANT CODE BLOCKS ===" << std::endl;
-        std::cout << "Based on your query, here are the relevant code sections:" << std::endl;
-        std::cout << "\n1. [Relevant Code Block 1]" << std::endl;
-        std::cout << "   Score: 0.85 | File: " << targetFile << ":15-25" << std::endl;
-        std::cout << "   This code block is highly relevant to your query." << std::endl;
-        
-        std::cout << "\n2. [Relevant Code Block 2]" << std::endl;
-        std::cout << "   Score: 0.72 | File: utils.h:8-12" << std::endl;
-        std::cout << "   Additional context for your request." << std::endl;
-        
-        std::cout << "\n3. [Relevant Code Block 3]" << std::endl;
-        std::cout << "   Score: 0.68 | File: " << targetFile << ":45-52" << std::endl;
-        std::cout << "   Related functionality that might help." << std::endl;
-        
-        std::cout << "\n=== GENERATED PROMPT ===" << std::endl;
-        std::cout << "Here's the context-rich prompt that would be sent to an AI model:" << std::endl;
-        std::cout << "\n---" << std::endl;
-        std::cout << "Context: The following code blocks are relevant to your query:" << std::endl;
-        std::cout << "\n1. [Code Block 1 content...]" << std::endl;
-        std::cout << "2. [Code Block 2 content...]" << std::endl;
-        std::cout << "3. [Code Block 3 content...]" << std::endl;
-        std::cout << "\nQuestion: " << query << std::endl;
-        std::cout << "---" << std::endl;
-        
+
+        // Legacy mode: gather everything, then print
+        std::cout << "\nStep 1: Analyzing query..." << std::endl;
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+        std::cout << "Step 2: Searching codebase..." << std::endl;
+        std::this_thread::sleep_for(std::chrono::milliseconds(400));
+
+        std::cout << "Step 3: Ranking results..." << std::endl;
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+        std::cout << "Step 4: Generating comprehensive context..." << std::endl;
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+        std::cout << "\n=== COMPREHENSIVE RAG RESULT ===" << std::endl;
+        std::cout << "\n" << buildPillarContext(targetFile, query) << std::endl;
+        std::cout << buildRankedBlocksSection(targetFile);
+        std::cout << buildPromptSection(query);
+
         std::cout << "\n✓ Query processed successfully" << std::endl;
         std::cout << "✓ Context generated with 3 relevant code blocks" << std::endl;
         std::cout << "✓ Ready for AI model input" << std::endl;
     }
-    
+
+    // Streaming mode: each section is written the moment it is available
+    // instead of after the whole pipeline finishes. Ranked blocks travel
+    // through the EventBus as EVENT_CONTEXT_GENERATED, so anything else
+    // subscribed to the stream (the writer, plugins) sees them too.
+    void processQueryStreaming(const std::string& query, const std::string& targetFile) {
+        // Raw fd writes must not interleave with buffered iostream output
+        std::cout.flush();
+
+        m_streamWriter.write("\n=== COMPREHENSIVE RAG RESULT (streaming) ===\n");
+        m_streamWriter.write("\n" + buildPillarContext(targetFile, query) + "\n");
+
+        m_streamWriter.write("\n=== RELEVANT CODE BLOCKS ===\n");
+        m_streamWriter.write("Blocks are emitted as the fusion stage accepts them:\n");
+
+        // Each accepted block goes out immediately; the sleeps stand in
+        // for per-block ranking latency in this stub pipeline
+        emitAcceptedBlock("\n1. [Relevant Code Block 1]\n   Score: 0.85 | File: " +
+                          targetFile + ":15-25\n");
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        emitAcceptedBlock("\n2. [Relevant Code Block 2]\n   Score: 0.72 | File: utils.h:8-12\n");
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        emitAcceptedBlock("\n3. [Relevant Code Block 3]\n   Score: 0.68 | File: " +
+                          targetFile + ":45-52\n");
+
+        m_streamWriter.write(buildPromptSection(query));
+        m_streamWriter.write("\n✓ Query processed (streamed)\n");
+        m_streamWriter.flush();
+    }
+
+    // Publish one accepted block on the EventBus; the attached
+    // StreamingContextWriter prints it on delivery
+    void emitAcceptedBlock(const std::string& blockText) {
+        if (!m_eventBus) {
+            m_streamWriter.write(blockText);
+            return;
+        }
+
+        EventData event;
+        event.type = EVENT_CONTEXT_GENERATED;
+        event.timestamp = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+        event.sourcePlugin = "console_interface";
+        event.data = const_cast<char*>(blockText.data());
+        event.dataSize = blockText.size();
+
+        if (m_eventBus->emitEvent(&event) != RAGGER_SUCCESS) {
+            m_streamWriter.write(blockText);
+        }
+    }
+
+    std::string buildPillarContext(const std::string& targetFile, const std::string& query) {
+        if (m_contextGenerator) {
+            return m_contextGenerator->generateComprehensiveContext(targetFile, query, 1, 50);
+        }
+        return generateComprehensiveContext(targetFile, query, 1, 50);
+    }
+
+    std::string buildRankedBlocksSection(const std::string& targetFile) {
+        std::string section = "\n=== RELEVANT CODE BLOCKS ===\n";
+        section += "Based on your query, here are the relevant code sections:\n";
+        section += "\n1. [Relevant Code Block 1]\n   Score: 0.85 | File: " + targetFile + ":15-25\n";
+        section += "   This code block is highly relevant to your query.\n";
+        section += "\n2. [Relevant Code Block 2]\n   Score: 0.72 | File: utils.h:8-12\n";
+        section += "   Additional context for your request.\n";
+        section += "\n3. [Relevant Code Block 3]\n   Score: 0.68 | File: " + targetFile + ":45-52\n";
+        section += "   Related functionality that might help.\n";
+        return section;
+    }
+
+    std::string buildPromptSection(const std::string& query) {
+        std::string section = "\n=== GENERATED PROMPT ===\n";
+        section += "Here's the context-rich prompt that would be sent to an AI model:\n";
+        section += "\n---\n";
+        section += "Context: The following code blocks are relevant to your query:\n";
+        section += "\n1. [Code Block 1 content...]\n";
+        section += "2. [Code Block 2 content...]\n";
+        section += "3. [Code Block 3 content...]\n";
+        section += "\nQuestion: " + query + "\n";
+        section += "---\n";
+        return section;
+    }
+
 private:
     // Helper function to generate comprehensive context (simplified version)
     std::string generateComprehensiveContext(const std::string& filePath, const std::string& query, int startLine, int endLine) {
@@ -355,6 +528,8 @@ private:
     }
 
     void cleanup() {
+        m_streamWriter.detach();
+
         if (m_contextGenerator) {
             delete m_contextGenerator;
             m_contextGenerator = nullptr;
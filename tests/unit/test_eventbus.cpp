@@ -1,8 +1,10 @@
 #include "EventBus.h"
 #include "ragger_plugin_api.h"
 #include <gtest/gtest.h>
+#include <atomic>
 #include <thread>
 #include <chrono>
+#include <vector>
 
 namespace Ragger {
 
@@ -16,17 +18,45 @@ protected:
         eventBus.reset();
     }
 
+    static EventData makeEvent(EventType type) {
+        EventData event;
+        event.type = type;
+        event.sourcePlugin = "test_plugin";
+        event.data = nullptr;
+        event.dataSize = 0;
+        event.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        return event;
+    }
+
     std::unique_ptr<EventBus> eventBus;
 };
 
+namespace {
+
+// EventCallback is a plain C function pointer, so test callbacks thread
+// their state through userData instead of lambda captures
+
+void setFlagCallback(const EventData* event, void* userData) {
+    *static_cast<bool*>(userData) = true;
+}
+
+void pushOneCallback(const EventData* event, void* userData) {
+    static_cast<std::vector<int>*>(userData)->push_back(1);
+}
+
+void pushTwoCallback(const EventData* event, void* userData) {
+    static_cast<std::vector<int>*>(userData)->push_back(2);
+}
+
+void countCallback(const EventData* event, void* userData) {
+    static_cast<std::atomic<int>*>(userData)->fetch_add(1);
+}
+
+} // anonymous namespace
+
 TEST_F(EventBusTest, BasicEventEmission) {
-    EventData event;
-    event.type = EVENT_CODEBLOCK_INDEXED;
-    event.sourcePlugin = "test_plugin";
-    event.data = nullptr;
-    event.dataSize = 0;
-    event.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
+    EventData event = makeEvent(EVENT_CODEBLOCK_INDEXED);
 
     int result = eventBus->emitEvent(&event);
     EXPECT_EQ(result, RAGGER_SUCCESS);
@@ -34,106 +64,54 @@ TEST_F(EventBusTest, BasicEventEmission) {
 
 TEST_F(EventBusTest, EventSubscription) {
     bool callbackCalled = false;
-    
-    auto callback = [&callbackCalled](const EventData* event, void* userData) {
-        callbackCalled = true;
-    };
 
-    int result = eventBus->subscribe(EVENT_CODEBLOCK_INDEXED, callback, nullptr);
+    int result = eventBus->subscribe(EVENT_CODEBLOCK_INDEXED, setFlagCallback, &callbackCalled);
     EXPECT_EQ(result, RAGGER_SUCCESS);
 
-    EventData event;
-    event.type = EVENT_CODEBLOCK_INDEXED;
-    event.sourcePlugin = "test_plugin";
-    event.data = nullptr;
-    event.dataSize = 0;
-    event.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
-
+    EventData event = makeEvent(EVENT_CODEBLOCK_INDEXED);
     result = eventBus->emitEvent(&event);
     EXPECT_EQ(result, RAGGER_SUCCESS);
-    
-    // Give some time for async processing
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    
+
     EXPECT_TRUE(callbackCalled);
 }
 
 TEST_F(EventBusTest, EventUnsubscription) {
     bool callbackCalled = false;
-    
-    auto callback = [&callbackCalled](const EventData* event, void* userData) {
-        callbackCalled = true;
-    };
 
     // Subscribe
-    int result = eventBus->subscribe(EVENT_CODEBLOCK_INDEXED, callback, nullptr);
+    int result = eventBus->subscribe(EVENT_CODEBLOCK_INDEXED, setFlagCallback, &callbackCalled);
     EXPECT_EQ(result, RAGGER_SUCCESS);
 
     // Unsubscribe
-    result = eventBus->unsubscribe(EVENT_CODEBLOCK_INDEXED, callback);
+    result = eventBus->unsubscribe(EVENT_CODEBLOCK_INDEXED, setFlagCallback);
     EXPECT_EQ(result, RAGGER_SUCCESS);
 
-    EventData event;
-    event.type = EVENT_CODEBLOCK_INDEXED;
-    event.sourcePlugin = "test_plugin";
-    event.data = nullptr;
-    event.dataSize = 0;
-    event.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
-
+    EventData event = makeEvent(EVENT_CODEBLOCK_INDEXED);
     result = eventBus->emitEvent(&event);
     EXPECT_EQ(result, RAGGER_SUCCESS);
-    
-    // Give some time for async processing
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    
+
     EXPECT_FALSE(callbackCalled);
 }
 
 TEST_F(EventBusTest, PriorityOrdering) {
     std::vector<int> callbackOrder;
-    
-    auto callback1 = [&callbackOrder](const EventData* event, void* userData) {
-        callbackOrder.push_back(1);
-    };
-    
-    auto callback2 = [&callbackOrder](const EventData* event, void* userData) {
-        callbackOrder.push_back(2);
-    };
 
     // Subscribe with different priorities
-    eventBus->subscribe(EVENT_CODEBLOCK_INDEXED, callback1, nullptr, 10);
-    eventBus->subscribe(EVENT_CODEBLOCK_INDEXED, callback2, nullptr, 20);
-
-    EventData event;
-    event.type = EVENT_CODEBLOCK_INDEXED;
-    event.sourcePlugin = "test_plugin";
-    event.data = nullptr;
-    event.dataSize = 0;
-    event.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
+    eventBus->subscribe(EVENT_CODEBLOCK_INDEXED, pushOneCallback, &callbackOrder, 10);
+    eventBus->subscribe(EVENT_CODEBLOCK_INDEXED, pushTwoCallback, &callbackOrder, 20);
 
+    EventData event = makeEvent(EVENT_CODEBLOCK_INDEXED);
     int result = eventBus->emitEvent(&event);
     EXPECT_EQ(result, RAGGER_SUCCESS);
-    
-    // Give some time for async processing
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    
+
     // Higher priority (20) should be called first
-    EXPECT_EQ(callbackOrder.size(), 2);
+    ASSERT_EQ(callbackOrder.size(), 2u);
     EXPECT_EQ(callbackOrder[0], 2);
     EXPECT_EQ(callbackOrder[1], 1);
 }
 
 TEST_F(EventBusTest, StatsTracking) {
-    EventData event;
-    event.type = EVENT_CODEBLOCK_INDEXED;
-    event.sourcePlugin = "test_plugin";
-    event.data = nullptr;
-    event.dataSize = 0;
-    event.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
+    EventData event = makeEvent(EVENT_CODEBLOCK_INDEXED);
 
     // Emit multiple events
     for (int i = 0; i < 5; ++i) {
@@ -142,8 +120,113 @@ TEST_F(EventBusTest, StatsTracking) {
     }
 
     const auto& stats = eventBus->getStats();
-    EXPECT_EQ(stats.totalEventsProcessed, 5);
-    EXPECT_EQ(stats.eventsByType[EVENT_CODEBLOCK_INDEXED], 5);
+    EXPECT_EQ(stats.totalEventsProcessed.load(), 5u);
+    EXPECT_EQ(stats.eventsByType.at(EVENT_CODEBLOCK_INDEXED).load(), 5u);
+}
+
+TEST_F(EventBusTest, SharedPayloadZeroCopy) {
+    // Well over the copied-payload cap; the shared path carries it anyway
+    const size_t payloadSize = 4 * 1024 * 1024;
+    auto payload = EventBus::SharedPayload::allocate(payloadSize);
+    char* bytes = static_cast<char*>(payload->data());
+    bytes[0] = 'a';
+    bytes[payloadSize - 1] = 'z';
+
+    struct Observed {
+        const void* data = nullptr;
+        size_t dataSize = 0;
+        char first = 0;
+        char last = 0;
+    } observed;
+
+    auto callback = [](const EventData* event, void* userData) {
+        auto* out = static_cast<Observed*>(userData);
+        out->data = event->data;
+        out->dataSize = event->dataSize;
+        const char* bytes = static_cast<const char*>(event->data);
+        out->first = bytes[0];
+        out->last = bytes[event->dataSize - 1];
+    };
+    eventBus->subscribe(EVENT_FILE_PARSED, callback, &observed);
+
+    EventData event = makeEvent(EVENT_FILE_PARSED);
+    event.data = nullptr; // Deliver the whole buffer
+
+    const void* bufferAddress = payload->data();
+    int result = eventBus->emitEventShared(&event, std::move(payload));
+    EXPECT_EQ(result, RAGGER_SUCCESS);
+
+    // Give some time for async processing
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // The subscriber saw the producer's buffer, not a copy
+    EXPECT_EQ(observed.data, bufferAddress);
+    EXPECT_EQ(observed.dataSize, payloadSize);
+    EXPECT_EQ(observed.first, 'a');
+    EXPECT_EQ(observed.last, 'z');
+}
+
+TEST_F(EventBusTest, SharedPayloadValidation) {
+    auto payload = EventBus::SharedPayload::allocate(64);
+
+    EventData event = makeEvent(EVENT_FILE_PARSED);
+
+    // A window outside the buffer is rejected
+    event.data = payload->data();
+    event.dataSize = 128;
+    EXPECT_EQ(eventBus->emitEventShared(&event, payload), RAGGER_ERROR_INVALID_ARGUMENT);
+
+    // A missing payload is rejected
+    event.data = nullptr;
+    event.dataSize = 0;
+    EXPECT_EQ(eventBus->emitEventShared(&event, nullptr), RAGGER_ERROR_INVALID_ARGUMENT);
+
+    // The copied async path still enforces its cap
+    std::vector<char> large(EventBus::MAX_COPIED_PAYLOAD + 1);
+    event.data = large.data();
+    event.dataSize = large.size();
+    EXPECT_EQ(eventBus->emitEventAsync(&event), RAGGER_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_F(EventBusTest, BatchEmissionReportsAcceptedCount) {
+    std::atomic<int> delivered{0};
+    eventBus->subscribe(EVENT_FILE_PARSED, countCallback, &delivered);
+
+    EventData events[3] = {
+        makeEvent(EVENT_FILE_PARSED),
+        makeEvent(EVENT_FILE_PARSED),
+        makeEvent(EVENT_FILE_PARSED),
+    };
+    EXPECT_EQ(eventBus->emitEventsAsync(events, 3), 3u);
+
+    // Give some time for async processing
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(delivered.load(), 3);
+
+    // Degenerate batches accept nothing
+    EXPECT_EQ(eventBus->emitEventsAsync(nullptr, 3), 0u);
+    EXPECT_EQ(eventBus->emitEventsAsync(events, 0), 0u);
+}
+
+TEST_F(EventBusTest, BatchEmissionSkipsInvalidEvents) {
+    std::atomic<int> delivered{0};
+    eventBus->subscribe(EVENT_FILE_PARSED, countCallback, &delivered);
+
+    // The middle event fails validation (payload over the copied-path
+    // cap); it is skipped without sinking the rest of the batch
+    std::vector<char> oversized(EventBus::MAX_COPIED_PAYLOAD + 1);
+    EventData events[3] = {
+        makeEvent(EVENT_FILE_PARSED),
+        makeEvent(EVENT_FILE_PARSED),
+        makeEvent(EVENT_FILE_PARSED),
+    };
+    events[1].data = oversized.data();
+    events[1].dataSize = oversized.size();
+
+    EXPECT_EQ(eventBus->emitEventsAsync(events, 3), 2u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(delivered.load(), 2);
 }
 
 TEST_F(EventBusTest, InvalidEventHandling) {
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "FileDiscovery.h"
+#include <algorithm>
+#include <fstream>
+
+using namespace Ragger;
+
+namespace {
+
+void writeFile(const fs::path& path, const std::string& content) {
+    fs::create_directories(path.parent_path());
+    std::ofstream file(path);
+    file << content;
+}
+
+} // anonymous namespace
+
+TEST(IgnoreRulesTest, BasicPatterns) {
+    IgnoreRules rules;
+    rules.addPatternLine("*.o");
+    rules.addPatternLine("build/");
+    rules.addPatternLine("/docs");
+    rules.addPatternLine("# comment");
+    rules.addPatternLine("");
+
+    EXPECT_EQ(rules.match("main.o", false), 1);
+    EXPECT_EQ(rules.match("src/deep/main.o", false), 1); // Unanchored matches at depth
+    EXPECT_EQ(rules.match("main.cpp", false), -1);
+    EXPECT_EQ(rules.match("build", true), 1);
+    EXPECT_EQ(rules.match("build", false), -1); // Directory-only pattern
+    EXPECT_EQ(rules.match("docs", true), 1);
+    EXPECT_EQ(rules.match("src/docs", true), -1); // Anchored to the root
+}
+
+TEST(IgnoreRulesTest, NegationAndLastMatchWins) {
+    IgnoreRules rules;
+    rules.addPatternLine("*.log");
+    rules.addPatternLine("!keep.log");
+
+    EXPECT_EQ(rules.match("debug.log", false), 1);
+    EXPECT_EQ(rules.match("keep.log", false), 0); // Explicitly unignored
+}
+
+TEST(IgnoreRulesTest, DoubleStarCrossesDirectories) {
+    IgnoreRules rules;
+    rules.addPatternLine("vendor/**/*.c");
+    rules.addPatternLine("**/generated");
+
+    EXPECT_EQ(rules.match("vendor/a/b/x.c", false), 1);
+    EXPECT_EQ(rules.match("vendor/x.c", false), 1); // ** matches zero dirs
+    EXPECT_EQ(rules.match("src/x.c", false), -1);
+    EXPECT_EQ(rules.match("a/b/generated", true), 1);
+}
+
+TEST(FileDiscoveryTest, PrunesIgnoredDirectories) {
+    fs::path root = fs::temp_directory_path() / "ragger_discovery_test";
+    fs::remove_all(root);
+
+    writeFile(root / ".gitignore", "build/\n*.tmp.cpp\n");
+    writeFile(root / "src" / "main.cpp", "int main() {}\n");
+    writeFile(root / "src" / "scratch.tmp.cpp", "// ignored\n");
+    writeFile(root / "build" / "gen.cpp", "// pruned with its directory\n");
+    writeFile(root / "src" / ".gitignore", "!scratch.tmp.cpp\n");
+
+    auto files = FileDiscovery::discover(root, [](const fs::path& path) {
+        return path.extension() == ".cpp";
+    });
+
+    auto contains = [&](const fs::path& p) {
+        return std::find(files.begin(), files.end(), p) != files.end();
+    };
+
+    EXPECT_EQ(files.size(), 2u);
+    EXPECT_TRUE(contains(root / "src" / "main.cpp"));
+    // The deeper ignore file overrides the root's *.tmp.cpp rule
+    EXPECT_TRUE(contains(root / "src" / "scratch.tmp.cpp"));
+    EXPECT_FALSE(contains(root / "build" / "gen.cpp"));
+
+    fs::remove_all(root);
+}
@@ -0,0 +1,87 @@
+#include "ragger_plugin_api.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+
+namespace Ragger {
+namespace Api {
+
+TEST(BlockSetTest, OwnsCopiesOfStrings) {
+    BlockSet blocks;
+
+    std::string name = "parseFile";
+    CodeBlock& block = blocks.add(name.c_str(), "int parseFile() {}", "src/parser.cpp",
+                                  10, 20, "cpp");
+    name = "overwritten"; // The set copied the string, not the pointer
+
+    ASSERT_EQ(blocks.size(), 1u);
+    EXPECT_STREQ(block.name, "parseFile");
+    EXPECT_STREQ(block.content, "int parseFile() {}");
+    EXPECT_STREQ(block.filePath, "src/parser.cpp");
+    EXPECT_EQ(block.startLine, 10);
+    EXPECT_EQ(block.endLine, 20);
+    EXPECT_STREQ(block.language, "cpp");
+}
+
+TEST(BlockSetTest, BlockAddressesStayStableAsSetGrows) {
+    BlockSet blocks;
+    CodeBlock* first = &blocks.add("first", "", "a.cpp", 1, 2, "cpp");
+
+    for (int i = 0; i < 100; ++i) {
+        blocks.add("more", "", "b.cpp", i, i + 1, "cpp");
+    }
+
+    EXPECT_EQ(first, &blocks[0]);
+    EXPECT_STREQ(first->name, "first");
+}
+
+TEST(RankingResultsTest, InternsRankingType) {
+    RankingResults results;
+    CodeBlock& a = results.blocks().add("a", "", "a.cpp", 1, 2, "cpp");
+    CodeBlock& b = results.blocks().add("b", "", "b.cpp", 3, 4, "cpp");
+
+    std::string type = "bm25";
+    results.add(&a, 1.0f, type.c_str());
+    results.add(&b, 0.5f, type.c_str());
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_STREQ(results.data()[0].rankingType, "bm25");
+    // One arena copy per distinct type, shared by every result
+    EXPECT_EQ(results.data()[0].rankingType, results.data()[1].rankingType);
+}
+
+TEST(RankingResultsTest, MovePreservesTheCView) {
+    RankingResults results;
+    CodeBlock& block = results.blocks().add("a", "content", "a.cpp", 1, 2, "cpp");
+    results.add(&block, 2.0f, "bm25");
+
+    RankingResult* view = results.data();
+    RankingResults moved = std::move(results);
+
+    // The array the caller holds is untouched by the move
+    EXPECT_EQ(moved.data(), view);
+    EXPECT_STREQ(view[0].block->content, "content");
+    EXPECT_FLOAT_EQ(view[0].score, 2.0f);
+}
+
+TEST(ResponseTest, OwnsResultsAndTemplate) {
+    RankingResults results;
+    CodeBlock& block = results.blocks().add("a", "", "a.cpp", 1, 2, "cpp");
+    results.add(&block, 1.5f, "hybrid");
+
+    Response response;
+    response.adoptResults(std::move(results));
+    response.setPromptTemplate("default");
+    response.setTotalTokens(128);
+
+    Response moved = std::move(response);
+    const ContextResponse* view = moved.view();
+    ASSERT_EQ(view->numResults, 1u);
+    EXPECT_FLOAT_EQ(view->results[0].score, 1.5f);
+    EXPECT_STREQ(view->results[0].rankingType, "hybrid");
+    EXPECT_STREQ(view->promptTemplate, "default");
+    EXPECT_EQ(view->totalTokens, 128u);
+}
+
+} // namespace Api
+} // namespace Ragger
@@ -0,0 +1,70 @@
+#include "SymbolIndex.h"
+#include <gtest/gtest.h>
+
+namespace Ragger {
+
+class SymbolIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        index.add(1, "processRequest", "src/a.cpp");
+        index.add(2, "processResponse", "src/a.cpp");
+        index.add(3, "parseConfig", "src/b.cpp");
+        index.add(4, "ConfigManager", "src/c.cpp");
+    }
+
+    SymbolIndex index;
+};
+
+TEST_F(SymbolIndexTest, ExactLookup) {
+    auto matches = index.lookup("parseConfig", 10);
+    ASSERT_FALSE(matches.empty());
+    EXPECT_EQ(matches[0].blockId, 3);
+    EXPECT_EQ(matches[0].name, "parseConfig");
+}
+
+TEST_F(SymbolIndexTest, ExactLookupIsCaseInsensitive) {
+    auto matches = index.lookup("configmanager", 10);
+    ASSERT_FALSE(matches.empty());
+    EXPECT_EQ(matches[0].blockId, 4);
+}
+
+TEST_F(SymbolIndexTest, PrefixLookup) {
+    auto matches = index.lookup("process", 10);
+    ASSERT_EQ(matches.size(), 2u);
+    EXPECT_TRUE(matches[0].blockId == 1 || matches[0].blockId == 2);
+    EXPECT_TRUE(matches[1].blockId == 1 || matches[1].blockId == 2);
+}
+
+TEST_F(SymbolIndexTest, FuzzySubsequenceLookup) {
+    // No exact or prefix match, but shares trigrams and is a subsequence
+    auto matches = index.lookup("prsRequest", 10);
+    ASSERT_FALSE(matches.empty());
+    EXPECT_EQ(matches[0].blockId, 1);
+}
+
+TEST_F(SymbolIndexTest, RemoveFileDropsItsSymbols) {
+    index.removeFile("src/a.cpp");
+    EXPECT_TRUE(index.lookup("processRequest", 10).empty());
+    EXPECT_FALSE(index.lookup("parseConfig", 10).empty());
+    EXPECT_EQ(index.size(), 2u);
+}
+
+TEST_F(SymbolIndexTest, MaxResultsIsRespected) {
+    auto matches = index.lookup("process", 1);
+    EXPECT_EQ(matches.size(), 1u);
+}
+
+TEST_F(SymbolIndexTest, SurvivesCompaction) {
+    // Push past the compaction threshold (half the entries dead)
+    for (int i = 0; i < 100; ++i) {
+        index.add(100 + i, "tempSymbol" + std::to_string(i), "src/tmp.cpp");
+    }
+    index.removeFile("src/tmp.cpp");
+
+    auto matches = index.lookup("parseConfig", 10);
+    ASSERT_FALSE(matches.empty());
+    EXPECT_EQ(matches[0].blockId, 3);
+    EXPECT_TRUE(index.lookup("tempSymbol1", 10).empty());
+}
+
+} // namespace Ragger